@@ -19,11 +19,33 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#  define HAVE_POSIX_MMAP 1
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#else
+#  define HAVE_POSIX_MMAP 0
+#endif
 
 
 struct Expression {};
@@ -37,6 +59,386 @@ constexpr bool is_expression_v = is_expression<T>::value;
 
 
 
+// Cache for a lazily computed value that is not transferred on copy or move. This resembles the
+// 'non_propagating_cache' of range-v3: a cached iterator may refer into the source object, and
+// therefore must not survive copying the expression that owns it.
+template< typename T >
+class NonPropagatingCache
+{
+ public:
+   NonPropagatingCache() = default;
+
+   NonPropagatingCache( const NonPropagatingCache& ) noexcept
+   {}
+
+   NonPropagatingCache& operator=( const NonPropagatingCache& ) noexcept
+   {
+      value_.reset();
+      return *this;
+   }
+
+   explicit operator bool() const noexcept { return value_.has_value(); }
+
+   const T& operator*() const noexcept { return *value_; }
+
+   template< typename... Args >
+   const T& emplace( Args&&... args )
+   {
+      return value_.emplace( std::forward<Args>( args )... );
+   }
+
+ private:
+   std::optional<T> value_;
+};
+
+
+
+
+template< typename Iterator >
+using iterator_traits_t = std::conditional_t< std::is_pointer_v<Iterator>
+                                            , std::iterator_traits<Iterator>, Iterator >;
+
+template< typename Iterator >
+using iterator_category_t = typename iterator_traits_t<Iterator>::iterator_category;
+
+template< typename Iterator >
+constexpr bool is_random_access_v =
+   std::is_base_of_v< std::random_access_iterator_tag, iterator_category_t<Iterator> >;
+
+template< typename T, typename = void >
+struct is_contiguous
+   : public std::false_type
+{};
+
+template< typename T >
+struct is_contiguous< T, std::void_t< decltype( std::declval<const T&>().data() ) > >
+   : public std::bool_constant< std::is_pointer_v< decltype( std::declval<const T&>().data() ) > >
+{};
+
+template< typename T >
+constexpr bool is_contiguous_v = is_contiguous<T>::value;
+
+
+// Advances the given iterator by at most 'n' steps without passing 'end'. Returns the number of
+// steps that could not be taken.
+template< typename Iterator >
+std::ptrdiff_t advanceBounded( Iterator& pos, std::ptrdiff_t n, const Iterator& end )
+{
+   if constexpr( is_random_access_v<Iterator> ) {
+      const std::ptrdiff_t steps( std::min<std::ptrdiff_t>( n, end - pos ) );
+      pos += steps;
+      return n - steps;
+   }
+   else {
+      for( ; n > 0 && pos != end; --n ) {
+         ++pos;
+      }
+      return n;
+   }
+}
+
+
+// CRTP base class providing the complete set of iterator operators in terms of the dereference
+// ('*'), advance ('+='), distance ('-') and equality ('==') operations of the derived iterator.
+// Operators the underlying iterator cannot support (e.g. '--' for a forward iterator) are simply
+// never instantiated.
+template< typename Derived >
+class IteratorOperators
+{
+ public:
+   decltype(auto) operator[]( std::ptrdiff_t n ) const {
+      return *( derived() + n );
+   }
+
+   friend Derived& operator++( Derived& it ) {
+      return it += 1;
+   }
+
+   friend const Derived operator++( Derived& it, int ) {
+      const Derived tmp( it );
+      it += 1;
+      return tmp;
+   }
+
+   friend Derived& operator--( Derived& it ) {
+      return it += -1;
+   }
+
+   friend const Derived operator--( Derived& it, int ) {
+      const Derived tmp( it );
+      it += -1;
+      return tmp;
+   }
+
+   friend Derived& operator-=( Derived& it, std::ptrdiff_t n ) { return it += -n; }
+
+   friend Derived operator+( Derived it, std::ptrdiff_t n ) { return it += n; }
+   friend Derived operator+( std::ptrdiff_t n, Derived it ) { return it += n; }
+   friend Derived operator-( Derived it, std::ptrdiff_t n ) { return it += -n; }
+
+   friend bool operator!=( const Derived& lhs, const Derived& rhs ) { return !( lhs == rhs ); }
+   friend bool operator< ( const Derived& lhs, const Derived& rhs ) { return ( lhs - rhs ) <  0; }
+   friend bool operator> ( const Derived& lhs, const Derived& rhs ) { return ( lhs - rhs ) >  0; }
+   friend bool operator<=( const Derived& lhs, const Derived& rhs ) { return ( lhs - rhs ) <= 0; }
+   friend bool operator>=( const Derived& lhs, const Derived& rhs ) { return ( lhs - rhs ) >= 0; }
+
+ private:
+   const Derived& derived() const { return static_cast<const Derived&>( *this ); }
+};
+
+
+// Non-owning view on the elements in the range [first,last). In case the range is contiguous
+// (i.e. the iterators are pointers), the elements are also directly accessible via 'data()'.
+template< typename Iterator >
+class Subrange
+   : public Expression
+{
+ public:
+   using value_type     = typename iterator_traits_t<Iterator>::value_type;
+   using const_iterator = Iterator;
+   using iterator       = Iterator;
+
+   Subrange() = default;
+
+   Subrange( Iterator first, Iterator last )
+      : first_( first )
+      , last_ ( last  )
+   {}
+
+   const_iterator begin() const { return first_; }
+   const_iterator end()   const { return last_;  }
+
+   size_t size() const { return static_cast<size_t>( std::distance( first_, last_ ) ); }
+   bool  empty() const { return first_ == last_; }
+
+   decltype(auto) operator[]( size_t index ) const { return first_[index]; }
+
+   Iterator data() const
+   {
+      static_assert( std::is_pointer_v<Iterator>, "Subrange is not contiguous" );
+      return first_;
+   }
+
+ private:
+   Iterator first_{};
+   Iterator last_ {};
+};
+
+
+
+
+#if HAVE_POSIX_MMAP
+// Source range for a binary file of fixed-width records of type 'T'. The file is memory mapped,
+// so records are only read from disk when they are accessed: a pipeline that ends in a 'take()'
+// stops reading as soon as the requested number of elements is produced. The kernel is advised
+// to read ahead sequentially. Trailing bytes that do not form a complete record are ignored.
+template< typename T >
+class MappedRecords
+{
+   static_assert( std::is_trivially_copyable_v<T>, "Records must be trivially copyable" );
+
+ public:
+   using value_type     = T;
+   using const_iterator = const T*;
+   using iterator       = const T*;
+
+   explicit MappedRecords( const std::string& path )
+   {
+      const int fd( ::open( path.c_str(), O_RDONLY ) );
+      if( fd == -1 )
+         throw std::runtime_error( "Unable to open file '" + path + "'" );
+
+      struct stat info{};
+      if( ::fstat( fd, &info ) == -1 ) {
+         ::close( fd );
+         throw std::runtime_error( "Unable to query size of file '" + path + "'" );
+      }
+
+      bytes_ = static_cast<size_t>( info.st_size );
+
+      if( bytes_ > 0UL ) {
+         address_ = ::mmap( nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0 );
+         if( address_ == MAP_FAILED ) {
+            ::close( fd );
+            throw std::runtime_error( "Unable to map file '" + path + "'" );
+         }
+         ::madvise( address_, bytes_, MADV_SEQUENTIAL );
+      }
+
+      ::close( fd );
+   }
+
+   MappedRecords( const MappedRecords& ) = delete;
+   MappedRecords& operator=( const MappedRecords& ) = delete;
+
+   ~MappedRecords()
+   {
+      if( bytes_ > 0UL )
+         ::munmap( address_, bytes_ );
+   }
+
+   const_iterator begin() const { return data(); }
+   const_iterator end()   const { return data() + size(); }
+
+   const T* data() const { return static_cast<const T*>( address_ ); }
+   size_t   size() const { return bytes_ / sizeof(T); }
+
+ private:
+   void*  address_{ nullptr };
+   size_t bytes_{};
+};
+#endif
+
+
+// Single-pass source range for a text file of numbers, separated by whitespace or commas. The
+// file is read in large blocks and the numbers are parsed by 'std::from_chars()', i.e. without
+// any locale overhead. Blocks are only read on demand, so a pipeline that ends in a 'take()'
+// stops reading as soon as the requested number of elements is produced.
+template< typename T >
+class NumberStream
+{
+   static_assert( std::is_arithmetic_v<T>, "Only numbers can be parsed" );
+
+ private:
+   class ConstIterator
+   {
+    private:
+      const NumberStream* stream_{};  // nullptr in case the end of the stream has been reached
+
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const T*;
+      using reference         = const T&;
+
+      ConstIterator() = default;
+
+      explicit ConstIterator( const NumberStream* stream )
+         : stream_( stream )
+      {}
+
+      ConstIterator& operator++() {
+         if( !stream_->next() ) stream_ = nullptr;
+         return *this;
+      }
+
+      void operator++( int ) {
+         ++(*this);
+      }
+
+      const T& operator*() const {
+         return stream_->value_;
+      }
+
+      bool operator==( const ConstIterator& rhs ) const noexcept {
+         return stream_ == rhs.stream_;
+      }
+
+      bool operator!=( const ConstIterator& rhs ) const noexcept {
+         return !( *this == rhs );
+      }
+   };
+
+ public:
+   using value_type     = T;
+   using const_iterator = ConstIterator;
+   using iterator       = ConstIterator;
+
+   explicit NumberStream( const std::string& path, size_t blockSize = 1UL << 20 )
+      : file_  ( std::fopen( path.c_str(), "rb" ) )
+      , buffer_( std::max<size_t>( blockSize, 64UL ) )
+   {
+      if( file_ == nullptr )
+         throw std::runtime_error( "Unable to open file '" + path + "'" );
+
+      std::setvbuf( file_, nullptr, _IONBF, 0 );
+#if defined(POSIX_FADV_SEQUENTIAL)
+      ::posix_fadvise( ::fileno( file_ ), 0, 0, POSIX_FADV_SEQUENTIAL );
+#endif
+   }
+
+   NumberStream( const NumberStream& ) = delete;
+   NumberStream& operator=( const NumberStream& ) = delete;
+
+   ~NumberStream()
+   {
+      std::fclose( file_ );
+   }
+
+   // Note that the stream can only be traversed once: 'begin()' continues at the current
+   // position of the stream.
+   const_iterator begin() const
+   {
+      if( !started_ ) {
+         started_ = true;
+         done_ = !next();
+      }
+      return ConstIterator( done_ ? nullptr : this );
+   }
+
+   const_iterator end() const
+   {
+      return ConstIterator();
+   }
+
+ private:
+   static bool isSeparator( char c ) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',';
+   }
+
+   // Parses the next number. Returns false in case the end of the file has been reached.
+   bool next() const
+   {
+      for( ;; ) {
+         while( pos_ != end_ && isSeparator( buffer_[pos_] ) ) ++pos_;
+         if( pos_ != end_ ) break;
+         if( !refill() ) return !( done_ = true );
+      }
+
+      size_t length( 0UL );
+      for( ;; ) {
+         while( pos_+length != end_ && !isSeparator( buffer_[pos_+length] ) ) ++length;
+         if( pos_+length != end_ || !refill() ) break;
+      }
+
+      const char* const first( buffer_.data() + pos_ );
+      const auto [last, error] = std::from_chars( first, first+length, value_ );
+      if( error != std::errc{} || last != first+length )
+         throw std::runtime_error( "Invalid number '" + std::string( first, length ) + "'" );
+
+      pos_ += length;
+      return true;
+   }
+
+   // Moves the unprocessed characters to the front of the buffer and fills the remainder of the
+   // buffer with the next block of the file. Returns false in case no more data is available.
+   bool refill() const
+   {
+      std::copy( buffer_.begin()+pos_, buffer_.begin()+end_, buffer_.begin() );
+      end_ -= pos_;
+      pos_ = 0UL;
+
+      if( end_ == buffer_.size() )
+         buffer_.resize( 2UL*buffer_.size() );
+
+      const size_t count( std::fread( buffer_.data()+end_, 1UL, buffer_.size()-end_, file_ ) );
+      end_ += count;
+      return count > 0UL;
+   }
+
+   std::FILE* file_;
+   mutable std::vector<char> buffer_;
+   mutable size_t pos_{};
+   mutable size_t end_{};
+   mutable T value_{};
+   mutable bool started_{};
+   mutable bool done_{};
+};
+
+
+
+
 template< typename Range, typename OP >
 class FilterExpr
    : public Expression
@@ -53,6 +455,8 @@ class FilterExpr
       using iterator_category = std::forward_iterator_tag;
       using value_type        = typename Range::value_type;
       using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = decltype( *std::declval<typename Range::const_iterator>() );
 
       ConstIterator() = default;
 
@@ -68,7 +472,7 @@ class FilterExpr
 
       ConstIterator& operator++() {
          ++pos_;
-         for( ; pos_<end_; ++pos_ ) {
+         for( ; pos_!=end_; ++pos_ ) {
             if( op_( *pos_ ) ) break;
          }
          return *this;
@@ -103,9 +507,13 @@ class FilterExpr
       , op_   ( op    )
    {}
 
+   // The search for the first matching element is performed once and cached. Note that due to
+   // the cache, concurrent calls to 'begin()' on the same expression are not thread-safe.
    const_iterator begin() const
    {
-      return ConstIterator( range_.begin(), range_.end(), op_ );
+      if( !begin_ )
+         begin_.emplace( range_.begin(), range_.end(), op_ );
+      return *begin_;
    }
 
    const_iterator end() const
@@ -118,6 +526,7 @@ class FilterExpr
 
    Range_ range_;
    OP     op_;
+   mutable NonPropagatingCache<ConstIterator> begin_;
 };
 
 template< typename OP >
@@ -162,6 +571,9 @@ class TransformExpr
       using iterator_category = std::forward_iterator_tag;
       using value_type        = typename Range::value_type;
       using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = decltype( std::declval<const OP&>()(
+                                     *std::declval<typename Range::const_iterator>() ) );
 
       ConstIterator() = default;
 
@@ -258,22 +670,28 @@ class TakeExpr
     private:
       typename Range::const_iterator pos_{};
       size_t number_{};
+      size_t limit_{};
 
     public:
       using iterator_category = std::forward_iterator_tag;
       using value_type        = typename Range::value_type;
       using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = decltype( *std::declval<typename Range::const_iterator>() );
 
       ConstIterator() = default;
 
-      ConstIterator( typename Range::const_iterator pos, size_t number )
+      ConstIterator( typename Range::const_iterator pos, size_t number, size_t limit )
          : pos_   ( pos    )
          , number_( number )
+         , limit_ ( limit  )
       {}
 
+      // The underlying iterator is not advanced past the last taken element, which avoids
+      // searching (or reading) any further elements once the limit is reached.
       ConstIterator& operator++() {
-         ++pos_;
-         ++number_;
+         if( ++number_ != limit_ )
+            ++pos_;
          return *this;
       }
 
@@ -308,12 +726,12 @@ class TakeExpr
 
    const_iterator begin() const
    {
-      return ConstIterator( range_.begin(), 0UL );
+      return ConstIterator( range_.begin(), 0UL, number_ );
    }
 
    const_iterator end() const
    {
-      return ConstIterator( range_.end(), number_ );
+      return ConstIterator( range_.end(), number_, number_ );
    }
 
  private:
@@ -348,19 +766,877 @@ TakeExpr<Range> operator|( const Range& range, TakeOperation op )
 
 
 
-int main()
+template< typename Range >
+class StrideExpr
+   : public Expression
 {
-   std::vector<int> numbers{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+ private:
+   using Iterator = typename Range::const_iterator;
 
-   auto scaledEvenNumbers =   numbers
-                            | filter( [](int n){ return n % 2 == 0; } )
-                            | transform( [](int n) { return n * 2; } )
-                            | take( 4UL );
+   class ConstIterator
+      : public IteratorOperators<ConstIterator>
+   {
+    private:
+      Iterator pos_{};
+      Iterator end_{};
+      std::ptrdiff_t stride_{};
+      std::ptrdiff_t missing_{};  // Number of steps the last advance fell short due to 'end_'
 
-   std::cout << "\n (";
-   for( int i : scaledEvenNumbers )
-      std::cout << " " << i;
-   std::cout << " )\n\n";
+    public:
+      using iterator_category = iterator_category_t<Iterator>;
+      using value_type        = typename Range::value_type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = decltype( *std::declval<Iterator>() );
+
+      ConstIterator() = default;
+
+      ConstIterator( Iterator pos, Iterator end, std::ptrdiff_t stride, std::ptrdiff_t missing )
+         : pos_    ( pos     )
+         , end_    ( end     )
+         , stride_ ( stride  )
+         , missing_( missing )
+      {}
+
+      decltype(auto) operator*() const {
+         return *pos_;
+      }
+
+      ConstIterator& operator+=( std::ptrdiff_t n ) {
+         if( n > 0 ) {
+            missing_ = advanceBounded( pos_, n*stride_, end_ );
+         }
+         else if( n < 0 ) {
+            std::advance( pos_, n*stride_ + missing_ );
+            missing_ = 0;
+         }
+         return *this;
+      }
+
+      std::ptrdiff_t operator-( const ConstIterator& rhs ) const {
+         return ( ( pos_ - rhs.pos_ ) + ( missing_ - rhs.missing_ ) ) / stride_;
+      }
+
+      bool operator==( const ConstIterator& rhs ) const noexcept {
+         return pos_ == rhs.pos_;
+      }
+   };
+
+ public:
+   using value_type     = typename Range::value_type;
+   using const_iterator = ConstIterator;
+   using iterator       = ConstIterator;
+
+   StrideExpr( const Range& range, size_t stride )
+      : range_ ( range  )
+      , stride_( stride )
+   {
+      assert( stride_ > 0UL );
+   }
+
+   const_iterator begin() const
+   {
+      return ConstIterator( range_.begin(), range_.end(), stride_, 0 );
+   }
+
+   const_iterator end() const
+   {
+      std::ptrdiff_t missing( 0 );
+      if constexpr( is_random_access_v<Iterator> ) {
+         const std::ptrdiff_t stride( stride_ );
+         missing = ( stride - ( range_.end() - range_.begin() ) % stride ) % stride;
+      }
+      return ConstIterator( range_.end(), range_.end(), stride_, missing );
+   }
+
+ private:
+   using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+   Range_ range_;
+   size_t stride_;
+};
+
+struct StrideOperation
+{
+   size_t stride_;
+};
+
+StrideOperation stride( size_t stride )
+{
+   return StrideOperation{ stride };
+}
+
+template< typename Range >
+StrideExpr<Range> stride( const Range& range, size_t stride )
+{
+   return StrideExpr<Range>( range, stride );
+}
+
+template< typename Range >
+StrideExpr<Range> operator|( const Range& range, StrideOperation op )
+{
+   return StrideExpr<Range>( range, op.stride_ );
+}
+
+
+
+
+// The elements of a 'ChunkExpr' are 'Subrange's of at most the given size. For contiguous ranges
+// (e.g. 'std::vector' or 'std::array') the chunks are based on pointers, i.e. each chunk is
+// itself a contiguous view on the underlying elements.
+template< typename Range >
+class ChunkExpr
+   : public Expression
+{
+ private:
+   using Iterator = std::conditional_t< is_contiguous_v<Range>
+                                      , const typename Range::value_type*
+                                      , typename Range::const_iterator >;
+
+   class ConstIterator
+      : public IteratorOperators<ConstIterator>
+   {
+    private:
+      Iterator pos_{};
+      Iterator end_{};
+      std::ptrdiff_t size_{};
+      std::ptrdiff_t missing_{};  // Number of steps the last advance fell short due to 'end_'
+
+    public:
+      using iterator_category = iterator_category_t<Iterator>;
+      using value_type        = Subrange<Iterator>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = Subrange<Iterator>;
+
+      ConstIterator() = default;
+
+      ConstIterator( Iterator pos, Iterator end, std::ptrdiff_t size, std::ptrdiff_t missing )
+         : pos_    ( pos     )
+         , end_    ( end     )
+         , size_   ( size    )
+         , missing_( missing )
+      {}
+
+      Subrange<Iterator> operator*() const {
+         Iterator last( pos_ );
+         advanceBounded( last, size_, end_ );
+         return Subrange<Iterator>( pos_, last );
+      }
+
+      ConstIterator& operator+=( std::ptrdiff_t n ) {
+         if( n > 0 ) {
+            missing_ = advanceBounded( pos_, n*size_, end_ );
+         }
+         else if( n < 0 ) {
+            std::advance( pos_, n*size_ + missing_ );
+            missing_ = 0;
+         }
+         return *this;
+      }
+
+      std::ptrdiff_t operator-( const ConstIterator& rhs ) const {
+         return ( ( pos_ - rhs.pos_ ) + ( missing_ - rhs.missing_ ) ) / size_;
+      }
+
+      bool operator==( const ConstIterator& rhs ) const noexcept {
+         return pos_ == rhs.pos_;
+      }
+   };
+
+ public:
+   using value_type     = Subrange<Iterator>;
+   using const_iterator = ConstIterator;
+   using iterator       = ConstIterator;
+
+   ChunkExpr( const Range& range, size_t size )
+      : range_( range )
+      , size_ ( size  )
+   {
+      assert( size_ > 0UL );
+   }
+
+   const_iterator begin() const
+   {
+      return ConstIterator( first(), last(), size_, 0 );
+   }
+
+   const_iterator end() const
+   {
+      std::ptrdiff_t missing( 0 );
+      if constexpr( is_random_access_v<Iterator> ) {
+         const std::ptrdiff_t size( size_ );
+         missing = ( size - ( last() - first() ) % size ) % size;
+      }
+      return ConstIterator( last(), last(), size_, missing );
+   }
+
+ private:
+   Iterator first() const
+   {
+      if constexpr( is_contiguous_v<Range> )
+         return range_.data();
+      else
+         return range_.begin();
+   }
+
+   Iterator last() const
+   {
+      if constexpr( is_contiguous_v<Range> )
+         return range_.data() + range_.size();
+      else
+         return range_.end();
+   }
+
+   using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+   Range_ range_;
+   size_t size_;
+};
+
+struct ChunkOperation
+{
+   size_t size_;
+};
+
+ChunkOperation chunk( size_t size )
+{
+   return ChunkOperation{ size };
+}
+
+template< typename Range >
+ChunkExpr<Range> chunk( const Range& range, size_t size )
+{
+   return ChunkExpr<Range>( range, size );
+}
+
+template< typename Range >
+ChunkExpr<Range> operator|( const Range& range, ChunkOperation op )
+{
+   return ChunkExpr<Range>( range, op.size_ );
+}
+
+
+
+
+// The elements of a 'ZipExpr' are pairs of references to the corresponding elements of both
+// ranges. The resulting range is as long as the shorter of the two ranges.
+template< typename Range1, typename Range2 >
+class ZipExpr
+   : public Expression
+{
+ private:
+   using Iterator1 = typename Range1::const_iterator;
+   using Iterator2 = typename Range2::const_iterator;
+
+   class ConstIterator
+      : public IteratorOperators<ConstIterator>
+   {
+    private:
+      Iterator1 pos1_{};
+      Iterator2 pos2_{};
+
+    public:
+      using iterator_category = std::common_type_t< iterator_category_t<Iterator1>
+                                                  , iterator_category_t<Iterator2> >;
+      using value_type        = std::pair< typename Range1::value_type, typename Range2::value_type >;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = std::pair< decltype( *std::declval<Iterator1>() )
+                                         , decltype( *std::declval<Iterator2>() ) >;
+
+      ConstIterator() = default;
+
+      ConstIterator( Iterator1 pos1, Iterator2 pos2 )
+         : pos1_( pos1 )
+         , pos2_( pos2 )
+      {}
+
+      reference operator*() const {
+         return reference( *pos1_, *pos2_ );
+      }
+
+      ConstIterator& operator+=( std::ptrdiff_t n ) {
+         std::advance( pos1_, n );
+         std::advance( pos2_, n );
+         return *this;
+      }
+
+      std::ptrdiff_t operator-( const ConstIterator& rhs ) const {
+         return pos1_ - rhs.pos1_;
+      }
+
+      bool operator==( const ConstIterator& rhs ) const noexcept {
+         return pos1_ == rhs.pos1_ || pos2_ == rhs.pos2_;
+      }
+   };
+
+ public:
+   using value_type     = typename ConstIterator::value_type;
+   using const_iterator = ConstIterator;
+   using iterator       = ConstIterator;
+
+   ZipExpr( const Range1& range1, const Range2& range2 )
+      : range1_( range1 )
+      , range2_( range2 )
+   {}
+
+   const_iterator begin() const
+   {
+      return ConstIterator( range1_.begin(), range2_.begin() );
+   }
+
+   const_iterator end() const
+   {
+      if constexpr( is_random_access_v<Iterator1> && is_random_access_v<Iterator2> ) {
+         const auto size( std::min( range1_.end() - range1_.begin(), range2_.end() - range2_.begin() ) );
+         return ConstIterator( range1_.begin() + size, range2_.begin() + size );
+      }
+      else {
+         return ConstIterator( range1_.end(), range2_.end() );
+      }
+   }
+
+ private:
+   using Range1_ = std::conditional_t< is_expression_v<Range1>, const Range1, const Range1& >;
+   using Range2_ = std::conditional_t< is_expression_v<Range2>, const Range2, const Range2& >;
+
+   Range1_ range1_;
+   Range2_ range2_;
+};
+
+template< typename Range >
+struct ZipOperation
+{
+   std::conditional_t< is_expression_v<Range>, const Range, const Range& > range_;
+};
+
+template< typename Range >
+ZipOperation<Range> zip( const Range& range )
+{
+   return ZipOperation<Range>{ range };
+}
+
+template< typename Range1, typename Range2 >
+ZipExpr<Range1,Range2> zip( const Range1& range1, const Range2& range2 )
+{
+   return ZipExpr<Range1,Range2>( range1, range2 );
+}
+
+template< typename Range1, typename Range2 >
+ZipExpr<Range1,Range2> operator|( const Range1& range1, const ZipOperation<Range2>& op )
+{
+   return ZipExpr<Range1,Range2>( range1, op.range_ );
+}
+
+
+
+
+// The elements of an 'EnumerateExpr' are pairs of the index and a reference to the corresponding
+// element of the given range.
+template< typename Range >
+class EnumerateExpr
+   : public Expression
+{
+ private:
+   using Iterator = typename Range::const_iterator;
+
+   class ConstIterator
+      : public IteratorOperators<ConstIterator>
+   {
+    private:
+      Iterator pos_{};
+      size_t index_{};
+
+      // The end iterator only knows its index for random access ranges (see 'end()'), so the
+      // iterators of bidirectional ranges cannot be decremented
+      using Category =
+         std::conditional_t< std::is_same_v< iterator_category_t<Iterator>, std::bidirectional_iterator_tag >
+                           , std::forward_iterator_tag, iterator_category_t<Iterator> >;
+
+    public:
+      using iterator_category = Category;
+      using value_type        = std::pair< size_t, typename Range::value_type >;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = std::pair< size_t, decltype( *std::declval<Iterator>() ) >;
+
+      ConstIterator() = default;
+
+      ConstIterator( Iterator pos, size_t index )
+         : pos_  ( pos   )
+         , index_( index )
+      {}
+
+      reference operator*() const {
+         return reference( index_, *pos_ );
+      }
+
+      ConstIterator& operator+=( std::ptrdiff_t n ) {
+         std::advance( pos_, n );
+         index_ += n;
+         return *this;
+      }
+
+      std::ptrdiff_t operator-( const ConstIterator& rhs ) const {
+         return pos_ - rhs.pos_;
+      }
+
+      bool operator==( const ConstIterator& rhs ) const noexcept {
+         return pos_ == rhs.pos_;
+      }
+   };
+
+ public:
+   using value_type     = typename ConstIterator::value_type;
+   using const_iterator = ConstIterator;
+   using iterator       = ConstIterator;
+
+   explicit EnumerateExpr( const Range& range )
+      : range_( range )
+   {}
+
+   const_iterator begin() const
+   {
+      return ConstIterator( range_.begin(), 0UL );
+   }
+
+   // The index of the end iterator is only computed for random access ranges, since counting
+   // the elements would consume a single-pass range. Iterators compare by their position only.
+   const_iterator end() const
+   {
+      if constexpr( is_random_access_v<Iterator> ) {
+         return ConstIterator( range_.end(), static_cast<size_t>( range_.end() - range_.begin() ) );
+      }
+      else {
+         return ConstIterator( range_.end(), 0UL );
+      }
+   }
+
+ private:
+   using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+   Range_ range_;
+};
+
+struct EnumerateOperation
+{};
+
+EnumerateOperation enumerate()
+{
+   return EnumerateOperation{};
+}
+
+template< typename Range >
+EnumerateExpr<Range> enumerate( const Range& range )
+{
+   return EnumerateExpr<Range>( range );
+}
+
+template< typename Range >
+EnumerateExpr<Range> operator|( const Range& range, EnumerateOperation )
+{
+   return EnumerateExpr<Range>( range );
+}
+
+
+
+
+// Open addressing hash map with linear probing, which serves as result of the 'aggregate()'
+// stage. All keys and values are stored in a single array of slots, which avoids the per-node
+// allocations of 'std::unordered_map' and keeps probing cache friendly. The slots are optional,
+// such that elements are only constructed on insertion and neither keys nor values have to be
+// default constructible. The hash values are scrambled by Fibonacci hashing, since 'std::hash' is
+// the identity for integral keys. Elements cannot be erased.
+template< typename Key, typename Value, typename Hash = std::hash<Key> >
+class FlatHashMap
+{
+ public:
+   using value_type = std::pair<Key,Value>;
+
+ private:
+   class ConstIterator
+   {
+    private:
+      const FlatHashMap* map_{};
+      size_t index_{};
+
+      void skipUnused() {
+         while( index_ != map_->slots_.size() && !map_->slots_[index_] ) ++index_;
+      }
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = std::pair<Key,Value>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const value_type*;
+      using reference         = const value_type&;
+
+      ConstIterator() = default;
+
+      ConstIterator( const FlatHashMap* map, size_t index )
+         : map_  ( map   )
+         , index_( index )
+      {
+         skipUnused();
+      }
+
+      ConstIterator& operator++() {
+         ++index_;
+         skipUnused();
+         return *this;
+      }
+
+      const ConstIterator operator++( int ) {
+         const ConstIterator tmp( *this );
+         ++(*this);
+         return tmp;
+      }
+
+      const value_type& operator*() const {
+         return *map_->slots_[index_];
+      }
+
+      const value_type* operator->() const {
+         return &*map_->slots_[index_];
+      }
+
+      bool operator==( const ConstIterator& rhs ) const noexcept {
+         return index_ == rhs.index_;
+      }
+
+      bool operator!=( const ConstIterator& rhs ) const noexcept {
+         return !( *this == rhs );
+      }
+   };
+
+ public:
+   using const_iterator = ConstIterator;
+   using iterator       = ConstIterator;
+
+   // The expected number of distinct keys is a pre-sizing hint, which avoids rehashing.
+   explicit FlatHashMap( size_t expectedSize = 0UL, Hash hash = Hash{} )
+      : hash_( std::move( hash ) )
+   {
+      reserve( expectedSize );
+   }
+
+   void reserve( size_t expectedSize )
+   {
+      size_t capacity( 16UL );
+      while( capacity * 3UL < expectedSize * 4UL ) capacity *= 2UL;
+      if( capacity > slots_.size() ) rehash( capacity );
+   }
+
+   // Inserts the given key/value pair in case the key is not yet contained in the map. Returns a
+   // reference to the value associated with the key and whether an insertion took place.
+   std::pair<Value&,bool> insert( const Key& key, const Value& value )
+   {
+      if( ( size_ + 1UL ) * 4UL > slots_.size() * 3UL )
+         rehash( 2UL * slots_.size() );
+
+      size_t index( slot( key ) );
+      for( ; slots_[index]; index = ( index + 1UL ) & mask() ) {
+         if( slots_[index]->first == key )
+            return { slots_[index]->second, false };
+      }
+
+      slots_[index].emplace( key, value );
+      ++size_;
+      return { slots_[index]->second, true };
+   }
+
+   const Value* find( const Key& key ) const
+   {
+      for( size_t index=slot( key ); slots_[index]; index = ( index + 1UL ) & mask() ) {
+         if( slots_[index]->first == key )
+            return &slots_[index]->second;
+      }
+      return nullptr;
+   }
+
+   // Merges all elements of the given map into this map. The values of keys contained in both
+   // maps are combined by the given 'merge' operation.
+   template< typename Merge >
+   void merge( const FlatHashMap& other, Merge merge )
+   {
+      reserve( size_ + other.size_ );
+      for( const value_type& element : other ) {
+         auto [value, inserted] = insert( element.first, element.second );
+         if( !inserted )
+            value = merge( std::move( value ), element.second );
+      }
+   }
+
+   size_t size()  const { return size_; }
+   bool   empty() const { return size_ == 0UL; }
+
+   const_iterator begin() const { return ConstIterator( this, 0UL ); }
+   const_iterator end()   const { return ConstIterator( this, slots_.size() ); }
+
+ private:
+   size_t mask() const { return slots_.size() - 1UL; }
+
+   size_t slot( const Key& key ) const
+   {
+      return ( static_cast<uint64_t>( hash_( key ) ) * 11400714819323198485ULL ) >> shift_;
+   }
+
+   void rehash( size_t capacity )
+   {
+      std::vector< std::optional<value_type> > slots( capacity );
+      std::swap( slots, slots_ );
+
+      shift_ = 64;
+      for( size_t c=capacity; c > 1UL; c /= 2UL ) --shift_;
+
+      for( auto& element : slots ) {
+         if( !element ) continue;
+         size_t index( slot( element->first ) );
+         while( slots_[index] ) index = ( index + 1UL ) & mask();
+         slots_[index].emplace( std::move( *element ) );
+      }
+   }
+
+   std::vector< std::optional<value_type> > slots_;
+   size_t size_{};
+   int shift_{ 64 };
+   Hash hash_;
+};
+
+
+
+
+template< typename Range, typename KeyFn >
+using aggregate_key_t =
+   std::decay_t< std::invoke_result_t< const KeyFn&, decltype( *std::declval<typename Range::const_iterator>() ) > >;
+
+template< typename Map, typename Iterator, typename KeyFn, typename T, typename Combine >
+void aggregateInto( Map& map, Iterator first, Iterator last
+                  , const KeyFn& key, const T& init, const Combine& combine )
+{
+   for( ; first!=last; ++first ) {
+      decltype(auto) element( *first );
+      T& value( map.insert( key( element ), init ).first );
+      value = combine( std::move( value ), element );
+   }
+}
+
+
+template< typename KeyFn, typename T, typename Combine >
+struct AggregateOperation
+{
+   KeyFn   key_;
+   T       init_;
+   Combine combine_;
+   size_t  expectedKeys_;
+};
+
+// Terminal stage, which groups the elements of a range by the given key function and combines
+// all elements with the same key, starting from 'init'. The result is a 'FlatHashMap' from the
+// keys to the combined values.
+template< typename KeyFn, typename T, typename Combine >
+AggregateOperation<KeyFn,T,Combine> aggregate( KeyFn key, T init, Combine combine
+                                             , size_t expectedKeys = 0UL )
+{
+   return AggregateOperation<KeyFn,T,Combine>{ key, init, combine, expectedKeys };
+}
+
+template< typename Range, typename KeyFn, typename T, typename Combine >
+FlatHashMap< aggregate_key_t<Range,KeyFn>, T >
+   operator|( const Range& range, const AggregateOperation<KeyFn,T,Combine>& op )
+{
+   FlatHashMap< aggregate_key_t<Range,KeyFn>, T > map( op.expectedKeys_ );
+   aggregateInto( map, range.begin(), range.end(), op.key_, op.init_, op.combine_ );
+   return map;
+}
+
+
+template< typename KeyFn, typename T, typename Combine, typename Merge >
+struct ParallelAggregateOperation
+{
+   KeyFn   key_;
+   T       init_;
+   Combine combine_;
+   Merge   merge_;
+   size_t  threads_;
+   size_t  expectedKeys_;
+};
+
+// Parallel variant of 'aggregate()': every thread aggregates a part of the range into its own
+// partial map, the partial maps are finally combined by the given 'merge' operation. The given
+// functions must therefore be safe to call concurrently. Ranges without random access cannot be
+// split and are aggregated sequentially.
+template< typename KeyFn, typename T, typename Combine, typename Merge >
+ParallelAggregateOperation<KeyFn,T,Combine,Merge>
+   parallelAggregate( KeyFn key, T init, Combine combine, Merge merge
+                    , size_t threads = std::thread::hardware_concurrency(), size_t expectedKeys = 0UL )
+{
+   return ParallelAggregateOperation<KeyFn,T,Combine,Merge>{
+      key, init, combine, merge, std::max<size_t>( threads, 1UL ), expectedKeys };
+}
+
+template< typename Range, typename KeyFn, typename T, typename Combine, typename Merge >
+FlatHashMap< aggregate_key_t<Range,KeyFn>, T >
+   operator|( const Range& range, const ParallelAggregateOperation<KeyFn,T,Combine,Merge>& op )
+{
+   using Iterator = typename Range::const_iterator;
+   using Map      = FlatHashMap< aggregate_key_t<Range,KeyFn>, T >;
+
+   if constexpr( !is_random_access_v<Iterator> ) {
+      return range | aggregate( op.key_, op.init_, op.combine_, op.expectedKeys_ );
+   }
+   else {
+      const Iterator first( range.begin() );
+      const std::ptrdiff_t size   ( range.end() - first );
+      const std::ptrdiff_t threads( std::max<std::ptrdiff_t>(
+                                       std::min<std::ptrdiff_t>( op.threads_, size ), 1 ) );
+
+      const auto part = [&]( std::ptrdiff_t i ) { return first + ( size * i ) / threads; };
+
+      std::vector<Map> partials( threads, Map( op.expectedKeys_ ) );
+      std::vector<std::thread> workers;
+
+      for( std::ptrdiff_t i=1; i<threads; ++i ) {
+         workers.emplace_back( [&,i]() {
+            aggregateInto( partials[i], part( i ), part( i+1 ), op.key_, op.init_, op.combine_ );
+         } );
+      }
+      aggregateInto( partials[0], part( 0 ), part( 1 ), op.key_, op.init_, op.combine_ );
+
+      for( std::thread& worker : workers )
+         worker.join();
+
+      for( std::ptrdiff_t i=1; i<threads; ++i )
+         partials[0].merge( partials[i], op.merge_ );
+
+      return std::move( partials[0] );
+   }
+}
+
+
+
+
+int main()
+{
+   std::vector<int> numbers{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+   auto scaledEvenNumbers =   numbers
+                            | filter( [](int n){ return n % 2 == 0; } )
+                            | transform( [](int n) { return n * 2; } )
+                            | take( 4UL );
+
+   std::cout << "\n (";
+   for( int i : scaledEvenNumbers )
+      std::cout << " " << i;
+   std::cout << " )\n\n";
+
+
+   for( const auto& c : numbers | chunk( 5UL ) ) {
+      std::cout << " [";
+      for( int i : c )
+         std::cout << " " << i;
+      std::cout << " ]";
+   }
+   std::cout << "\n\n";
+
+
+   const auto strided = numbers | stride( 5UL );
+   std::cout << " " << ( strided.end() - strided.begin() ) << " elements: (";
+   for( int i : strided )
+      std::cout << " " << i;
+   std::cout << " )\n\n";
+
+
+   for( const auto& [index,value] : zip( numbers, numbers | stride( 2UL ) ) | enumerate() )
+      std::cout << " " << index << ":(" << value.first << "," << value.second << ")";
+   std::cout << "\n\n";
+
+
+   {
+      const std::string path( "Ranges_numbers.txt" );
+      {
+         std::ofstream file( path );
+         for( int i=1; i<=100000; ++i )
+            file << i << ( i % 10 == 0 ? '\n' : ',' );
+      }
+
+      NumberStream<int> stream( path );
+
+      std::cout << " (";
+      for( int i : stream | filter( [](int n){ return n % 7 == 0; } ) | take( 5UL ) )
+         std::cout << " " << i;
+      std::cout << " )\n\n";
+
+      std::remove( path.c_str() );
+   }
+
+
+   {
+      const std::string path( "Ranges_numbers.txt" );
+      {
+         std::ofstream file( path );
+         for( int i=1; i<=10; ++i )
+            file << i << ' ';
+      }
+
+      NumberStream<int> stream( path );
+
+      std::cout << " (";
+      for( const auto& [index,value] : stream | enumerate() )
+         std::cout << " " << index << ":" << value;
+      std::cout << " )\n\n";
+
+      std::remove( path.c_str() );
+   }
+
+
+#if HAVE_POSIX_MMAP
+   {
+      const std::string path( "Ranges_numbers.bin" );
+      {
+         std::ofstream file( path, std::ios::binary );
+         for( int i=1; i<=100000; ++i )
+            file.write( reinterpret_cast<const char*>( &i ), sizeof(int) );
+      }
+
+      const MappedRecords<int> records( path );
+
+      std::cout << " (";
+      for( int i : records | stride( 1000UL ) | transform( [](int n) { return n * n; } ) | take( 5UL ) )
+         std::cout << " " << i;
+      std::cout << " )\n\n";
+
+      std::remove( path.c_str() );
+   }
+#endif
+
+
+   {
+      const auto counts =   numbers
+                          | aggregate( [](int n){ return n % 3; }, 0, [](int count, int){ return count + 1; } );
+
+      std::cout << " (";
+      for( const auto& [key,count] : counts )
+         std::cout << " " << key << ":" << count;
+      std::cout << " )\n\n";
+   }
+
+
+   {
+      std::vector<int> values( 1000000 );
+      for( size_t i=0UL; i<values.size(); ++i )
+         values[i] = static_cast<int>( i );
+
+      const auto plus = []( long long a, long long b ){ return a + b; };
+      const auto sums =   values
+                        | parallelAggregate( [](int n){ return n % 4; }, 0LL, plus, plus, 4UL, 4UL );
+
+      std::cout << " (";
+      for( int key=0; key<4; ++key )
+         std::cout << " " << key << ":" << *sums.find( key );
+      std::cout << " )\n\n";
+   }
 
 
    //auto scaledOddNumbers =   std::array<int,12UL>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }
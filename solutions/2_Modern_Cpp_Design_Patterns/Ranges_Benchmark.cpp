@@ -0,0 +1,297 @@
+/**************************************************************************************************
+*
+* \file Ranges_Benchmark.cpp
+* \brief C++ Training - Benchmark for the Range Expression Templates
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_UNCACHED_FILTER_SOLUTION 1
+#define BENCHMARK_CACHED_FILTER_SOLUTION 1
+
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+struct Expression {};
+
+template< typename T >
+using is_expression = std::is_base_of<Expression,T>;
+
+template< typename T >
+constexpr bool is_expression_v = is_expression<T>::value;
+
+
+template< typename T >
+class NonPropagatingCache
+{
+ public:
+   NonPropagatingCache() = default;
+
+   NonPropagatingCache( const NonPropagatingCache& ) noexcept
+   {}
+
+   NonPropagatingCache& operator=( const NonPropagatingCache& ) noexcept
+   {
+      value_.reset();
+      return *this;
+   }
+
+   explicit operator bool() const noexcept { return value_.has_value(); }
+
+   const T& operator*() const noexcept { return *value_; }
+
+   template< typename... Args >
+   const T& emplace( Args&&... args )
+   {
+      return value_.emplace( std::forward<Args>( args )... );
+   }
+
+ private:
+   std::optional<T> value_;
+};
+
+
+template< typename Range, typename OP >
+class FilterIterator
+{
+ private:
+   typename Range::const_iterator pos_{};
+   typename Range::const_iterator end_{};
+   OP op_{};
+
+ public:
+   using iterator_category = std::forward_iterator_tag;
+   using value_type        = typename Range::value_type;
+   using difference_type   = std::ptrdiff_t;
+
+   FilterIterator() = default;
+
+   FilterIterator( typename Range::const_iterator pos, typename Range::const_iterator end, OP op )
+      : pos_( pos )
+      , end_( end )
+      , op_ ( op  )
+   {
+      for( ; pos_!=end_; ++pos_ ) {
+         if( op_( *pos_ ) ) break;
+      }
+   }
+
+   FilterIterator& operator++() {
+      ++pos_;
+      for( ; pos_!=end_; ++pos_ ) {
+         if( op_( *pos_ ) ) break;
+      }
+      return *this;
+   }
+
+   decltype(auto) operator*() const {
+      return *pos_;
+   }
+
+   bool operator==( const FilterIterator& rhs ) const noexcept {
+      return pos_ == rhs.pos_;
+   }
+
+   bool operator!=( const FilterIterator& rhs ) const noexcept {
+      return !( *this == rhs );
+   }
+};
+
+
+#if BENCHMARK_UNCACHED_FILTER_SOLUTION
+namespace uncached_filter_solution {
+
+   template< typename Range, typename OP >
+   class FilterExpr
+      : public Expression
+   {
+    public:
+      using value_type     = typename Range::value_type;
+      using const_iterator = FilterIterator<Range,OP>;
+      using iterator       = const_iterator;
+
+      FilterExpr( const Range& range, OP op )
+         : range_( range )
+         , op_   ( op    )
+      {}
+
+      const_iterator begin() const
+      {
+         return const_iterator( range_.begin(), range_.end(), op_ );
+      }
+
+      const_iterator end() const
+      {
+         return const_iterator( range_.end(), range_.end(), op_ );
+      }
+
+    private:
+      using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+      Range_ range_;
+      OP     op_;
+   };
+
+   template< typename Range, typename OP >
+   FilterExpr<Range,OP> filter( const Range& range, OP op )
+   {
+      return FilterExpr<Range,OP>( range, op );
+   }
+
+} // namespace uncached_filter_solution
+#endif
+
+
+#if BENCHMARK_CACHED_FILTER_SOLUTION
+namespace cached_filter_solution {
+
+   template< typename Range, typename OP >
+   class FilterExpr
+      : public Expression
+   {
+    public:
+      using value_type     = typename Range::value_type;
+      using const_iterator = FilterIterator<Range,OP>;
+      using iterator       = const_iterator;
+
+      FilterExpr( const Range& range, OP op )
+         : range_( range )
+         , op_   ( op    )
+      {}
+
+      const_iterator begin() const
+      {
+         if( !begin_ )
+            begin_.emplace( range_.begin(), range_.end(), op_ );
+         return *begin_;
+      }
+
+      const_iterator end() const
+      {
+         return const_iterator( range_.end(), range_.end(), op_ );
+      }
+
+    private:
+      using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+      Range_ range_;
+      OP     op_;
+      mutable NonPropagatingCache<const_iterator> begin_;
+   };
+
+   template< typename Range, typename OP >
+   FilterExpr<Range,OP> filter( const Range& range, OP op )
+   {
+      return FilterExpr<Range,OP>( range, op );
+   }
+
+} // namespace cached_filter_solution
+#endif
+
+
+
+
+// Very selective predicate: only values in the top 0.01% of the value range pass the filter.
+struct IsRare
+{
+   bool operator()( int n ) const { return n >= 999900; }
+};
+
+
+int main()
+{
+   const size_t N    ( 100000UL );
+   const size_t steps( 2000UL );
+
+   std::random_device rd{};
+   const unsigned int seed( rd() );
+
+   std::mt19937 rng{};
+   std::uniform_int_distribution<int> dist( 0, 999999 );
+
+   std::cout << std::endl;
+
+#if BENCHMARK_UNCACHED_FILTER_SOLUTION
+   {
+      using namespace uncached_filter_solution;
+
+      rng.seed( seed );
+
+      std::vector<int> numbers( N );
+      for( int& n : numbers )
+         n = dist( rng );
+
+      const auto rare = filter( filter( numbers, IsRare{} ), []( int n ){ return n % 2 == 0; } );
+      long long total{};
+
+      std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+      start = std::chrono::high_resolution_clock::now();
+
+      for( size_t s=0UL; s<steps; ++s ) {
+         for( int n : rare )
+            total += n;
+         if( rare.begin() != rare.end() )
+            total += *rare.begin();
+      }
+
+      end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> elapsedTime( end - start );
+      const double seconds( elapsedTime.count() );
+
+      assert( total >= 0 );
+
+      std::cout << " Uncached filter solution runtime: " << seconds << "s (checksum " << total << ")\n";
+   }
+#endif
+
+#if BENCHMARK_CACHED_FILTER_SOLUTION
+   {
+      using namespace cached_filter_solution;
+
+      rng.seed( seed );
+
+      std::vector<int> numbers( N );
+      for( int& n : numbers )
+         n = dist( rng );
+
+      const auto rare = filter( filter( numbers, IsRare{} ), []( int n ){ return n % 2 == 0; } );
+      long long total{};
+
+      std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+      start = std::chrono::high_resolution_clock::now();
+
+      for( size_t s=0UL; s<steps; ++s ) {
+         for( int n : rare )
+            total += n;
+         if( rare.begin() != rare.end() )
+            total += *rare.begin();
+      }
+
+      end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> elapsedTime( end - start );
+      const double seconds( elapsedTime.count() );
+
+      assert( total >= 0 );
+
+      std::cout << " Cached filter solution runtime  : " << seconds << "s (checksum " << total << ")\n";
+   }
+#endif
+
+   std::cout << std::endl;
+
+   return EXIT_SUCCESS;
+}
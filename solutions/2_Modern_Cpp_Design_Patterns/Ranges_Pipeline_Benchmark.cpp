@@ -0,0 +1,652 @@
+/**************************************************************************************************
+*
+* \file Ranges_Pipeline_Benchmark.cpp
+* \brief C++ Training - Benchmark for Range Pipelines
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark runs the same filter/transform/take/reduce pipeline as a raw loop, with the
+* expression templates of Ranges.cpp and with the range-v3 library, for several input sizes and
+* filter selectivities. For every solution it reports the runtime per input element and, if the
+* hardware performance counters are accessible (Linux only), the number of retired instructions
+* per input element. In case an abstraction is truly zero-cost, its instruction count matches
+* the count of the raw loop.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_RAW_LOOP_SOLUTION 1
+#define BENCHMARK_EXPRESSION_TEMPLATE_SOLUTION 1
+#define BENCHMARK_RANGE_V3_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if BENCHMARK_RANGE_V3_SOLUTION
+#  include <range/v3/numeric/accumulate.hpp>
+#  include <range/v3/view/filter.hpp>
+#  include <range/v3/view/take.hpp>
+#  include <range/v3/view/transform.hpp>
+#endif
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+
+// Counter for the number of instructions retired in user space. In case the performance counters
+// are not accessible (e.g. on non-Linux systems or due to 'perf_event_paranoid'), the counter is
+// not available and no instruction counts are reported.
+class InstructionCounter
+{
+ public:
+   InstructionCounter()
+   {
+#if defined(__linux__)
+      perf_event_attr attr{};
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.size           = sizeof(attr);
+      attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      fd_ = static_cast<int>( ::syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 ) );
+#endif
+   }
+
+   InstructionCounter( const InstructionCounter& ) = delete;
+   InstructionCounter& operator=( const InstructionCounter& ) = delete;
+
+   ~InstructionCounter()
+   {
+#if defined(__linux__)
+      if( fd_ != -1 ) ::close( fd_ );
+#endif
+   }
+
+   bool available() const { return fd_ != -1; }
+
+   void start()
+   {
+#if defined(__linux__)
+      if( fd_ == -1 ) return;
+      ::ioctl( fd_, PERF_EVENT_IOC_RESET, 0 );
+      ::ioctl( fd_, PERF_EVENT_IOC_ENABLE, 0 );
+#endif
+   }
+
+   uint64_t stop()
+   {
+      uint64_t count{};
+#if defined(__linux__)
+      if( fd_ == -1 ) return count;
+      ::ioctl( fd_, PERF_EVENT_IOC_DISABLE, 0 );
+      if( ::read( fd_, &count, sizeof(count) ) != sizeof(count) ) count = 0U;
+#endif
+      return count;
+   }
+
+ private:
+   int fd_{ -1 };
+};
+
+
+// All solutions compute the sum of the first 'count' elements 'n' of the input for which
+// '(n & 1023) < threshold', transformed by '3*n+1'.
+struct Select
+{
+   int threshold;
+   bool operator()( int n ) const { return ( n & 1023 ) < threshold; }
+};
+
+struct Scale
+{
+   int operator()( int n ) const { return 3*n + 1; }
+};
+
+
+#if BENCHMARK_RAW_LOOP_SOLUTION
+namespace raw_loop_solution {
+
+   long long pipeline( const std::vector<int>& numbers, int threshold, size_t count )
+   {
+      const Select select{ threshold };
+      const Scale scale{};
+
+      long long sum{};
+      size_t taken{};
+
+      if( count == 0UL ) return sum;
+
+      for( int n : numbers ) {
+         if( select( n ) ) {
+            sum += scale( n );
+            if( ++taken == count ) break;
+         }
+      }
+
+      return sum;
+   }
+
+} // namespace raw_loop_solution
+#endif
+
+
+#if BENCHMARK_EXPRESSION_TEMPLATE_SOLUTION
+namespace expression_template_solution {
+
+   struct Expression {};
+
+   template< typename T >
+   using is_expression = std::is_base_of<Expression,T>;
+
+   template< typename T >
+   constexpr bool is_expression_v = is_expression<T>::value;
+
+
+
+
+   // Cache for a lazily computed value that is not transferred on copy or move. This resembles the
+   // 'non_propagating_cache' of range-v3: a cached iterator may refer into the source object, and
+   // therefore must not survive copying the expression that owns it.
+   template< typename T >
+   class NonPropagatingCache
+   {
+    public:
+      NonPropagatingCache() = default;
+
+      NonPropagatingCache( const NonPropagatingCache& ) noexcept
+      {}
+
+      NonPropagatingCache& operator=( const NonPropagatingCache& ) noexcept
+      {
+         value_.reset();
+         return *this;
+      }
+
+      explicit operator bool() const noexcept { return value_.has_value(); }
+
+      const T& operator*() const noexcept { return *value_; }
+
+      template< typename... Args >
+      const T& emplace( Args&&... args )
+      {
+         return value_.emplace( std::forward<Args>( args )... );
+      }
+
+    private:
+      std::optional<T> value_;
+   };
+
+
+
+
+
+   template< typename Range, typename OP >
+   class FilterExpr
+      : public Expression
+   {
+    private:
+      class ConstIterator
+      {
+       private:
+         typename Range::const_iterator pos_{};
+         typename Range::const_iterator end_{};
+         OP op_{};
+
+       public:
+         using iterator_category = std::forward_iterator_tag;
+         using value_type        = typename Range::value_type;
+         using difference_type   = std::ptrdiff_t;
+         using pointer           = void;
+         using reference         = decltype( *std::declval<typename Range::const_iterator>() );
+
+         ConstIterator() = default;
+
+         ConstIterator( typename Range::const_iterator pos, typename Range::const_iterator end, OP op )
+            : pos_( pos )
+            , end_( end )
+            , op_ ( op  )
+         {
+            for( ; pos_!=end_; ++pos_ ) {
+               if( op_( *pos_ ) ) break;
+            }
+         }
+
+         ConstIterator& operator++() {
+            ++pos_;
+            for( ; pos_!=end_; ++pos_ ) {
+               if( op_( *pos_ ) ) break;
+            }
+            return *this;
+         }
+
+         const ConstIterator operator++( int ) {
+            const ConstIterator tmp( *this );
+            ++(*this);
+            return tmp;
+         }
+
+         decltype(auto) operator*() const {
+            return *pos_;
+         }
+
+         bool operator==( const ConstIterator& rhs ) const noexcept {
+            return pos_ == rhs.pos_;
+         }
+
+         bool operator!=( const ConstIterator& rhs ) const noexcept {
+            return !( *this == rhs );
+         }
+      };
+
+    public:
+      using value_type     = typename Range::value_type;
+      using const_iterator = ConstIterator;
+      using iterator       = ConstIterator;
+
+      FilterExpr( const Range& range, OP op )
+         : range_( range )
+         , op_   ( op    )
+      {}
+
+      // The search for the first matching element is performed once and cached. Note that due to
+      // the cache, concurrent calls to 'begin()' on the same expression are not thread-safe.
+      const_iterator begin() const
+      {
+         if( !begin_ )
+            begin_.emplace( range_.begin(), range_.end(), op_ );
+         return *begin_;
+      }
+
+      const_iterator end() const
+      {
+         return ConstIterator( range_.end(), range_.end(), op_ );
+      }
+
+    private:
+      using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+      Range_ range_;
+      OP     op_;
+      mutable NonPropagatingCache<ConstIterator> begin_;
+   };
+
+   template< typename OP >
+   struct FilterOperation
+   {
+      OP op_;
+   };
+
+   template< typename OP >
+   FilterOperation<OP> filter( OP op )
+   {
+      return FilterOperation<OP>{ op };
+   }
+
+   template< typename Range, typename OP >
+   FilterExpr<Range,OP> filter( const Range& range, OP op )
+   {
+      return FilterExpr<Range,OP>( range, op );
+   }
+
+   template< typename Range, typename OP >
+   FilterExpr<Range,OP> operator|( const Range& range, FilterOperation<OP> op )
+   {
+      return FilterExpr<Range,OP>( range, op.op_ );
+   }
+
+
+
+
+   template< typename Range, typename OP >
+   class TransformExpr
+      : public Expression
+   {
+    private:
+      class ConstIterator
+      {
+       private:
+         typename Range::const_iterator pos_{};
+         OP op_{};
+
+       public:
+         using iterator_category = std::forward_iterator_tag;
+         using value_type        = typename Range::value_type;
+         using difference_type   = std::ptrdiff_t;
+         using pointer           = void;
+         using reference         = decltype( std::declval<const OP&>()(
+                                        *std::declval<typename Range::const_iterator>() ) );
+
+         ConstIterator() = default;
+
+         ConstIterator( typename Range::const_iterator pos, OP op )
+            : pos_( pos )
+            , op_ ( op  )
+         {}
+
+         ConstIterator& operator++() {
+            ++pos_;
+            return *this;
+         }
+
+         const ConstIterator operator++( int ) {
+            const ConstIterator tmp( *this );
+            ++(*this);
+            return tmp;
+         }
+
+         decltype(auto) operator*() const {
+            return op_( *pos_ );
+         }
+
+         bool operator==( const ConstIterator& rhs ) const noexcept {
+            return pos_ == rhs.pos_;
+         }
+
+         bool operator!=( const ConstIterator& rhs ) const noexcept {
+            return !( *this == rhs );
+         }
+      };
+
+    public:
+      using value_type     = typename Range::value_type;
+      using const_iterator = ConstIterator;
+      using iterator       = ConstIterator;
+
+      TransformExpr( const Range& range, OP op )
+         : range_( range )
+         , op_   ( op    )
+      {}
+
+      const_iterator begin() const
+      {
+         return ConstIterator( range_.begin(), op_ );
+      }
+
+      const_iterator end() const
+      {
+         return ConstIterator( range_.end(), op_ );
+      }
+
+    private:
+      using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+      Range_ range_;
+      OP     op_;
+   };
+
+   template< typename OP >
+   struct TransformOperation
+   {
+      OP op_;
+   };
+
+   template< typename OP >
+   TransformOperation<OP> transform( OP op )
+   {
+      return TransformOperation<OP>{ op };
+   }
+
+   template< typename Range, typename OP >
+   TransformExpr<Range,OP> transform( const Range& range, OP op )
+   {
+      return TransformExpr<Range,OP>( range, op );
+   }
+
+   template< typename Range, typename OP >
+   TransformExpr<Range,OP> operator|( const Range& range, TransformOperation<OP> op )
+   {
+      return TransformExpr<Range,OP>( range, op.op_ );
+   }
+
+
+
+
+   template< typename Range >
+   class TakeExpr
+      : public Expression
+   {
+    private:
+      class ConstIterator
+      {
+       private:
+         typename Range::const_iterator pos_{};
+         size_t number_{};
+         size_t limit_{};
+
+       public:
+         using iterator_category = std::forward_iterator_tag;
+         using value_type        = typename Range::value_type;
+         using difference_type   = std::ptrdiff_t;
+         using pointer           = void;
+         using reference         = decltype( *std::declval<typename Range::const_iterator>() );
+
+         ConstIterator() = default;
+
+         ConstIterator( typename Range::const_iterator pos, size_t number, size_t limit )
+            : pos_   ( pos    )
+            , number_( number )
+            , limit_ ( limit  )
+         {}
+
+         // The underlying iterator is not advanced past the last taken element, which avoids
+         // searching (or reading) any further elements once the limit is reached.
+         ConstIterator& operator++() {
+            if( ++number_ != limit_ )
+               ++pos_;
+            return *this;
+         }
+
+         const ConstIterator operator++( int ) {
+            const ConstIterator tmp( *this );
+            ++(*this);
+            return tmp;
+         }
+
+         decltype(auto) operator*() const {
+            return *pos_;
+         }
+
+         bool operator==( const ConstIterator& rhs ) const noexcept {
+            return pos_ == rhs.pos_ || number_ == rhs.number_;
+         }
+
+         bool operator!=( const ConstIterator& rhs ) const noexcept {
+            return !( *this == rhs );
+         }
+      };
+
+    public:
+      using value_type     = typename Range::value_type;
+      using const_iterator = ConstIterator;
+      using iterator       = ConstIterator;
+
+      TakeExpr( const Range& range, size_t number )
+         : range_ ( range  )
+         , number_( number )
+      {}
+
+      const_iterator begin() const
+      {
+         return ConstIterator( range_.begin(), 0UL, number_ );
+      }
+
+      const_iterator end() const
+      {
+         return ConstIterator( range_.end(), number_, number_ );
+      }
+
+    private:
+      using Range_ = std::conditional_t< is_expression_v<Range>, const Range, const Range& >;
+
+      Range_ range_;
+      size_t number_;
+   };
+
+   struct TakeOperation
+   {
+      size_t number_;
+   };
+
+   TakeOperation take( size_t number )
+   {
+      return TakeOperation{ number };
+   }
+
+   template< typename Range >
+   TakeExpr<Range> take( const Range& range, size_t number )
+   {
+      return TakeExpr<Range>( range, number );
+   }
+
+   template< typename Range >
+   TakeExpr<Range> operator|( const Range& range, TakeOperation op )
+   {
+      return TakeExpr<Range>( range, op.number_ );
+   }
+
+
+   long long pipeline( const std::vector<int>& numbers, int threshold, size_t count )
+   {
+      long long sum{};
+      for( int n : numbers | filter( Select{ threshold } ) | transform( Scale{} ) | take( count ) )
+         sum += n;
+      return sum;
+   }
+
+} // namespace expression_template_solution
+#endif
+
+
+#if BENCHMARK_RANGE_V3_SOLUTION
+namespace range_v3_solution {
+
+   long long pipeline( const std::vector<int>& numbers, int threshold, size_t count )
+   {
+      return ranges::accumulate(   numbers
+                                 | ranges::views::filter( Select{ threshold } )
+                                 | ranges::views::transform( Scale{} )
+                                 | ranges::views::take( count )
+                               , 0LL );
+   }
+
+} // namespace range_v3_solution
+#endif
+
+
+
+
+template< typename Pipeline >
+void benchmark( Pipeline pipeline, const std::vector<int>& numbers, int threshold, size_t count
+              , size_t repetitions, InstructionCounter& counter, long long& checksum )
+{
+   // Reading the threshold from a volatile variable in every repetition prevents the compiler
+   // from hoisting the (otherwise loop invariant) pipeline out of the repetition loop.
+   volatile int selection( threshold );
+   long long sum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   counter.start();
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t r=0UL; r<repetitions; ++r ) {
+      sum += pipeline( numbers, selection, count );
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const uint64_t instructions( counter.stop() );
+   const std::chrono::duration<double> elapsedTime( end - start );
+
+   const double elements( static_cast<double>( repetitions * numbers.size() ) );
+
+   std::cout << std::fixed << std::setprecision(2)
+             << std::setw(10) << elapsedTime.count() * 1E9 / elements;
+   if( counter.available() )
+      std::cout << std::setw(10) << static_cast<double>( instructions ) / elements << " |";
+   else
+      std::cout << std::setw(10) << "n/a" << " |";
+
+   if( checksum == 0LL )
+      checksum = sum;
+   else if( checksum != sum )
+      std::cout << " Checksum mismatch!";
+}
+
+
+int main()
+{
+   const size_t totalElements( 100000000UL );
+   const std::vector<size_t> sizes{ 1000UL, 100000UL, 10000000UL };
+   const std::vector<double> selectivities{ 0.01, 0.1, 0.5, 0.9 };
+
+   std::random_device rd{};
+   const unsigned int seed( rd() );
+
+   std::mt19937 rng{ seed };
+   std::uniform_int_distribution<int> dist( 0, 1000000 );
+
+   InstructionCounter counter{};
+
+   std::cout << "\n Runtime (ns) and retired instructions per input element"
+             << ( counter.available() ? "" : " (instruction counter not available)" ) << "\n\n"
+             << "       Size Selectivity |"
+#if BENCHMARK_RAW_LOOP_SOLUTION
+             << "          Raw loop    |"
+#endif
+#if BENCHMARK_EXPRESSION_TEMPLATE_SOLUTION
+             << "  Expression templates|"
+#endif
+#if BENCHMARK_RANGE_V3_SOLUTION
+             << "          range-v3    |"
+#endif
+             << "\n";
+
+   for( size_t size : sizes )
+   {
+      std::vector<int> numbers( size );
+      for( int& n : numbers )
+         n = dist( rng );
+
+      const size_t repetitions( std::max<size_t>( totalElements / size, 1UL ) );
+      const size_t count( size / 4UL );
+
+      for( double selectivity : selectivities )
+      {
+         const int threshold( static_cast<int>( selectivity * 1024.0 ) );
+         long long checksum{};
+
+         std::cout << std::setw(11) << size << std::setw(12) << std::setprecision(2) << selectivity << " |";
+
+#if BENCHMARK_RAW_LOOP_SOLUTION
+         benchmark( raw_loop_solution::pipeline, numbers, threshold, count, repetitions, counter, checksum );
+#endif
+#if BENCHMARK_EXPRESSION_TEMPLATE_SOLUTION
+         benchmark( expression_template_solution::pipeline, numbers, threshold, count, repetitions, counter, checksum );
+#endif
+#if BENCHMARK_RANGE_V3_SOLUTION
+         benchmark( range_v3_solution::pipeline, numbers, threshold, count, repetitions, counter, checksum );
+#endif
+
+         std::cout << "\n";
+      }
+   }
+
+   std::cout << std::endl;
+
+   return EXIT_SUCCESS;
+}
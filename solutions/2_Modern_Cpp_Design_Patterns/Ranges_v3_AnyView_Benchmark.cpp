@@ -0,0 +1,173 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_AnyView_Benchmark.cpp
+* \brief C++ Training - Benchmark for the type-erased any_view of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark measures the cost of 'begin()', of a complete traversal and of copying iterators
+* and views of an 'any_view'. The iterators of the small view (a view on a vector) store their
+* cursor in the small buffer, the ones of the large view (a filter with a large predicate) on the
+* heap. The views themselves are always stored on the heap, since their iterators and sentinels
+* refer to them. In order to compare with a purely heap-based 'any_view', compile with
+* -DRANGES_ANY_VIEW_BUFFER_SIZE=0.
+*
+* For an input 'any_view' the benchmark compares a manual iterator loop (three virtual calls per
+* element) with 'for_each', 'accumulate' and 'to', which fetch the elements in blocks of
+* RANGES_ANY_VIEW_BLOCK_SIZE elements per virtual call.
+*
+**************************************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <range/v3/algorithm/for_each.hpp>
+#include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/any_view.hpp>
+#include <range/v3/view/filter.hpp>
+
+
+using View = ranges::any_view<int, ranges::category::random_access>;
+using ForwardView = ranges::any_view<int, ranges::category::forward>;
+using InputView = ranges::any_view<int, ranges::category::input>;
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t steps, Operation operation )
+{
+   long long sum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      sum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() );
+
+   std::cout << " " << name << seconds * 1E9 / steps << "ns (checksum " << sum << ")\n";
+}
+
+
+template< typename AnyView >
+void benchmark( const char* name, AnyView& view, size_t steps )
+{
+   std::cout << " " << name << "\n";
+
+   benchmark( "   begin()        : ", steps, [&]() {
+      return *view.begin();
+   } );
+
+   benchmark( "   iterate        : ", steps / 100UL, [&]() {
+      long long sum{};
+      for( auto it=view.begin(); it!=view.end(); ++it )
+         sum += *it;
+      return sum;
+   } );
+
+   const auto first( view.begin() );
+   benchmark( "   copy iterator  : ", steps, [&]() {
+      const auto it( first );
+      return *it;
+   } );
+
+   benchmark( "   copy view      : ", steps, [&]() {
+      AnyView copy( view );
+      return *copy.begin();
+   } );
+
+   std::cout << "\n";
+}
+
+
+// Iterates with an iterator and a sentinel of an 'any_view' that has been moved and destroyed in
+// the meantime. Returns false in case not all elements are visited.
+bool checkMovedView( const std::vector<int>& numbers )
+{
+   View moved;
+   ranges::iterator_t<View> first;
+   ranges::sentinel_t<View> last;
+   {
+      View view( numbers );
+      first = view.begin();
+      last  = view.end();
+      moved = std::move( view );
+   }
+
+   size_t count( 0UL );
+   for( ; first!=last; ++first )
+      ++count;
+   return count == numbers.size();
+}
+
+
+int main()
+{
+   const size_t N    ( 1000UL );
+   const size_t steps( 10000000UL );
+
+   std::vector<int> numbers( N );
+   std::iota( numbers.begin(), numbers.end(), 1 );
+
+   std::cout << "\n Small buffer size: " << RANGES_ANY_VIEW_BUFFER_SIZE << " bytes\n\n";
+
+   if( !checkMovedView( numbers ) ) {
+      std::cout << " The iterators of a moved any_view did not visit all elements!\n\n";
+   }
+
+   {
+      View view( numbers );
+      benchmark( "Small random access view (vector)", view, steps );
+   }
+
+   {
+      std::array<int,32UL> divisors{};
+      divisors.fill( 1 );
+      ForwardView view(   numbers
+                              | ranges::views::filter( [divisors]( int n ) { return n % divisors[0] == 0; } ) );
+      benchmark( "Large forward view (filter with large predicate)", view, steps );
+   }
+
+   {
+      InputView view( numbers );
+      const size_t traversals( steps / 1000UL );
+
+      std::cout << " Input view (vector)\n";
+
+      benchmark( "   iterator loop  : ", traversals, [&]() {
+         long long sum{};
+         for( auto it=view.begin(); it!=view.end(); ++it )
+            sum += *it;
+         return sum;
+      } );
+
+      benchmark( "   for_each       : ", traversals, [&]() {
+         long long sum{};
+         ranges::for_each( view, [&sum]( int n ){ sum += n; } );
+         return sum;
+      } );
+
+      benchmark( "   accumulate     : ", traversals, [&]() {
+         return ranges::accumulate( view, 0LL );
+      } );
+
+      benchmark( "   to<vector>     : ", traversals, [&]() {
+         const auto v( ranges::to<std::vector>( view ) );
+         return static_cast<long long>( v.back() );
+      } );
+
+      std::cout << "\n";
+   }
+
+   return EXIT_SUCCESS;
+}
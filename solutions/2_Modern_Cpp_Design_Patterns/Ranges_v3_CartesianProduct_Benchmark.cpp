@@ -0,0 +1,170 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_CartesianProduct_Benchmark.cpp
+* \brief C++ Training - Benchmark for the cartesian_product view of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark performs a nested-loop join of two sets of points: it counts all pairs of points
+* closer than a given distance. The second set is larger than the L2 cache. The pairs are visited
+* in lexicographic order by nested loops and by 'views::cartesian_product', and tile by tile by
+* nested loops over blocks and by 'views::tiled_cartesian_product'. The last variant splits the
+* lexicographic product into chunks by random access, as it would be split across threads. The
+* benchmark reports the throughput in million pairs per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_LOOP_SOLUTION 1
+#define BENCHMARK_TILED_LOOP_SOLUTION 1
+#define BENCHMARK_PRODUCT_SOLUTION 1
+#define BENCHMARK_TILED_PRODUCT_SOLUTION 1
+#define BENCHMARK_CHUNKED_PRODUCT_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <range/v3/view/cartesian_product.hpp>
+#include <range/v3/view/subrange.hpp>
+
+
+struct Point
+{
+   float x, y, z, w;
+};
+
+using Points = std::vector<Point>;
+
+
+inline bool close( const Point& a, const Point& b )
+{
+   const float dx( a.x - b.x );
+   const float dy( a.y - b.y );
+   const float dz( a.z - b.z );
+   return dx*dx + dy*dy + dz*dz < 0.0001F;
+}
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t pairs, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << "   " << name << pairs / seconds / 1E6 << " M pairs/s (checksum " << checksum << ")\n";
+}
+
+
+template< typename Rng >
+size_t join( const Rng& rng )
+{
+   size_t count{};
+   for( auto it=ranges::begin( rng ); it!=ranges::end( rng ); ++it ) {
+      const auto& pair( *it );
+      count += close( std::get<0>( pair ), std::get<1>( pair ) );
+   }
+   return count;
+}
+
+
+Points points( size_t size, unsigned int seed )
+{
+   std::mt19937 rng{ seed };
+   std::uniform_real_distribution<float> dist( 0.0F, 1.0F );
+   Points p( size );
+   std::generate( p.begin(), p.end(), [&]() { return Point{ dist( rng ), dist( rng ), dist( rng ), 0.0F }; } );
+   return p;
+}
+
+
+int main()
+{
+   const size_t tile  ( 4096UL );
+   const size_t chunks( 16UL );
+   const size_t steps ( 3UL );
+
+   const Points a( points(     512UL, 1U ) );
+   const Points b( points( 1000000UL, 2U ) );
+   const size_t pairs( a.size() * b.size() );
+
+   // Hiding the point sets behind volatile pointers keeps the compiler from hoisting the loop
+   // invariant join out of the benchmark loop
+   const Points* volatile sourceA( &a );
+   const Points* volatile sourceB( &b );
+
+   std::cout << "\n " << a.size() << " x " << b.size() << " points ("
+             << b.size() * sizeof(Point) / 1E6 << " MB)\n";
+
+#if BENCHMARK_LOOP_SOLUTION
+   benchmark( "nested loops            : ", pairs, steps, [&]() {
+      size_t count{};
+      for( const Point& p : *sourceA )
+         for( const Point& q : *sourceB )
+            count += close( p, q );
+      return count;
+   } );
+#endif
+
+#if BENCHMARK_TILED_LOOP_SOLUTION
+   benchmark( "tiled nested loops      : ", pairs, steps, [&]() {
+      const Points& pa( *sourceA );
+      const Points& pb( *sourceB );
+      size_t count{};
+      for( size_t i=0UL; i<pa.size(); i+=tile )
+         for( size_t j=0UL; j<pb.size(); j+=tile )
+            for( size_t k=i; k<std::min( i+tile, pa.size() ); ++k )
+               for( size_t l=j; l<std::min( j+tile, pb.size() ); ++l )
+                  count += close( pa[k], pb[l] );
+      return count;
+   } );
+#endif
+
+#if BENCHMARK_PRODUCT_SOLUTION
+   benchmark( "cartesian_product       : ", pairs, steps, [&]() {
+      return join( ranges::views::cartesian_product( *sourceA, *sourceB ) );
+   } );
+#endif
+
+#if BENCHMARK_TILED_PRODUCT_SOLUTION
+   benchmark( "tiled_cartesian_product : ", pairs, steps, [&]() {
+      return join( ranges::views::tiled_cartesian_product( tile, *sourceA, *sourceB ) );
+   } );
+#endif
+
+#if BENCHMARK_CHUNKED_PRODUCT_SOLUTION
+   benchmark( "cartesian_product chunks: ", pairs, steps, [&]() {
+      const auto product( ranges::views::cartesian_product( *sourceA, *sourceB ) );
+      const auto size( static_cast<std::ptrdiff_t>( ranges::size( product ) ) );
+      const auto chunk( ( size + static_cast<std::ptrdiff_t>( chunks ) - 1 ) / static_cast<std::ptrdiff_t>( chunks ) );
+      size_t count{};
+      for( std::ptrdiff_t first=0; first<size; first+=chunk ) {
+         const auto begin( ranges::begin( product ) + first );
+         const auto end  ( ranges::begin( product ) + std::min( first+chunk, size ) );
+         count += join( ranges::make_subrange( begin, end ) );
+      }
+      return count;
+   } );
+#endif
+
+   std::cout << "\n";
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Compare_Benchmark.cpp
+* \brief C++ Training - Benchmark for the comparison algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark compares two byte buffers that differ only in their last byte with 'equal',
+* 'mismatch' and 'lexicographical_compare'. For contiguous ranges of integers and the default
+* comparators the range-v3 algorithms compare the raw bytes, 'equal' and the comparison of
+* unsigned bytes with 'memcmp' and the others with SSE2, 64 bytes per branch. Passing a lambda
+* as comparator selects the generic element by element loops. The references are the algorithms
+* of the standard library. The benchmark reports the compared bytes per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_SOLUTION 1
+#define BENCHMARK_GENERIC_SOLUTION 1
+#define BENCHMARK_RANGES_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <range/v3/algorithm/equal.hpp>
+#include <range/v3/algorithm/lexicographical_compare.hpp>
+#include <range/v3/algorithm/mismatch.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double rate( bytes * steps / elapsedTime.count() );
+
+   std::cout << "   " << name << rate * 1E-9 << " GB/s (checksum " << checksum << ")\n";
+}
+
+
+template< typename Buffer >
+void benchmark( const Buffer& a, const Buffer& b, size_t steps )
+{
+   using Value = typename Buffer::value_type;
+
+   // Hiding the buffers behind volatile pointers keeps the compiler from hoisting the loop
+   // invariant comparisons out of the benchmark loops
+   const Buffer* volatile x( &a );
+   const Buffer* volatile y( &b );
+   const size_t bytes( a.size() * sizeof( Value ) );
+   auto equalTo = []( Value u, Value v ){ return u == v; };
+   auto lessThan = []( Value u, Value v ){ return u < v; };
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::equal                              : ", bytes, steps, [&]() {
+      return static_cast<size_t>( std::equal( x->begin(), x->end(), y->begin(), y->end() ) );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "ranges::equal (generic)                 : ", bytes, steps, [&]() {
+      return static_cast<size_t>( ranges::equal( *x, *y, equalTo ) );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::equal                           : ", bytes, steps, [&]() {
+      return static_cast<size_t>( ranges::equal( *x, *y ) );
+   } );
+#endif
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::mismatch                           : ", bytes, steps, [&]() {
+      return static_cast<size_t>(
+         std::mismatch( x->begin(), x->end(), y->begin(), y->end() ).first - x->begin() );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "ranges::mismatch (generic)              : ", bytes, steps, [&]() {
+      return static_cast<size_t>( ranges::mismatch( *x, *y, equalTo ).in1 - x->begin() );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::mismatch                        : ", bytes, steps, [&]() {
+      return static_cast<size_t>( ranges::mismatch( *x, *y ).in1 - x->begin() );
+   } );
+#endif
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::lexicographical_compare            : ", bytes, steps, [&]() {
+      return static_cast<size_t>(
+         std::lexicographical_compare( x->begin(), x->end(), y->begin(), y->end() ) );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "ranges::lexicographical_compare (generic): ", bytes, steps, [&]() {
+      return static_cast<size_t>( ranges::lexicographical_compare( *x, *y, lessThan ) );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::lexicographical_compare         : ", bytes, steps, [&]() {
+      return static_cast<size_t>( ranges::lexicographical_compare( *x, *y ) );
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+template< typename Buffer >
+void benchmark( const char* type, size_t size, size_t steps )
+{
+   std::cout << " " << type << " buffers of " << size << " bytes\n";
+
+   std::mt19937 rng{ 1U };
+   std::uniform_int_distribution<int> byte( 0, 127 );
+
+   Buffer a( size, 0 );
+   for( auto& c : a )
+      c = static_cast<typename Buffer::value_type>( byte( rng ) );
+   Buffer b( a );
+   b.back() = static_cast<typename Buffer::value_type>( a.back() + 1 );
+
+   benchmark( a, b, steps );
+}
+
+
+int main()
+{
+   std::cout << "\n";
+
+   for( size_t size : { 64UL, 4096UL, 1024UL * 1024UL, 64UL * 1024UL * 1024UL } )
+   {
+      const size_t steps( std::max( 4UL, 256UL * 1024UL * 1024UL / size ) );
+      benchmark< std::vector<unsigned char> >( "Unsigned byte", size, steps );
+      benchmark< std::string >( "String (char)", size, steps );
+   }
+
+   return EXIT_SUCCESS;
+}
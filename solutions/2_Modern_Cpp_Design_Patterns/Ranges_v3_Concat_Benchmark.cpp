@@ -0,0 +1,163 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Concat_Benchmark.cpp
+* \brief C++ Training - Benchmark for the concat and join views of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark sums up ("accumulate", "for_each") and copies ("copy") the elements of four
+* large vectors. The reference are plain loops over the individual vectors. The concatenation
+* of the vectors with 'views::concat' (and the same vectors as a vector of vectors flattened by
+* 'views::join') is traversed once with an iterator loop, which dispatches on the current vector
+* in every increment and dereference, and once with the corresponding range-v3 algorithm, which
+* runs a tight loop per vector ("segmented iteration"). The benchmark reports the throughput in
+* million elements per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_LOOP_SOLUTION 1
+#define BENCHMARK_ITERATOR_SOLUTION 1
+#define BENCHMARK_ALGORITHM_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <range/v3/algorithm/copy.hpp>
+#include <range/v3/algorithm/for_each.hpp>
+#include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/view/concat.hpp>
+#include <range/v3/view/join.hpp>
+
+
+using Vectors = std::vector< std::vector<int> >;
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t elements, size_t steps, Operation operation )
+{
+   long checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << "   " << name << elements / seconds / 1E6 << " M elements/s (checksum " << checksum << ")\n";
+}
+
+
+template< typename Rng >
+long iteratorSum( const Rng& rng )
+{
+   long sum{};
+   for( auto it=ranges::begin( rng ); it!=ranges::end( rng ); ++it )
+      sum += *it;
+   return sum;
+}
+
+
+template< typename Rng >
+long iteratorCopy( const Rng& rng, std::vector<int>& out )
+{
+   auto dst( out.begin() );
+   for( auto it=ranges::begin( rng ); it!=ranges::end( rng ); ++it, ++dst )
+      *dst = *it;
+   return out.back();
+}
+
+
+template< typename Rng >
+void benchmark( const char* name, const Rng& rng, size_t elements, size_t steps, std::vector<int>& out )
+{
+   std::cout << " " << name << "\n";
+
+   // Hiding the range behind a volatile pointer keeps the compiler from hoisting the loop
+   // invariant traversal out of the benchmark loop
+   const Rng* volatile source( &rng );
+
+#if BENCHMARK_ITERATOR_SOLUTION
+   benchmark( "iterator loop (accumulate): ", elements, steps, [&]() {
+      return iteratorSum( *source );
+   } );
+   benchmark( "iterator loop (copy)      : ", elements, steps, [&]() {
+      return iteratorCopy( *source, out );
+   } );
+#endif
+
+#if BENCHMARK_ALGORITHM_SOLUTION
+   benchmark( "algorithm     (accumulate): ", elements, steps, [&]() {
+      return ranges::accumulate( *source, 0L );
+   } );
+   benchmark( "algorithm     (for_each)  : ", elements, steps, [&]() {
+      long sum{};
+      ranges::for_each( *source, [&sum]( int i ) { sum += i; } );
+      return sum;
+   } );
+   benchmark( "algorithm     (copy)      : ", elements, steps, [&]() {
+      ranges::copy( *source, out.begin() );
+      return long{ out.back() };
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+int main()
+{
+   const size_t size ( 2000000UL );
+   const size_t steps( 50UL );
+
+   Vectors vectors( 4UL, std::vector<int>( size ) );
+   for( size_t i=0UL; i<vectors.size(); ++i )
+      std::iota( vectors[i].begin(), vectors[i].end(), static_cast<int>( i ) );
+
+   const size_t elements( vectors.size() * size );
+   std::vector<int> out( elements );
+
+   std::cout << "\n Elements: " << elements << "\n\n";
+
+#if BENCHMARK_LOOP_SOLUTION
+   {
+      std::cout << " Plain loops over the vectors\n";
+      const Vectors* volatile source( &vectors );
+
+      benchmark( "plain loop    (accumulate): ", elements, steps, [&]() {
+         long sum{};
+         for( const auto& v : *source )
+            for( int i : v )
+               sum += i;
+         return sum;
+      } );
+      benchmark( "plain loop    (copy)      : ", elements, steps, [&]() {
+         auto dst( out.begin() );
+         for( const auto& v : *source )
+            dst = std::copy( v.begin(), v.end(), dst );
+         return long{ out.back() };
+      } );
+
+      std::cout << "\n";
+   }
+#endif
+
+   const auto concat( ranges::views::concat( vectors[0], vectors[1], vectors[2], vectors[3] ) );
+   benchmark( "views::concat of four vectors", concat, elements, steps, out );
+
+   const auto join( vectors | ranges::views::join );
+   benchmark( "views::join of a vector of four vectors", join, elements, steps, out );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_CopyFill_Benchmark.cpp
+* \brief C++ Training - Benchmark for the copy and fill algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark copies, moves and fills buffers of 32-bit integers and of bytes that fit into
+* the L1 cache, the L2 cache or neither. For contiguous ranges of trivially copyable elements
+* 'ranges::copy' and 'ranges::move' call 'memmove'; 'ranges::fill' and 'ranges::fill_n' call
+* 'memset' for values made of a single repeated byte and otherwise store the value repeated in
+* 16 bytes with SSE2. The generic element by element loops and the algorithms of the standard
+* library serve as references. The benchmark reports the written bytes per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_GENERIC_SOLUTION 1
+#define BENCHMARK_STD_SOLUTION 1
+#define BENCHMARK_RANGES_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <range/v3/algorithm/copy.hpp>
+#include <range/v3/algorithm/fill.hpp>
+#include <range/v3/algorithm/fill_n.hpp>
+#include <range/v3/algorithm/move.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double rate( bytes * steps / elapsedTime.count() );
+
+   std::cout << "   " << name << rate * 1E-9 << " GB/s\n";
+}
+
+
+// The element by element loops the range-v3 algorithms fall back to
+template< typename I, typename O >
+O genericCopy( I first, I last, O out )
+{
+   for( ; first!=last; ++first, ++out )
+      *out = *first;
+   return out;
+}
+
+template< typename O, typename V >
+O genericFill( O first, O last, const V& value )
+{
+   for( ; first!=last; ++first )
+      *first = value;
+   return first;
+}
+
+template< typename O, typename V >
+O genericFillN( O first, std::ptrdiff_t n, const V& value )
+{
+   for( ; n!=0; --n, ++first )
+      *first = value;
+   return first;
+}
+
+
+template< typename T >
+size_t checksum( const std::vector<T>& v )
+{
+   return static_cast<size_t>( v.front() ) + static_cast<size_t>( v[v.size()/2UL] )
+        + static_cast<size_t>( v.back() );
+}
+
+
+void benchmark( size_t bytes, size_t steps )
+{
+   using Int = std::int32_t;
+
+   std::cout << " Buffers of " << bytes << " bytes\n";
+
+   std::vector<Int> source( bytes / sizeof(Int) );
+   for( size_t i=0UL; i<source.size(); ++i )
+      source[i] = static_cast<Int>( i );
+   std::vector<Int> target( source.size() );
+   std::vector<unsigned char> chars( bytes );
+
+   // Hiding the buffers behind volatile pointers keeps the compiler from hoisting the loop
+   // invariant operations out of the benchmark loops
+   const std::vector<Int>* volatile src( &source );
+   std::vector<Int>* volatile dst( &target );
+   std::vector<unsigned char>* volatile bytesDst( &chars );
+   volatile Int zero( 0 );
+   volatile Int pattern( 0x01020304 );
+   volatile unsigned char letter( 'a' );
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "generic copy             : ", bytes, steps, [&]() {
+      genericCopy( src->begin(), src->end(), dst->begin() );
+   } );
+#endif
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::copy                : ", bytes, steps, [&]() {
+      std::copy( src->begin(), src->end(), dst->begin() );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::copy             : ", bytes, steps, [&]() {
+      ranges::copy( *src, dst->begin() );
+   } );
+   benchmark( "ranges::move             : ", bytes, steps, [&]() {
+      ranges::move( src->begin(), src->end(), dst->begin() );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "generic fill (zero)      : ", bytes, steps, [&]() {
+      genericFill( dst->begin(), dst->end(), static_cast<Int>( zero ) );
+   } );
+#endif
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::fill (zero)         : ", bytes, steps, [&]() {
+      std::fill( dst->begin(), dst->end(), static_cast<Int>( zero ) );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::fill (zero)      : ", bytes, steps, [&]() {
+      ranges::fill( *dst, static_cast<Int>( zero ) );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "generic fill (pattern)   : ", bytes, steps, [&]() {
+      genericFill( dst->begin(), dst->end(), static_cast<Int>( pattern ) );
+   } );
+#endif
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::fill (pattern)      : ", bytes, steps, [&]() {
+      std::fill( dst->begin(), dst->end(), static_cast<Int>( pattern ) );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::fill (pattern)   : ", bytes, steps, [&]() {
+      ranges::fill( *dst, static_cast<Int>( pattern ) );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "generic fill_n (bytes)   : ", bytes, steps, [&]() {
+      genericFillN( bytesDst->begin(), static_cast<std::ptrdiff_t>( bytes ),
+                    static_cast<unsigned char>( letter ) );
+   } );
+#endif
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::fill_n (bytes)      : ", bytes, steps, [&]() {
+      std::fill_n( bytesDst->begin(), bytes, static_cast<unsigned char>( letter ) );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::fill_n (bytes)   : ", bytes, steps, [&]() {
+      ranges::fill_n( bytesDst->begin(), static_cast<std::ptrdiff_t>( bytes ),
+                      static_cast<unsigned char>( letter ) );
+   } );
+#endif
+
+   std::cout << "   (checksum " << checksum( target ) + checksum( chars ) << ")\n\n";
+}
+
+
+int main()
+{
+   std::cout << "\n";
+
+   for( size_t bytes : { 16UL * 1024UL, 256UL * 1024UL, 64UL * 1024UL * 1024UL } )
+   {
+      const size_t steps( std::max( 4UL, 1024UL * 1024UL * 1024UL / bytes ) );
+      benchmark( bytes, steps );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Execution_Benchmark.cpp
+* \brief C++ Training - Benchmark for the execution policies of the range-v3 algorithms
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark runs 'for_each', 'transform', 'count_if' and 'find_if' over 16 million doubles,
+* once without an execution policy and once with 'ranges::execution::par', which the versions in
+* the 'ranges::parallel' namespace of <range/v3/algorithm/parallel.hpp> accept. With the parallel
+* policy the algorithms split random-access ranges into chunks that a work-stealing pool of
+* std::thread::hardware_concurrency() - 1 threads and the calling thread process; on a single
+* core the parallel versions show the overhead of the pool. The benchmark reports the processed
+* elements per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_SEQUENTIAL_SOLUTION 1
+#define BENCHMARK_PARALLEL_SOLUTION 1
+
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <range/v3/algorithm/count_if.hpp>
+#include <range/v3/algorithm/find_if.hpp>
+#include <range/v3/algorithm/for_each.hpp>
+#include <range/v3/algorithm/parallel.hpp>
+#include <range/v3/algorithm/transform.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t size, size_t steps, Operation operation )
+{
+   double checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double rate( size * steps / elapsedTime.count() );
+
+   std::cout << "   " << name << rate * 1E-6 << " M elements/s (checksum " << checksum << ")\n";
+}
+
+
+int main()
+{
+   const size_t size ( 16UL * 1024UL * 1024UL );
+   const size_t steps( 5UL );
+
+   std::vector<double> source( size );
+   for( size_t i=0UL; i<size; ++i )
+      source[i] = static_cast<double>( i % 1000UL ) * 0.001;
+   source.back() = 2.0;
+   std::vector<double> target( size );
+
+   // Hiding the buffers behind volatile pointers keeps the compiler from hoisting the loop
+   // invariant algorithms out of the benchmark loops
+   std::vector<double>* volatile src( &source );
+   std::vector<double>* volatile dst( &target );
+
+   auto heavy = []( double x ){ return std::sqrt( x ) * std::sin( x ) + std::exp( -x ); };
+   auto scale = []( double& x ){ x = x * 1.0000001 + 1E-9; };
+   auto above = []( double x ){ return std::sin( x ) > 0.5; };
+   auto last  = []( double x ){ return std::sqrt( x ) > 1.2; };
+
+   std::cout << "\n " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+#if BENCHMARK_SEQUENTIAL_SOLUTION
+   std::cout << " Sequential\n";
+   benchmark( "for_each          : ", size, steps, [&]() {
+      ranges::for_each( *dst, scale );
+      return ( *dst )[size / 2UL];
+   } );
+   benchmark( "transform         : ", size, steps, [&]() {
+      ranges::transform( *src, dst->begin(), heavy );
+      return ( *dst )[size / 2UL];
+   } );
+   benchmark( "count_if          : ", size, steps, [&]() {
+      return static_cast<double>( ranges::count_if( *src, above ) );
+   } );
+   benchmark( "find_if           : ", size, steps, [&]() {
+      return static_cast<double>( ranges::find_if( *src, last ) - src->begin() );
+   } );
+   std::cout << "\n";
+#endif
+
+#if BENCHMARK_PARALLEL_SOLUTION
+   std::cout << " Parallel\n";
+   benchmark( "for_each (par)    : ", size, steps, [&]() {
+      ranges::parallel::for_each( ranges::execution::par, *dst, scale );
+      return ( *dst )[size / 2UL];
+   } );
+   benchmark( "transform (par)   : ", size, steps, [&]() {
+      ranges::parallel::transform( ranges::execution::par, *src, dst->begin(), heavy );
+      return ( *dst )[size / 2UL];
+   } );
+   benchmark( "count_if (par)    : ", size, steps, [&]() {
+      return static_cast<double>(
+         ranges::parallel::count_if( ranges::execution::par, *src, above ) );
+   } );
+   benchmark( "find_if (par)     : ", size, steps, [&]() {
+      return static_cast<double>( ranges::parallel::find_if( ranges::execution::par, *src, last )
+                                  - src->begin() );
+   } );
+   std::cout << "\n";
+#endif
+
+   return EXIT_SUCCESS;
+}
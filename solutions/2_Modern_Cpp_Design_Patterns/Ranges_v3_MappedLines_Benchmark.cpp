@@ -0,0 +1,101 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_MappedLines_Benchmark.cpp
+* \brief C++ Training - Benchmark for line splitting with the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark writes a log-like text file and splits it into lines with 'ranges::getlines',
+* which copies every line into a 'std::string', and with 'ranges::mapped_lines', which maps the
+* file into memory and yields 'std::string_view's. It reports the throughput in MB/s. The file
+* is read once before the measurements, such that both solutions read from the page cache.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_GETLINES_SOLUTION 1
+#define BENCHMARK_MAPPED_LINES_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <range/v3/view/getlines.hpp>
+#include <range/v3/view/mapped_lines.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << " " << name << bytes / seconds / 1E6 << " MB/s (" << seconds << "s, checksum "
+             << checksum << ")\n";
+}
+
+
+int main()
+{
+   const char* const path( "Ranges_v3_MappedLines_Benchmark.txt" );
+   const size_t lines( 1000000UL );
+   const size_t steps( 10UL );
+
+   // Writing a log-like file with lines of 20 to 200 characters
+   size_t bytes{};
+   {
+      std::mt19937 rng{};
+      std::uniform_int_distribution<size_t> length( 20UL, 200UL );
+      std::ofstream out( path, std::ios::binary );
+      std::string line;
+      for( size_t i=0UL; i<lines; ++i ) {
+         line.assign( length( rng ), 'a' + static_cast<char>( i % 26UL ) );
+         out << line << '\n';
+         bytes += line.size() + 1UL;
+      }
+   }
+
+   std::cout << "\n File size: " << bytes / 1E6 << " MB\n\n";
+
+#if BENCHMARK_GETLINES_SOLUTION
+   benchmark( "getlines     : ", bytes, steps, [path]() {
+      std::ifstream in( path, std::ios::binary );
+      size_t sum{};
+      for( const std::string& line : ranges::getlines( in ) )
+         sum += line.size();
+      return sum;
+   } );
+#endif
+
+#if BENCHMARK_MAPPED_LINES_SOLUTION
+   benchmark( "mapped_lines : ", bytes, steps, [path]() {
+      size_t sum{};
+      for( std::string_view line : ranges::mapped_lines( path ) )
+         sum += line.size();
+      return sum;
+   } );
+#endif
+
+   std::cout << "\n";
+
+   std::remove( path );
+
+   return EXIT_SUCCESS;
+}
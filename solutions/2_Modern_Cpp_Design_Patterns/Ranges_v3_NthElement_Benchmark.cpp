@@ -0,0 +1,175 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_NthElement_Benchmark.cpp
+* \brief C++ Training - Benchmark for the selection algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark selects the k-th smallest of 64-bit integers with the introselect of
+* 'std::nth_element', with the Floyd-Rivest selection of 'ranges::nth_element' and with the
+* sampling based 'ranges::parallel_nth_element', and the k smallest in order with the heap of
+* 'std::partial_sort' and with 'ranges::partial_sort', which uses insertion into a sorted prefix
+* for small k, a heap in between and selection followed by a sort for large k. The inputs are
+* random, sorted, reverse sorted, organ pipe shaped and random with few distinct values.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_NTH_ELEMENT_SOLUTION 1
+#define BENCHMARK_RANGES_NTH_ELEMENT_SOLUTION 1
+#define BENCHMARK_PARALLEL_NTH_ELEMENT_SOLUTION 1
+#define BENCHMARK_STD_PARTIAL_SORT_SOLUTION 1
+#define BENCHMARK_RANGES_PARTIAL_SORT_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <range/v3/algorithm/is_sorted.hpp>
+#include <range/v3/algorithm/nth_element.hpp>
+#include <range/v3/algorithm/parallel_nth_element.hpp>
+#include <range/v3/algorithm/partial_sort.hpp>
+
+
+using Values = std::vector<std::uint64_t>;
+
+
+bool isSelected( const Values& values, size_t k )
+{
+   if( k == values.size() )
+      return true;
+   const auto nth( values[k] );
+   return std::all_of( values.begin(), values.begin()+k, [nth]( auto v ){ return v <= nth; } ) &&
+          std::all_of( values.begin()+k, values.end(), [nth]( auto v ){ return nth <= v; } );
+}
+
+
+bool isPartiallySorted( const Values& values, size_t k )
+{
+   return ranges::is_sorted( values.begin(), values.begin()+k ) &&
+          ( k == 0UL || isSelected( values, k-1UL ) );
+}
+
+
+template< typename Select, typename Check >
+void measure( const char* name, const Values& input, size_t k, size_t steps,
+              Select select, Check check )
+{
+   double seconds{};
+
+   for( size_t s=0UL; s<steps; ++s )
+   {
+      Values values( input );
+
+      std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+      start = std::chrono::high_resolution_clock::now();
+
+      select( values, k );
+
+      end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> elapsedTime( end - start );
+      seconds += elapsedTime.count();
+
+      if( s == 0UL && !check( values, k ) ) {
+         std::cout << " " << name << " did not select the elements!\n";
+      }
+   }
+
+   std::cout << " " << name << seconds / steps << "s\n";
+}
+
+
+void benchmarkNthElement( const Values& input, size_t k, size_t steps )
+{
+   std::cout << "   nth_element (k=" << k << ")\n";
+
+#if BENCHMARK_STD_NTH_ELEMENT_SOLUTION
+   measure( "     std::nth_element            : ", input, k, steps,
+            []( Values& v, size_t n ){ std::nth_element( v.begin(), v.begin()+n, v.end() ); },
+            isSelected );
+#endif
+#if BENCHMARK_RANGES_NTH_ELEMENT_SOLUTION
+   measure( "     ranges::nth_element         : ", input, k, steps,
+            []( Values& v, size_t n ){ ranges::nth_element( v, v.begin()+n ); },
+            isSelected );
+#endif
+#if BENCHMARK_PARALLEL_NTH_ELEMENT_SOLUTION
+   measure( "     ranges::parallel_nth_element: ", input, k, steps,
+            []( Values& v, size_t n ){ ranges::parallel_nth_element( v, v.begin()+n ); },
+            isSelected );
+#endif
+}
+
+
+void benchmarkPartialSort( const Values& input, size_t k, size_t steps )
+{
+   std::cout << "   partial_sort (k=" << k << ")\n";
+
+#if BENCHMARK_STD_PARTIAL_SORT_SOLUTION
+   measure( "     std::partial_sort           : ", input, k, steps,
+            []( Values& v, size_t n ){ std::partial_sort( v.begin(), v.begin()+n, v.end() ); },
+            isPartiallySorted );
+#endif
+#if BENCHMARK_RANGES_PARTIAL_SORT_SOLUTION
+   measure( "     ranges::partial_sort        : ", input, k, steps,
+            []( Values& v, size_t n ){ ranges::partial_sort( v, v.begin()+n ); },
+            isPartiallySorted );
+#endif
+}
+
+
+void benchmark( const char* name, const Values& input, size_t steps )
+{
+   const size_t N( input.size() );
+
+   std::cout << " " << name << " (N=" << N << ")\n";
+
+   for( size_t k : { N/2UL, N/100UL, N-N/100UL } )
+      benchmarkNthElement( input, k, steps );
+
+   for( size_t k : { 10UL, 1000UL, N/100UL, N/10UL } )
+      benchmarkPartialSort( input, k, steps );
+
+   std::cout << "\n";
+}
+
+
+int main()
+{
+   const size_t N    ( 10000000UL );
+   const size_t steps( 3UL );
+
+   std::mt19937_64 rng{};
+
+   std::cout << "\n Threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+   Values values( N );
+
+   for( auto& value : values )
+      value = rng();
+   benchmark( "Random 64-bit unsigned integers", values, steps );
+
+   std::sort( values.begin(), values.end() );
+   benchmark( "Sorted 64-bit unsigned integers", values, steps );
+
+   std::reverse( values.begin(), values.end() );
+   benchmark( "Reverse sorted 64-bit unsigned integers", values, steps );
+
+   for( size_t i=0UL; i<N; ++i )
+      values[i] = std::min( i, N-i );
+   benchmark( "Organ pipe", values, steps );
+
+   for( auto& value : values )
+      value = rng() % 16U;
+   benchmark( "16 distinct values", values, steps );
+
+   return EXIT_SUCCESS;
+}
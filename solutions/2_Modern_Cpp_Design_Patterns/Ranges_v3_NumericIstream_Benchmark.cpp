@@ -0,0 +1,136 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_NumericIstream_Benchmark.cpp
+* \brief C++ Training - Benchmark for reading numbers with the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark writes a file of integers and a file of floating point numbers and sums them up
+* with 'ranges::istream', which calls the locale-aware 'operator>>' for every value, and with
+* 'ranges::numeric_istream', which parses with 'std::from_chars' from large chunks of a stream or
+* from the memory-mapped file. It reports the throughput in MB/s. The files are read once before
+* the measurements, such that all solutions read from the page cache.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_ISTREAM_SOLUTION 1
+#define BENCHMARK_NUMERIC_ISTREAM_SOLUTION 1
+#define BENCHMARK_NUMERIC_ISTREAM_MMAP_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/view/istream.hpp>
+#include <range/v3/view/numeric_istream.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   double checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << "   " << name << bytes / seconds / 1E6 << " MB/s (" << seconds << "s, checksum "
+             << checksum << ")\n";
+}
+
+
+template< typename T, typename Generator >
+void benchmark( const char* name, const char* path, size_t N, size_t steps, Generator generate )
+{
+   size_t bytes{};
+   {
+      std::ofstream out( path, std::ios::binary );
+      for( size_t i=0UL; i<N; ++i ) {
+         const std::string number( std::to_string( generate() ) );
+         out << number << ( i % 10UL == 9UL ? '\n' : ' ' );
+         bytes += number.size() + 1UL;
+      }
+   }
+
+   std::cout << " " << name << " (" << bytes / 1E6 << " MB)\n";
+
+#if BENCHMARK_ISTREAM_SOLUTION
+   benchmark( "istream               : ", bytes, steps, [path]() {
+      std::ifstream in( path, std::ios::binary );
+      return static_cast<double>( ranges::accumulate( ranges::istream<T>( in ), T{} ) );
+   } );
+#endif
+
+#if BENCHMARK_NUMERIC_ISTREAM_SOLUTION
+   benchmark( "numeric_istream       : ", bytes, steps, [path]() {
+      std::ifstream in( path, std::ios::binary );
+      return static_cast<double>( ranges::accumulate( ranges::numeric_istream<T>( in ), T{} ) );
+   } );
+#endif
+
+#if BENCHMARK_NUMERIC_ISTREAM_MMAP_SOLUTION
+   benchmark( "numeric_istream (mmap): ", bytes, steps, [path]() {
+      return static_cast<double>( ranges::accumulate( ranges::numeric_istream<T>( path ), T{} ) );
+   } );
+#endif
+
+   std::cout << "\n";
+
+   std::remove( path );
+}
+
+
+// Reads a value that fills the whole read buffer of 'numeric_istream', followed by two more values.
+// Returns false in case a value is lost or the end of the stream is reported too early.
+bool checkBufferSizedValue()
+{
+   const size_t length( ranges::detail::numeric_istream_chunk_size() );
+   std::istringstream in( std::string( length-1UL, '0' ) + "7 42 5" );
+
+   auto numbers( ranges::numeric_istream<long>( in ) );
+   const bool early( in.eof() );
+   const long sum( ranges::accumulate( numbers, 0L ) );
+
+   return !early && sum == 54L && in.eof();
+}
+
+
+int main()
+{
+   const char* const path( "Ranges_v3_NumericIstream_Benchmark.txt" );
+   const size_t N    ( 2000000UL );
+   const size_t steps( 5UL );
+
+   std::mt19937 rng{};
+
+   std::cout << "\n";
+
+   if( !checkBufferSizedValue() ) {
+      std::cout << " numeric_istream failed on a value as long as its read buffer!\n\n";
+   }
+
+   std::uniform_int_distribution<long> integers( -1000000L, 1000000L );
+   benchmark<long>( "Integers", path, N, steps, [&]() { return integers( rng ); } );
+
+   std::uniform_real_distribution<double> reals( -1000.0, 1000.0 );
+   benchmark<double>( "Floating point numbers", path, N, steps, [&]() { return reals( rng ); } );
+
+   return EXIT_SUCCESS;
+}
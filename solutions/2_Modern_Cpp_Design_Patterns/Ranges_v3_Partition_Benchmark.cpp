@@ -0,0 +1,171 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Partition_Benchmark.cpp
+* \brief C++ Training - Benchmark for the partition algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark partitions random 32-bit unsigned integers by comparing them to a threshold that
+* selects from 1% to 99% of the values. The classic loop that swaps pairs of misplaced elements
+* from both ends, which branches on every comparison, and 'std::partition' serve as references
+* for 'ranges::partition', which partitions blocks of 64 elements from either end without
+* branching on the predicate (BlockQuicksort). 'std::stable_partition' is the reference for
+* 'ranges::stable_partition', which copies every element both behind the selected elements and
+* into a buffer for the others, and advances one of the two by the result of the predicate.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_GENERIC_PARTITION_SOLUTION 1
+#define BENCHMARK_STD_PARTITION_SOLUTION 1
+#define BENCHMARK_RANGES_PARTITION_SOLUTION 1
+#define BENCHMARK_STD_STABLE_PARTITION_SOLUTION 1
+#define BENCHMARK_RANGES_STABLE_PARTITION_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+#include <range/v3/algorithm/partition.hpp>
+#include <range/v3/algorithm/stable_partition.hpp>
+
+
+using Values = std::vector<std::uint32_t>;
+
+
+struct Below
+{
+   std::uint32_t threshold;
+
+   bool operator()( std::uint32_t v ) const { return v < threshold; }
+};
+
+
+// The bidirectional partition range-v3 used for all ranges before
+template< typename I, typename Pred >
+I genericPartition( I first, I last, Pred pred )
+{
+   while( true )
+   {
+      while( true ) {
+         if( first == last )
+            return first;
+         if( !pred( *first ) )
+            break;
+         ++first;
+      }
+      do {
+         if( first == --last )
+            return first;
+      } while( !pred( *last ) );
+      std::iter_swap( first, last );
+      ++first;
+   }
+}
+
+
+template< typename Partition, typename Check >
+void measure( const char* name, const Values& input, Below pred, size_t steps,
+              Partition partition, Check check )
+{
+   double seconds{};
+
+   for( size_t s=0UL; s<steps; ++s )
+   {
+      Values values( input );
+
+      std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+      start = std::chrono::high_resolution_clock::now();
+
+      const auto point( partition( values, pred ) );
+
+      end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> elapsedTime( end - start );
+      seconds += elapsedTime.count();
+
+      if( s == 0UL && !check( values, point - values.begin() ) ) {
+         std::cout << " " << name << " did not partition the elements!\n";
+      }
+   }
+
+   std::cout << " " << name << seconds / steps << "s\n";
+}
+
+
+void benchmark( const Values& input, unsigned percent, size_t steps )
+{
+   const Below pred{ static_cast<std::uint32_t>(
+      std::numeric_limits<std::uint32_t>::max() / 100U * percent ) };
+
+   Values stable( input );
+   std::stable_partition( stable.begin(), stable.end(), pred );
+   const std::ptrdiff_t selected( std::count_if( input.begin(), input.end(), pred ) );
+
+   auto isPartitioned = [&]( const Values& v, std::ptrdiff_t point ) {
+      return point == selected && std::is_partitioned( v.begin(), v.end(), pred );
+   };
+   auto isStablyPartitioned = [&]( const Values& v, std::ptrdiff_t point ) {
+      return point == selected && v == stable;
+   };
+   (void)isPartitioned;
+   (void)isStablyPartitioned;
+
+   std::cout << "   " << percent << "% selected\n";
+
+#if BENCHMARK_GENERIC_PARTITION_SOLUTION
+   measure( "     generic partition         : ", input, pred, steps,
+            []( Values& v, Below p ){ return genericPartition( v.begin(), v.end(), p ); },
+            isPartitioned );
+#endif
+#if BENCHMARK_STD_PARTITION_SOLUTION
+   measure( "     std::partition            : ", input, pred, steps,
+            []( Values& v, Below p ){ return std::partition( v.begin(), v.end(), p ); },
+            isPartitioned );
+#endif
+#if BENCHMARK_RANGES_PARTITION_SOLUTION
+   measure( "     ranges::partition         : ", input, pred, steps,
+            []( Values& v, Below p ){ return ranges::partition( v, p ); },
+            isPartitioned );
+#endif
+#if BENCHMARK_STD_STABLE_PARTITION_SOLUTION
+   measure( "     std::stable_partition     : ", input, pred, steps,
+            []( Values& v, Below p ){ return std::stable_partition( v.begin(), v.end(), p ); },
+            isStablyPartitioned );
+#endif
+#if BENCHMARK_RANGES_STABLE_PARTITION_SOLUTION
+   measure( "     ranges::stable_partition  : ", input, pred, steps,
+            []( Values& v, Below p ){ return ranges::stable_partition( v, p ); },
+            isStablyPartitioned );
+#endif
+}
+
+
+int main()
+{
+   const size_t N    ( 10000000UL );
+   const size_t steps( 5UL );
+
+   std::mt19937 rng{};
+
+   Values values( N );
+   for( auto& value : values )
+      value = rng();
+
+   std::cout << "\n Random 32-bit unsigned integers (N=" << N << ")\n";
+
+   for( unsigned percent : { 1U, 10U, 25U, 50U, 75U, 90U, 99U } )
+      benchmark( values, percent, steps );
+
+   std::cout << "\n";
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_PriorityQueue_Benchmark.cpp
+* \brief C++ Training - Benchmark for the d-ary heaps of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark measures the throughput of a priority queue of 64-bit keys with 'std::priority_queue'
+* and with 'ranges::priority_queue' on binary, 4-ary and 8-ary heaps. The queue is filled with N
+* random keys and emptied again, and it is used like the event queue of a scheduler: N times the
+* earliest event is taken and a later one is scheduled, which keeps the size of the heap at N. The
+* latter is measured with a pop followed by a push and with 'replace_top'. Heaps of 64K elements
+* fit into the cache, heaps of 4M elements do not.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_PRIORITY_QUEUE_SOLUTION 1
+#define BENCHMARK_BINARY_HEAP_SOLUTION 1
+#define BENCHMARK_4ARY_HEAP_SOLUTION 1
+#define BENCHMARK_8ARY_HEAP_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+#include <range/v3/utility/priority_queue.hpp>
+
+
+using Key = std::uint64_t;
+
+
+// The earliest event is on top
+using StdQueue = std::priority_queue<Key,std::vector<Key>,std::greater<Key>>;
+
+template< size_t Arity >
+using RangesQueue = ranges::priority_queue<Key,Arity,ranges::greater>;
+
+
+template< typename Operation >
+void measure( const char* name, size_t ops, Operation operation )
+{
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   const Key checksum( operation() );
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+
+   std::cout << " " << name << elapsedTime.count() * 1E9 / ops << "ns/op (checksum " << checksum << ")\n";
+}
+
+
+template< typename Queue >
+Key fillAndDrain( const std::vector<Key>& keys )
+{
+   Queue queue;
+   for( Key key : keys )
+      queue.push( key );
+
+   Key checksum{};
+   while( !queue.empty() ) {
+      checksum = checksum * 31U + queue.top();
+      queue.pop();
+   }
+   return checksum;
+}
+
+
+template< typename Queue >
+Key holdPopPush( Queue queue, const std::vector<Key>& delays )
+{
+   Key checksum{};
+   for( Key delay : delays ) {
+      const Key now( queue.top() );
+      checksum = checksum * 31U + now;
+      queue.pop();
+      queue.push( now + delay );
+   }
+   return checksum;
+}
+
+
+template< typename Queue >
+Key holdReplaceTop( Queue queue, const std::vector<Key>& delays )
+{
+   Key checksum{};
+   for( Key delay : delays ) {
+      const Key now( queue.top() );
+      checksum = checksum * 31U + now;
+      queue.replace_top( now + delay );
+   }
+   return checksum;
+}
+
+
+template< typename Queue >
+Queue makeQueue( const std::vector<Key>& keys )
+{
+   Queue queue;
+   for( Key key : keys )
+      queue.push( key );
+   return queue;
+}
+
+
+void benchmark( size_t N )
+{
+   std::mt19937_64 rng{};
+   std::vector<Key> keys( N ), delays( N );
+   for( auto& key : keys )
+      key = rng() >> 16;
+   for( auto& delay : delays )
+      delay = rng() >> 16;
+
+   std::cout << " Fill and drain (N=" << N << ")\n";
+#if BENCHMARK_STD_PRIORITY_QUEUE_SOLUTION
+   measure( "   std::priority_queue : ", 2UL*N, [&]{ return fillAndDrain<StdQueue>( keys ); } );
+#endif
+#if BENCHMARK_BINARY_HEAP_SOLUTION
+   measure( "   binary heap         : ", 2UL*N, [&]{ return fillAndDrain<RangesQueue<2>>( keys ); } );
+#endif
+#if BENCHMARK_4ARY_HEAP_SOLUTION
+   measure( "   4-ary heap          : ", 2UL*N, [&]{ return fillAndDrain<RangesQueue<4>>( keys ); } );
+#endif
+#if BENCHMARK_8ARY_HEAP_SOLUTION
+   measure( "   8-ary heap          : ", 2UL*N, [&]{ return fillAndDrain<RangesQueue<8>>( keys ); } );
+#endif
+
+   std::cout << " Hold, pop and push (N=" << N << ")\n";
+#if BENCHMARK_STD_PRIORITY_QUEUE_SOLUTION
+   {
+      auto queue( makeQueue<StdQueue>( keys ) );
+      measure( "   std::priority_queue : ", N, [&]{ return holdPopPush( std::move( queue ), delays ); } );
+   }
+#endif
+#if BENCHMARK_BINARY_HEAP_SOLUTION
+   {
+      auto queue( makeQueue<RangesQueue<2>>( keys ) );
+      measure( "   binary heap         : ", N, [&]{ return holdPopPush( std::move( queue ), delays ); } );
+   }
+#endif
+#if BENCHMARK_4ARY_HEAP_SOLUTION
+   {
+      auto queue( makeQueue<RangesQueue<4>>( keys ) );
+      measure( "   4-ary heap          : ", N, [&]{ return holdPopPush( std::move( queue ), delays ); } );
+   }
+#endif
+#if BENCHMARK_8ARY_HEAP_SOLUTION
+   {
+      auto queue( makeQueue<RangesQueue<8>>( keys ) );
+      measure( "   8-ary heap          : ", N, [&]{ return holdPopPush( std::move( queue ), delays ); } );
+   }
+#endif
+
+   std::cout << " Hold, replace_top (N=" << N << ")\n";
+#if BENCHMARK_BINARY_HEAP_SOLUTION
+   {
+      auto queue( makeQueue<RangesQueue<2>>( keys ) );
+      measure( "   binary heap         : ", N, [&]{ return holdReplaceTop( std::move( queue ), delays ); } );
+   }
+#endif
+#if BENCHMARK_4ARY_HEAP_SOLUTION
+   {
+      auto queue( makeQueue<RangesQueue<4>>( keys ) );
+      measure( "   4-ary heap          : ", N, [&]{ return holdReplaceTop( std::move( queue ), delays ); } );
+   }
+#endif
+#if BENCHMARK_8ARY_HEAP_SOLUTION
+   {
+      auto queue( makeQueue<RangesQueue<8>>( keys ) );
+      measure( "   8-ary heap          : ", N, [&]{ return holdReplaceTop( std::move( queue ), delays ); } );
+   }
+#endif
+
+   std::cout << "\n";
+}
+
+
+int main()
+{
+   std::cout << "\n";
+
+   benchmark( 1UL << 16 );
+   benchmark( 1UL << 22 );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Random_Benchmark.cpp
+* \brief C++ Training - Benchmark for the random number engines and the shuffle and sample
+*        algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark first compares the raw speed of the Mersenne Twister 'std::mt19937_64' with
+* the 'ranges::xoshiro256pp' and 'ranges::pcg64' engines, drawing numbers one at a time and,
+* for xoshiro256++, in bulk via 'generate()'. It then shuffles and samples a large vector of
+* integers with the standard algorithms and with 'ranges::shuffle' and 'ranges::sample',
+* which draw bounded random integers by Lemire's multiply-shift method instead of through
+* 'std::uniform_int_distribution'. The benchmark reports the number of elements per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_ENGINES 1
+#define BENCHMARK_SHUFFLE 1
+#define BENCHMARK_SAMPLE 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <range/v3/algorithm/sample.hpp>
+#include <range/v3/algorithm/shuffle.hpp>
+#include <range/v3/utility/random.hpp>
+
+
+using Vector = std::vector<int>;
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t elements, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double rate( elements * steps / elapsedTime.count() );
+
+   std::cout << "   " << name << rate * 1E-6 << " M elements/s (checksum " << checksum << ")\n";
+}
+
+
+template< typename Engine >
+size_t drawOneByOne( Engine& engine, std::vector<std::uint64_t>& buffer )
+{
+   for( auto& value : buffer )
+      value = engine();
+   return static_cast<size_t>( buffer.back() & 0xFFFFUL );
+}
+
+
+int main()
+{
+   const size_t N( 1UL << 24 );
+
+   std::cout << "\n";
+
+#if BENCHMARK_ENGINES
+   {
+      std::cout << " Random 64-bit numbers (" << N << " values)\n";
+
+      std::vector<std::uint64_t> buffer( N );
+      std::mt19937_64 mt{ 1U };
+      ranges::xoshiro256pp xoshiro{ 1U };
+      ranges::pcg64 pcg{ 1U };
+
+      benchmark( "std::mt19937_64                 : ", N, 10UL, [&]() {
+         return drawOneByOne( mt, buffer );
+      } );
+      benchmark( "ranges::pcg64                   : ", N, 10UL, [&]() {
+         return drawOneByOne( pcg, buffer );
+      } );
+      benchmark( "ranges::xoshiro256pp            : ", N, 10UL, [&]() {
+         return drawOneByOne( xoshiro, buffer );
+      } );
+      benchmark( "ranges::xoshiro256pp::generate  : ", N, 10UL, [&]() {
+         xoshiro.generate( buffer.data(), buffer.size() );
+         return static_cast<size_t>( buffer.back() & 0xFFFFUL );
+      } );
+
+      std::cout << "\n";
+   }
+#endif
+
+   Vector data( N );
+   std::iota( data.begin(), data.end(), 0 );
+
+#if BENCHMARK_SHUFFLE
+   {
+      std::cout << " Shuffle (" << N << " elements)\n";
+
+      std::mt19937_64 mt{ 2U };
+      ranges::xoshiro256pp xoshiro{ 2U };
+      ranges::pcg64 pcg{ 2U };
+
+      benchmark( "std::shuffle, std::mt19937_64   : ", N, 5UL, [&]() {
+         std::shuffle( data.begin(), data.end(), mt );
+         return static_cast<size_t>( data.front() );
+      } );
+      benchmark( "ranges::shuffle, std::mt19937_64: ", N, 5UL, [&]() {
+         ranges::shuffle( data, mt );
+         return static_cast<size_t>( data.front() );
+      } );
+      benchmark( "ranges::shuffle, pcg64          : ", N, 5UL, [&]() {
+         ranges::shuffle( data, pcg );
+         return static_cast<size_t>( data.front() );
+      } );
+      benchmark( "ranges::shuffle, xoshiro256pp   : ", N, 5UL, [&]() {
+         ranges::shuffle( data, xoshiro );
+         return static_cast<size_t>( data.front() );
+      } );
+
+      std::cout << "\n";
+   }
+#endif
+
+#if BENCHMARK_SAMPLE
+   {
+      const size_t K( 1000UL );
+      std::cout << " Sample (" << K << " of " << N << " elements)\n";
+
+      Vector sample( K );
+      std::mt19937_64 mt{ 3U };
+      ranges::xoshiro256pp xoshiro{ 3U };
+
+      benchmark( "std::sample, std::mt19937_64    : ", N, 5UL, [&]() {
+         std::sample( data.begin(), data.end(), sample.begin(), K, mt );
+         return static_cast<size_t>( sample.back() );
+      } );
+      benchmark( "ranges::sample, std::mt19937_64 : ", N, 5UL, [&]() {
+         ranges::sample( data, sample, mt );
+         return static_cast<size_t>( sample.back() );
+      } );
+      benchmark( "ranges::sample, xoshiro256pp    : ", N, 5UL, [&]() {
+         ranges::sample( data, sample, xoshiro );
+         return static_cast<size_t>( sample.back() );
+      } );
+
+      std::cout << "\n";
+   }
+#endif
+
+   return EXIT_SUCCESS;
+}
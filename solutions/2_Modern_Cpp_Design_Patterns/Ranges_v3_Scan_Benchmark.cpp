@@ -0,0 +1,119 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Scan_Benchmark.cpp
+* \brief C++ Training - Benchmark for the prefix scan algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark computes cumulative sums of 32-bit integers, 64-bit integers and doubles with
+* 'std::partial_sum' and 'std::exclusive_scan', with the sequential 'ranges::partial_sum' and
+* with 'ranges::parallel_partial_sum' and 'ranges::parallel_exclusive_scan'. The parallel
+* algorithms split the range into one chunk per hardware thread and scan the integer chunks
+* with SSE2 in-register scans. The sizes range from cache resident to main memory bound arrays,
+* which shows how the speedup with the number of cores is limited by the memory bandwidth.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_SOLUTION 1
+#define BENCHMARK_RANGES_SOLUTION 1
+#define BENCHMARK_PARALLEL_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include <range/v3/numeric/parallel_scan.hpp>
+#include <range/v3/numeric/partial_sum.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t elements, size_t steps, Operation operation )
+{
+   double checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double rate( elements * steps / elapsedTime.count() );
+
+   std::cout << "   " << name << rate * 1E-6 << " M elements/s (checksum " << checksum << ")\n";
+}
+
+
+template< typename T >
+void benchmark( const char* name, size_t N )
+{
+   std::cout << " " << name << " (N=" << N << ")\n";
+
+   std::mt19937 rng{ 1U };
+   std::uniform_int_distribution<int> dist( -100, 100 );
+   std::vector<T> input( N ), output( N );
+   for( auto& value : input )
+      value = static_cast<T>( dist( rng ) );
+
+   // Hiding the input behind a volatile pointer keeps the compiler from hoisting the loop
+   // invariant scan out of the benchmark loop
+   const std::vector<T>* volatile source( &input );
+   const size_t steps( N < 1000000UL ? 2000UL : 20UL );
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::partial_sum                : ", N, steps, [&]() {
+      std::partial_sum( source->begin(), source->end(), output.begin() );
+      return static_cast<double>( output.back() );
+   } );
+   benchmark( "std::exclusive_scan             : ", N, steps, [&]() {
+      std::exclusive_scan( source->begin(), source->end(), output.begin(), T{} );
+      return static_cast<double>( output.back() );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::partial_sum             : ", N, steps, [&]() {
+      ranges::partial_sum( *source, output.begin() );
+      return static_cast<double>( output.back() );
+   } );
+#endif
+
+#if BENCHMARK_PARALLEL_SOLUTION
+   benchmark( "ranges::parallel_partial_sum    : ", N, steps, [&]() {
+      ranges::parallel_partial_sum( *source, output.begin() );
+      return static_cast<double>( output.back() );
+   } );
+   benchmark( "ranges::parallel_exclusive_scan : ", N, steps, [&]() {
+      ranges::parallel_exclusive_scan( *source, output.begin(), T{} );
+      return static_cast<double>( output.back() );
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+int main()
+{
+   std::cout << "\n Threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+   for( size_t N : { 100000UL, 10000000UL, 100000000UL } )
+   {
+      benchmark<std::int32_t>( "32-bit integers", N );
+      benchmark<std::int64_t>( "64-bit integers", N );
+      benchmark<double>( "Doubles", N );
+   }
+
+   return EXIT_SUCCESS;
+}
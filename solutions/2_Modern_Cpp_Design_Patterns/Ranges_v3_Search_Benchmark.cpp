@@ -0,0 +1,152 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Search_Benchmark.cpp
+* \brief C++ Training - Benchmark for the search algorithm of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark searches a text of random words for patterns of 8 bytes up to 4 kilobytes that
+* occur only close to its end. 'ranges::search' searches contiguous ranges of bytes with an SSE2
+* filter on the first and last byte of short patterns and with Horspool's algorithm for long
+* patterns, both guarded by the linear two-way algorithm. Passing a lambda as comparator selects
+* the generic element by element search. The references are 'std::search' and the
+* 'std::boyer_moore_horspool_searcher'. The benchmark reports the searched bytes per second.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_SOLUTION 1
+#define BENCHMARK_HORSPOOL_SOLUTION 1
+#define BENCHMARK_GENERIC_SOLUTION 1
+#define BENCHMARK_RANGES_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <range/v3/algorithm/search.hpp>
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double rate( bytes * steps / elapsedTime.count() );
+
+   std::cout << "   " << name << rate * 1E-9 << " GB/s (position " << checksum / steps << ")\n";
+}
+
+
+std::string randomText( size_t size, unsigned int seed )
+{
+   std::mt19937 rng{ seed };
+   std::uniform_int_distribution<int> length( 1, 10 );
+   std::uniform_int_distribution<int> letter( 'a', 'z' );
+
+   std::vector<std::string> words( 5000 );
+   for( auto& word : words ) {
+      word.resize( static_cast<size_t>( length( rng ) ) );
+      for( auto& c : word )
+         c = static_cast<char>( letter( rng ) );
+   }
+
+   std::uniform_int_distribution<size_t> pick( 0UL, words.size() - 1UL );
+   std::string text;
+   text.reserve( size + 16UL );
+   while( text.size() < size ) {
+      text += words[pick( rng )];
+      text += ' ';
+   }
+   return text;
+}
+
+
+void benchmark( const std::string& text, const std::string& pattern, size_t steps )
+{
+   std::cout << " Pattern of " << pattern.size() << " bytes (text of " << text.size() << " bytes)\n";
+
+   // Hiding the text behind a volatile pointer keeps the compiler from hoisting the loop
+   // invariant search out of the benchmark loop
+   const std::string* volatile source( &text );
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::search                       : ", text.size(), steps, [&]() {
+      return static_cast<size_t>( std::search( source->begin(), source->end(),
+                                               pattern.begin(), pattern.end() )
+                                  - source->begin() );
+   } );
+#endif
+
+#if BENCHMARK_HORSPOOL_SOLUTION
+   benchmark( "std::boyer_moore_horspool_searcher: ", text.size(), steps, [&]() {
+      const std::boyer_moore_horspool_searcher<std::string::const_iterator>
+         searcher( pattern.begin(), pattern.end() );
+      return static_cast<size_t>( std::search( source->begin(), source->end(), searcher )
+                                  - source->begin() );
+   } );
+#endif
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "ranges::search (generic)          : ", text.size(), steps, [&]() {
+      auto found = ranges::search( *source, pattern, []( char a, char b ){ return a == b; } );
+      return static_cast<size_t>( found.begin() - source->begin() );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::search                    : ", text.size(), steps, [&]() {
+      auto found = ranges::search( *source, pattern );
+      return static_cast<size_t>( found.begin() - source->begin() );
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+int main()
+{
+   const size_t size( 64UL * 1024UL * 1024UL );
+
+   std::cout << "\n";
+
+   for( size_t length : { 8UL, 32UL, 256UL, 4096UL } )
+   {
+      // A pattern taken from the end of the text with its middle byte in upper case, which
+      // makes it occur only there
+      std::string text( randomText( size, 1U ) );
+      const size_t pos( text.size() - length - 100UL );
+      text[pos + length / 2UL] = 'X';
+      const std::string pattern( text.substr( pos, length ) );
+      benchmark( text, pattern, 5UL );
+   }
+
+   {
+      // In a repetitive text every window matches the last byte and half of the pattern,
+      // which shows the worst case of the byte filters
+      const std::string repetitive( size / 16UL, 'a' );
+      const std::string pattern( std::string( 500UL, 'a' ) + "b" + std::string( 500UL, 'a' ) );
+      std::cout << " Worst case:";
+      benchmark( repetitive, pattern, 1UL );
+   }
+
+   return EXIT_SUCCESS;
+}
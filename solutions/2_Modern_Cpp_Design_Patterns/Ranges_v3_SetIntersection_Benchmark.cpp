@@ -0,0 +1,128 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_SetIntersection_Benchmark.cpp
+* \brief C++ Training - Benchmark for the set_intersection algorithm of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark intersects sorted lists of integers as in the query of an inverted index: a
+* short list with a long one, where 'ranges::set_intersection' gallops through the long list,
+* and two lists of similar length, where it compares blocks of four elements with SSE2. The
+* reference is 'std::set_intersection', which merges the lists element by element. The
+* benchmark reports the time per intersection.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_SOLUTION 1
+#define BENCHMARK_RANGES_SOLUTION 1
+#define BENCHMARK_VIEW_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <range/v3/algorithm/set_algorithm.hpp>
+#include <range/v3/view/set_algorithm.hpp>
+
+
+using List = std::vector<int>;
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << "   " << name << seconds * 1E3 << " ms (checksum " << checksum << ")\n";
+}
+
+
+void benchmark( const char* name, const List& list1, const List& list2, size_t steps )
+{
+   std::cout << " " << name << " (" << list1.size() << " and " << list2.size() << " elements)\n";
+
+   // Hiding the lists behind volatile pointers keeps the compiler from hoisting the loop
+   // invariant intersection out of the benchmark loop
+   const List* volatile source1( &list1 );
+   const List* volatile source2( &list2 );
+   List result( std::min( list1.size(), list2.size() ) );
+
+#if BENCHMARK_STD_SOLUTION
+   benchmark( "std::set_intersection    : ", steps, [&]() {
+      return static_cast<size_t>( std::set_intersection( source1->begin(), source1->end(),
+                                                         source2->begin(), source2->end(),
+                                                         result.begin() ) - result.begin() );
+   } );
+#endif
+
+#if BENCHMARK_RANGES_SOLUTION
+   benchmark( "ranges::set_intersection : ", steps, [&]() {
+      return static_cast<size_t>( ranges::set_intersection( *source1, *source2, result.begin() )
+                                  - result.begin() );
+   } );
+#endif
+
+#if BENCHMARK_VIEW_SOLUTION
+   benchmark( "views::set_intersection  : ", steps, [&]() {
+      size_t count{};
+      for( int i : ranges::views::set_intersection( *source1, *source2 ) )
+         count += static_cast<size_t>( i ) & 1UL;
+      return count;
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+List sortedList( size_t size, int range, unsigned int seed )
+{
+   std::mt19937 rng{ seed };
+   std::uniform_int_distribution<int> dist( 0, range );
+   List list( size );
+   std::generate( list.begin(), list.end(), [&]() { return dist( rng ); } );
+   std::sort( list.begin(), list.end() );
+   return list;
+}
+
+
+int main()
+{
+   const int range( 200000000 );
+
+   const List huge ( sortedList( 20000000UL, range, 1U ) );
+   const List tiny ( sortedList( 100UL, range, 2U ) );
+   const List small( sortedList( 20000UL, range, 3U ) );
+
+   std::cout << "\n";
+   benchmark( "Short list and long list", tiny, huge, 20UL );
+   benchmark( "Medium list and long list", small, huge, 20UL );
+
+   const List sparse1( sortedList( 2000000UL, range, 4U ) );
+   const List sparse2( sortedList( 2000000UL, range, 5U ) );
+   benchmark( "Similar lists, few common elements", sparse1, sparse2, 20UL );
+
+   const List dense1( sortedList( 2000000UL, 4000000, 6U ) );
+   const List dense2( sortedList( 2000000UL, 4000000, 7U ) );
+   benchmark( "Similar lists, many common elements", dense1, dense2, 20UL );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Sort_Benchmark.cpp
+* \brief C++ Training - Benchmark for the sort algorithms of the range-v3 library
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark sorts 64-bit integers, doubles and records (sorted by a data member) with the
+* introsort of 'std::sort', with the pattern-defeating quicksort of 'ranges::sort', with the radix
+* sort that 'ranges::sort' picks for arithmetic keys compared with 'less', and with the parallel
+* merge sort of 'ranges::parallel_sort'. Since the radix sort is only selected for 'less' and
+* 'greater', the quicksort is measured by passing an equivalent lambda as comparator. Sorted and
+* reverse sorted inputs show the linear time detection of presorted ranges.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_INTROSORT_SOLUTION 1
+#define BENCHMARK_PDQSORT_SOLUTION 1
+#define BENCHMARK_RADIX_SORT_SOLUTION 1
+#define BENCHMARK_PARALLEL_SORT_SOLUTION 1
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <range/v3/algorithm/is_sorted.hpp>
+#include <range/v3/algorithm/parallel_sort.hpp>
+#include <range/v3/algorithm/sort.hpp>
+
+
+struct Record
+{
+   std::uint64_t key;
+   std::uint64_t payload;
+};
+
+
+template< typename T, typename Sort >
+void measure( const char* name, const std::vector<T>& input, size_t steps, Sort sort )
+{
+   double seconds{};
+
+   for( size_t s=0UL; s<steps; ++s )
+   {
+      std::vector<T> values( input );
+
+      std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+      start = std::chrono::high_resolution_clock::now();
+
+      sort( values );
+
+      end = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double> elapsedTime( end - start );
+      seconds += elapsedTime.count();
+
+      if( s == 0UL && !sort.isSorted( values ) ) {
+         std::cout << " " << name << " did not sort the input!\n";
+      }
+   }
+
+   std::cout << " " << name << seconds / steps << "s\n";
+}
+
+
+template< typename Less, typename Proj >
+struct Sorter
+{
+   template< typename T >
+   bool isSorted( const std::vector<T>& values ) const
+   {
+      return ranges::is_sorted( values, Less{}, proj );
+   }
+
+   Proj proj;
+};
+
+
+template< typename Less, typename Proj >
+struct Introsort : Sorter<Less,Proj>
+{
+   template< typename T >
+   void operator()( std::vector<T>& values ) const
+   {
+      const auto& proj( this->proj );
+      std::sort( values.begin(), values.end(), [&proj]( const T& a, const T& b ){
+         return Less{}( ranges::invoke( proj, a ), ranges::invoke( proj, b ) );
+      } );
+   }
+};
+
+
+template< typename Less, typename Proj >
+struct Pdqsort : Sorter<Less,Proj>
+{
+   template< typename T >
+   void operator()( std::vector<T>& values ) const
+   {
+      // A lambda comparator is not recognized as 'less', so 'ranges::sort' uses the quicksort
+      ranges::sort( values, []( const auto& a, const auto& b ){ return Less{}( a, b ); }, this->proj );
+   }
+};
+
+
+template< typename Less, typename Proj >
+struct RadixSort : Sorter<Less,Proj>
+{
+   template< typename T >
+   void operator()( std::vector<T>& values ) const
+   {
+      ranges::sort( values, Less{}, this->proj );
+   }
+};
+
+
+template< typename Less, typename Proj >
+struct ParallelSort : Sorter<Less,Proj>
+{
+   template< typename T >
+   void operator()( std::vector<T>& values ) const
+   {
+      ranges::parallel_sort( values, []( const auto& a, const auto& b ){ return Less{}( a, b ); }, this->proj );
+   }
+};
+
+
+template< typename T, typename Proj >
+void benchmark( const char* name, const std::vector<T>& input, size_t steps, Proj proj )
+{
+   using Less = ranges::less;
+
+   std::cout << " " << name << " (N=" << input.size() << ")\n";
+
+#if BENCHMARK_INTROSORT_SOLUTION
+   measure( "   introsort     : ", input, steps, Introsort<Less,Proj>{ proj } );
+#endif
+#if BENCHMARK_PDQSORT_SOLUTION
+   measure( "   pdqsort       : ", input, steps, Pdqsort<Less,Proj>{ proj } );
+#endif
+#if BENCHMARK_RADIX_SORT_SOLUTION
+   measure( "   radix sort    : ", input, steps, RadixSort<Less,Proj>{ proj } );
+#endif
+#if BENCHMARK_PARALLEL_SORT_SOLUTION
+   measure( "   parallel sort : ", input, steps, ParallelSort<Less,Proj>{ proj } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+// Runs the parallel merge sort on strings with a fixed number of threads, independent of the
+// number of hardware threads, and compares the result to the one of 'std::sort'
+void checkParallelSort( std::mt19937_64& rng )
+{
+   std::vector<std::string> input( 100000UL );
+   for( auto& s : input )
+      s = std::to_string( rng() % 10000UL ) + std::string( rng() % 32UL, '-' );
+
+   std::vector<std::string> expected( input );
+   std::sort( expected.begin(), expected.end() );
+
+   for( size_t threads : { 2UL, 3UL, 4UL, 7UL } )
+   {
+      std::vector<std::string> values( input );
+      ranges::less pred{};
+      ranges::identity proj{};
+      ranges::detail::parallel_sort_( values.begin(), static_cast<std::ptrdiff_t>( values.size() ),
+                                      threads, pred, proj );
+
+      if( !std::is_sorted( values.begin(), values.end() ) ) {
+         std::cout << " parallel sort on " << threads << " threads did not sort the strings!\n";
+      }
+      else if( values != expected ) {
+         std::cout << " parallel sort on " << threads << " threads lost or duplicated strings!\n";
+      }
+   }
+}
+
+
+int main()
+{
+   const size_t N    ( 10000000UL );
+   const size_t steps( 3UL );
+
+   std::mt19937_64 rng{};
+
+   std::cout << "\n Threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+   checkParallelSort( rng );
+
+   {
+      std::vector<std::uint64_t> keys( N );
+      for( auto& key : keys )
+         key = rng();
+      benchmark( "64-bit unsigned integers", keys, steps, ranges::identity{} );
+   }
+
+   {
+      std::vector<std::uint64_t> keys( N );
+      for( auto& key : keys )
+         key = rng();
+      std::sort( keys.begin(), keys.end() );
+      benchmark( "Sorted 64-bit unsigned integers", keys, steps, ranges::identity{} );
+      std::reverse( keys.begin(), keys.end() );
+      benchmark( "Reverse sorted 64-bit unsigned integers", keys, steps, ranges::identity{} );
+   }
+
+   {
+      std::normal_distribution<double> dist( 0.0, 1000.0 );
+      std::vector<double> keys( N );
+      for( auto& key : keys )
+         key = dist( rng );
+      benchmark( "Doubles", keys, steps, ranges::identity{} );
+   }
+
+   {
+      std::vector<Record> records( N );
+      for( auto& record : records )
+         record = Record{ rng(), rng() };
+      benchmark( "Records by 64-bit key", records, steps, &Record::key );
+   }
+
+   return EXIT_SUCCESS;
+}
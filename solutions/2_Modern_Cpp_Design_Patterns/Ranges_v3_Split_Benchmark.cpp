@@ -0,0 +1,164 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Split_Benchmark.cpp
+* \brief C++ Training - Benchmark for the split view of the range-v3 library on CSV-like data
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark splits CSV-like text at a single-character (',') and at a two-character (", ")
+* delimiter. It counts the fields ("split") and additionally sums up their characters ("split +
+* read"). On a 'std::string' the split view finds the delimiters with 'memchr'/'memcmp'; on
+* 'views::const_' of the same string, which is not a contiguous range, it compares the pattern
+* element by element. A loop with 'std::string::find' serves as reference. The benchmark reports
+* the throughput in MB/s.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_GENERIC_SOLUTION 1
+#define BENCHMARK_CONTIGUOUS_SOLUTION 1
+#define BENCHMARK_FIND_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <range/v3/view/const.hpp>
+#include <range/v3/view/split.hpp>
+
+
+template< bool Read, typename Rng, typename Pattern >
+size_t split( Rng&& rng, Pattern pattern )
+{
+   size_t checksum{};
+   auto fields( rng | ranges::views::split( pattern ) );
+   for( auto field=fields.begin(); field!=fields.end(); ++field ) {
+      checksum += 1UL;
+      if( Read ) {
+         const auto chars( *field );
+         for( auto it=chars.begin(); it!=chars.end(); ++it )
+            checksum += static_cast<unsigned char>( *it );
+      }
+   }
+   return checksum;
+}
+
+
+template< bool Read >
+size_t find( const std::string& text, std::string_view pattern )
+{
+   size_t checksum{};
+   size_t pos{};
+   while( pos != text.size() ) {
+      size_t next = text.find( pattern.data(), pos, pattern.size() );
+      if( next == std::string::npos )
+         next = text.size();
+      checksum += 1UL;
+      if( Read ) {
+         for( const char* p=text.data()+pos; p!=text.data()+next; ++p )
+            checksum += static_cast<unsigned char>( *p );
+      }
+      pos = ( next == text.size() ) ? next : next + pattern.size();
+   }
+   return checksum;
+}
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << "   " << name << bytes / seconds / 1E6 << " MB/s (checksum " << checksum << ")\n";
+}
+
+
+template< typename Pattern >
+void benchmark( const char* name, const std::string& text, Pattern pattern, std::string_view delimiter,
+                size_t steps )
+{
+   std::cout << " " << name << "\n";
+
+   // Hiding the text behind a volatile pointer keeps the compiler from hoisting the loop
+   // invariant splitting out of the benchmark loop
+   const std::string* volatile source( &text );
+
+#if BENCHMARK_GENERIC_SOLUTION
+   benchmark( "generic     (split)       : ", text.size(), steps, [&]() {
+      return split<false>( *source | ranges::views::const_, pattern );
+   } );
+   benchmark( "generic     (split + read): ", text.size(), steps, [&]() {
+      return split<true>( *source | ranges::views::const_, pattern );
+   } );
+#endif
+
+#if BENCHMARK_CONTIGUOUS_SOLUTION
+   benchmark( "contiguous  (split)       : ", text.size(), steps, [&]() {
+      return split<false>( *source, pattern );
+   } );
+   benchmark( "contiguous  (split + read): ", text.size(), steps, [&]() {
+      return split<true>( *source, pattern );
+   } );
+#endif
+
+#if BENCHMARK_FIND_SOLUTION
+   benchmark( "string find (split)       : ", text.size(), steps, [&]() {
+      return find<false>( *source, delimiter );
+   } );
+   benchmark( "string find (split + read): ", text.size(), steps, [&]() {
+      return find<true>( *source, delimiter );
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+std::string csv( size_t rows, const char* separator )
+{
+   std::mt19937 rng{};
+   std::uniform_int_distribution<size_t> length( 1UL, 24UL );
+   std::string text;
+   for( size_t r=0UL; r<rows; ++r ) {
+      for( size_t c=0UL; c<8UL; ++c ) {
+         if( c != 0UL )
+            text += separator;
+         text.append( length( rng ), 'a' + static_cast<char>( c ) );
+      }
+      text += separator;
+   }
+   return text;
+}
+
+
+int main()
+{
+   const size_t rows ( 100000UL );
+   const size_t steps( 20UL );
+
+   const std::string text1( csv( rows, "," ) );
+   std::cout << "\n Text size: " << text1.size() / 1E6 << " MB\n\n";
+   benchmark( "Single-character delimiter ','", text1, ',', ",", steps );
+
+   const std::string text2( csv( rows, ", " ) );
+   benchmark( "Two-character delimiter \", \"", text2, std::string_view( ", " ), ", ", steps );
+
+   return EXIT_SUCCESS;
+}
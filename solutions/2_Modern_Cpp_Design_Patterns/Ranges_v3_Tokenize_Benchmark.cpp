@@ -0,0 +1,114 @@
+/**************************************************************************************************
+*
+* \file Ranges_v3_Tokenize_Benchmark.cpp
+* \brief C++ Training - Benchmark for the regex backends of the tokenize view of range-v3
+*
+* Copyright (C) 2015-2020 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The benchmark tokenizes a log-like text with 'views::tokenize', once with a 'std::regex' and
+* once with a 'ranges::dfa_regex', which compiles the pattern into a DFA and matches without
+* allocation. It extracts words, splits at separators (sub-match -1) and extracts numbers, and
+* reports the throughput in MB/s.
+*
+**************************************************************************************************/
+
+#define BENCHMARK_STD_REGEX_SOLUTION 1
+#define BENCHMARK_DFA_REGEX_SOLUTION 1
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <range/v3/utility/dfa_regex.hpp>
+#include <range/v3/view/tokenize.hpp>
+
+
+template< typename Regex >
+size_t tokenize( const std::string& text, const Regex& regex, int sub )
+{
+   size_t checksum{};
+   for( auto&& match : text | ranges::views::tokenize( regex, sub ) )
+      checksum += static_cast<size_t>( match.length() ) + 1UL;
+   return checksum;
+}
+
+
+template< typename Operation >
+void benchmark( const char* name, size_t bytes, size_t steps, Operation operation )
+{
+   size_t checksum{};
+
+   std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+   start = std::chrono::high_resolution_clock::now();
+
+   for( size_t s=0UL; s<steps; ++s ) {
+      checksum += operation();
+   }
+
+   end = std::chrono::high_resolution_clock::now();
+   const std::chrono::duration<double> elapsedTime( end - start );
+   const double seconds( elapsedTime.count() / steps );
+
+   std::cout << "   " << name << bytes / seconds / 1E6 << " MB/s (checksum " << checksum << ")\n";
+}
+
+
+void benchmark( const char* name, const char* pattern, int sub, const std::string& text, size_t steps )
+{
+   std::cout << " " << name << " /" << pattern << "/\n";
+
+#if BENCHMARK_STD_REGEX_SOLUTION
+   const std::regex regex( pattern );
+   benchmark( "std::regex       : ", text.size(), steps, [&]() {
+      return tokenize( text, regex, sub );
+   } );
+#endif
+
+#if BENCHMARK_DFA_REGEX_SOLUTION
+   const ranges::dfa_regex dfa( pattern );
+   benchmark( "ranges::dfa_regex: ", text.size(), steps, [&]() {
+      return tokenize( text, dfa, sub );
+   } );
+#endif
+
+   std::cout << "\n";
+}
+
+
+int main()
+{
+   const size_t lines( 20000UL );
+   const size_t steps( 5UL );
+
+   // Creating a log-like text of about 1.5 MB
+   std::string text;
+   {
+      const char* const levels[] = { "INFO", "WARN", "DEBUG", "ERROR" };
+      const char* const words[] = { "request", "served", "in", "cache", "miss", "user", "timeout" };
+      std::mt19937 rng{};
+      std::uniform_int_distribution<size_t> pick( 0UL, 1000000UL );
+      for( size_t i=0UL; i<lines; ++i ) {
+         text += "2020-03-" + std::to_string( 10UL + i % 20UL ) + " " + levels[pick( rng ) % 4UL] + " ";
+         for( size_t w=0UL; w<8UL; ++w ) {
+            text += words[pick( rng ) % 7UL];
+            text += ( w % 3UL == 2UL ) ? ", " : " ";
+         }
+         text += std::to_string( pick( rng ) ) + "." + std::to_string( pick( rng ) % 1000UL ) + "ms\n";
+      }
+   }
+
+   std::cout << "\n Text size: " << text.size() / 1E6 << " MB\n\n";
+
+   benchmark( "Words", "\\w+", 0, text, steps );
+   benchmark( "Split", "[ ,]+", -1, text, steps );
+   benchmark( "Numbers", "\\d+(?:\\.\\d+)?", 0, text, steps );
+
+   return EXIT_SUCCESS;
+}
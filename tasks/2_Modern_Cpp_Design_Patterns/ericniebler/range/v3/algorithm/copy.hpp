@@ -14,11 +14,15 @@
 #define RANGES_V3_ALGORITHM_COPY_HPP
 
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/algorithm/result_types.hpp>
+#include <range/v3/detail/copy_bytes.hpp>
+#include <range/v3/detail/segmented_iteration.hpp>
 #include <range/v3/iterator/concepts.hpp>
 #include <range/v3/iterator/traits.hpp>
 #include <range/v3/range/access.hpp>
@@ -35,6 +39,62 @@ namespace ranges
     template<typename I, typename O>
     using copy_result = detail::in_out_result<I, O>;
 
+    /// \cond
+    namespace detail
+    {
+        template<typename I, typename S, typename O>
+        constexpr copy_result<I, O> copy_(I first, S last, O out, std::false_type)
+        {
+            for(; first != last; ++first, ++out)
+                *out = *first;
+            return {first, out};
+        }
+
+        // Contiguous ranges of trivially copyable elements are copied with memmove,
+        // except in constant expressions.
+        template<typename I, typename S, typename O>
+        constexpr copy_result<I, O> copy_(I first, S last, O out, std::true_type)
+        {
+#ifdef RANGES_IS_CONSTANT_EVALUATED
+            if(!RANGES_IS_CONSTANT_EVALUATED())
+            {
+                auto const n = last - first;
+                if(n != 0)
+                    detail::copy_bytes(
+                        std::addressof(*first), n, std::addressof(*out));
+                return {first + n, out + n};
+            }
+#endif
+            return detail::copy_(
+                std::move(first), std::move(last), std::move(out), std::false_type{});
+        }
+
+        template<typename Rng, typename O>
+        constexpr copy_result<iterator_t<Rng>, O> copy_range_(Rng & rng, O out,
+                                                              std::false_type)
+        {
+            return detail::copy_(
+                ranges::begin(rng),
+                ranges::end(rng),
+                std::move(out),
+                detail::copy_bytes_<iterator_t<Rng>, sentinel_t<Rng>, O, false>{});
+        }
+        template<typename Rng, typename O>
+        copy_result<iterator_t<Rng>, O> copy_range_(Rng & rng, O out, std::true_type)
+        {
+            auto leaf = [&out](auto & seg) {
+                auto first = ranges::begin(seg);
+                auto const last = ranges::end(seg);
+                for(; first != last; ++first, ++out)
+                    *out = static_cast<range_reference_t<Rng>>(*first);
+                return first;
+            };
+            auto last = detail::for_each_leaf_segment(rng, leaf);
+            return {last, out};
+        }
+    } // namespace detail
+    /// \endcond
+
     RANGES_HIDDEN_DETAIL(namespace _copy CPP_PP_LBRACE())
     RANGES_BEGIN_NIEBLOID(copy)
 
@@ -45,10 +105,11 @@ namespace ranges
                 requires input_iterator<I> && sentinel_for<S, I> &&
                 weakly_incrementable<O> && indirectly_copyable<I, O>)
         {
-            for(; first != last; ++first, ++out)
-                *out = *first;
-            return {first, out};
-        } // namespace ranges
+            return detail::copy_(std::move(first),
+                                 std::move(last),
+                                 std::move(out),
+                                 detail::copy_bytes_<I, S, O, false>{});
+        }
 
         /// \overload
         template<typename Rng, typename O>
@@ -57,7 +118,8 @@ namespace ranges
                 requires input_range<Rng> && weakly_incrementable<O> &&
                 indirectly_copyable<iterator_t<Rng>, O>)
         {
-            return (*this)(begin(rng), end(rng), std::move(out));
+            return detail::copy_range_(
+                rng, std::move(out), detail::has_segmented_iteration<Rng>{});
         }
 
     RANGES_END_NIEBLOID(copy)
@@ -13,10 +13,15 @@
 #ifndef RANGES_V3_ALGORITHM_EQUAL_HPP
 #define RANGES_V3_ALGORITHM_EQUAL_HPP
 
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/mismatch.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -46,6 +51,44 @@ namespace ranges
                     return false;
             return begin0 == end0 && begin1 == end1;
         }
+
+        template<typename I0, typename S0, typename I1, typename S1, typename D,
+                 typename C, typename P0, typename P1>
+        constexpr bool equal_sized_(I0 begin0, S0 end0, I1 begin1, S1 end1, D, C & pred,
+                                    P0 & proj0, P1 & proj1, std::false_type)
+        {
+            return detail::equal_nocheck(std::move(begin0),
+                                         std::move(end0),
+                                         std::move(begin1),
+                                         std::move(end1),
+                                         pred,
+                                         proj0,
+                                         proj1);
+        }
+
+        // Contiguous ranges of integers, enums or pointers of equal length n compared
+        // with equal_to are compared with memcmp, except in constant expressions.
+        template<typename I0, typename S0, typename I1, typename S1, typename D,
+                 typename C, typename P0, typename P1>
+        constexpr bool equal_sized_(I0 begin0, S0 end0, I1 begin1, S1 end1, D n,
+                                    C & pred, P0 & proj0, P1 & proj1, std::true_type)
+        {
+#ifdef RANGES_IS_CONSTANT_EVALUATED
+            if(!RANGES_IS_CONSTANT_EVALUATED())
+                return n == 0 ||
+                       std::memcmp(std::addressof(*begin0),
+                                   std::addressof(*begin1),
+                                   static_cast<std::size_t>(n) *
+                                       sizeof(iter_value_t<I0>)) == 0;
+#endif
+            return detail::equal_nocheck(std::move(begin0),
+                                         std::move(end0),
+                                         std::move(begin1),
+                                         std::move(end1),
+                                         pred,
+                                         proj0,
+                                         proj1);
+        }
     } // namespace detail
     /// \endcond
 
@@ -99,8 +142,21 @@ namespace ranges
         {
             if(RANGES_CONSTEXPR_IF(sized_sentinel_for<S0, I0> &&
                                    sized_sentinel_for<S1, I1>))
-                if(distance(begin0, end0) != distance(begin1, end1))
+            {
+                auto const n = distance(begin0, end0);
+                if(n != distance(begin1, end1))
                     return false;
+                return detail::equal_sized_(
+                    std::move(begin0),
+                    std::move(end0),
+                    std::move(begin1),
+                    std::move(end1),
+                    n,
+                    pred,
+                    proj0,
+                    proj1,
+                    detail::mismatch_bytes_<I0, S0, I1, S1, C, P0, P1>{});
+            }
             return detail::equal_nocheck(std::move(begin0),
                                          std::move(end0),
                                          std::move(begin1),
@@ -152,8 +208,23 @@ namespace ranges
                 indirectly_comparable<iterator_t<Rng0>, iterator_t<Rng1>, C, P0, P1>)
         {
             if(RANGES_CONSTEXPR_IF(sized_range<Rng0> && sized_range<Rng1>))
-                if(distance(rng0) != distance(rng1))
+            {
+                auto const n = distance(rng0);
+                if(n != distance(rng1))
                     return false;
+                return detail::equal_sized_(
+                    begin(rng0),
+                    end(rng0),
+                    begin(rng1),
+                    end(rng1),
+                    n,
+                    pred,
+                    proj0,
+                    proj1,
+                    detail::mismatch_bytes_<iterator_t<Rng0>, sentinel_t<Rng0>,
+                                            iterator_t<Rng1>, sentinel_t<Rng1>, C, P0,
+                                            P1>{});
+            }
             return detail::equal_nocheck(begin(rng0),
                                          end(rng0),
                                          begin(rng1),
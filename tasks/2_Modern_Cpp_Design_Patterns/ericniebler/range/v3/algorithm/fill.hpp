@@ -13,8 +13,13 @@
 #ifndef RANGES_V3_ALGORITHM_FILL_HPP
 #define RANGES_V3_ALGORITHM_FILL_HPP
 
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/copy_bytes.hpp>
 #include <range/v3/iterator/concepts.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/range/concepts.hpp>
@@ -24,6 +29,30 @@
 
 namespace ranges
 {
+    /// \cond
+    namespace detail
+    {
+        template<typename O, typename S, typename V>
+        O fill_(O first, S last, V const & val, std::false_type)
+        {
+            for(; first != last; ++first)
+                *first = val;
+            return first;
+        }
+
+        // Contiguous ranges of scalars are filled with detail::fill_bytes.
+        template<typename O, typename S, typename V>
+        O fill_(O first, S last, V const & val, std::true_type)
+        {
+            auto const n = last - first;
+            if(n != 0)
+                detail::fill_bytes(
+                    std::addressof(*first), n, static_cast<iter_value_t<O>>(val));
+            return first + n;
+        }
+    } // namespace detail
+    /// \endcond
+
     /// \addtogroup group-algorithms
     /// @{
     RANGES_BEGIN_NIEBLOID(fill)
@@ -34,9 +63,8 @@ namespace ranges
             ->CPP_ret(O)(                                              //
                 requires output_iterator<O, V const &> && sentinel_for<S, O>)
         {
-            for(; first != last; ++first)
-                *first = val;
-            return first;
+            return detail::fill_(
+                std::move(first), std::move(last), val, detail::fill_bytes_<O, S, V>{});
         }
 
         /// \overload
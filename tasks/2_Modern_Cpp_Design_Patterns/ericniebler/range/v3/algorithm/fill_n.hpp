@@ -13,10 +13,13 @@
 #ifndef RANGES_V3_ALGORITHM_FILL_N_HPP
 #define RANGES_V3_ALGORITHM_FILL_N_HPP
 
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/copy_bytes.hpp>
 #include <range/v3/iterator/concepts.hpp>
 #include <range/v3/iterator/operations.hpp>
 #include <range/v3/range/access.hpp>
@@ -26,6 +29,31 @@
 
 namespace ranges
 {
+    /// \cond
+    namespace detail
+    {
+        template<typename O, typename V>
+        O fill_n_(O first, iter_difference_t<O> n, V const & val, std::false_type)
+        {
+            auto norig = n;
+            auto b = uncounted(first);
+            for(; n != 0; ++b, --n)
+                *b = val;
+            return recounted(first, b, norig);
+        }
+
+        // Contiguous ranges of scalars are filled with detail::fill_bytes.
+        template<typename O, typename V>
+        O fill_n_(O first, iter_difference_t<O> n, V const & val, std::true_type)
+        {
+            if(n != 0)
+                detail::fill_bytes(
+                    std::addressof(*first), n, static_cast<iter_value_t<O>>(val));
+            return first + n;
+        }
+    } // namespace detail
+    /// \endcond
+
     /// \addtogroup group-algorithms
     /// @{
     RANGES_BEGIN_NIEBLOID(fill_n)
@@ -37,11 +65,8 @@ namespace ranges
                 requires output_iterator<O, V const &>)
         {
             RANGES_EXPECT(n >= 0);
-            auto norig = n;
-            auto b = uncounted(first);
-            for(; n != 0; ++b, --n)
-                *b = val;
-            return recounted(first, b, norig);
+            return detail::fill_n_(
+                std::move(first), n, val, detail::fill_bytes_<O, O, V>{});
         }
 
     RANGES_END_NIEBLOID(fill_n)
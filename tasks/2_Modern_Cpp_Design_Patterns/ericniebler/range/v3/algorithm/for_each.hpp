@@ -18,6 +18,8 @@
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/algorithm/result_types.hpp>
+#include <range/v3/detail/block_iteration.hpp>
+#include <range/v3/detail/segmented_iteration.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
 #include <range/v3/functional/reference_wrapper.hpp>
@@ -35,6 +37,33 @@ namespace ranges
     template<typename I, typename F>
     using for_each_result = detail::in_fun_result<I, F>;
 
+    /// \cond
+    namespace detail
+    {
+        template<typename Rng, typename F, typename P>
+        iterator_t<Rng> for_each_range_(Rng & rng, F & fun, P & proj, std::false_type)
+        {
+            auto first = ranges::begin(rng);
+            auto const last = ranges::end(rng);
+            for(; first != last; ++first)
+            {
+                invoke(fun, invoke(proj, *first));
+            }
+            return first;
+        }
+        template<typename Rng, typename F, typename P>
+        iterator_t<Rng> for_each_range_(Rng & rng, F & fun, P & proj, std::true_type)
+        {
+            return detail::for_each_in_blocks(rng, fun, proj);
+        }
+        template<typename Rng, typename F, typename P>
+        iterator_t<Rng> for_each_range_(Rng & rng, F & fun, P & proj, segmented_tag)
+        {
+            return detail::for_each_in_segments(rng, fun, proj);
+        }
+    } // namespace detail
+    /// \endcond
+
     RANGES_BEGIN_NIEBLOID(for_each)
 
         /// \brief function template \c for_each
@@ -58,8 +87,9 @@ namespace ranges
                 requires input_range<Rng> &&
                 indirectly_unary_invocable<F, projected<iterator_t<Rng>, P>>)
         {
-            return {(*this)(begin(rng), end(rng), ref(fun), detail::move(proj)).in,
-                    detail::move(fun)};
+            auto last =
+                detail::for_each_range_(rng, fun, proj, detail::traversal_tag_t<Rng>{});
+            return {detail::move(last), detail::move(fun)};
         }
 
     RANGES_END_NIEBLOID(for_each)
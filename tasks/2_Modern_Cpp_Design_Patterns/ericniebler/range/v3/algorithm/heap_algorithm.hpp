@@ -21,7 +21,11 @@
 #ifndef RANGES_V3_ALGORITHM_HEAP_ALGORITHM_HPP
 #define RANGES_V3_ALGORITHM_HEAP_ALGORITHM_HPP
 
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 #include <meta/meta.hpp>
 
@@ -425,6 +429,383 @@ namespace ranges
         using ranges::sort_heap;
     }
     /// @}
+
+    /// \cond
+    namespace detail
+    {
+        // d-ary heaps: the children of the element at i are at Arity * i + 1, ...,
+        // Arity * i + Arity. With 4 or 8 children of a few bytes each, the children of
+        // an element share one or two cache lines, and the heap has log2(Arity) times
+        // fewer levels than a binary one, i.e., fewer cache misses on large heaps.
+        template<std::size_t Arity, typename I, typename C, typename P>
+        I dary_is_heap_until_n(I first, iter_difference_t<I> n, C & pred, P & proj)
+        {
+            using D = iter_difference_t<I>;
+            RANGES_EXPECT(0 <= n);
+            for(D c = 1; c < n; ++c)
+                if(invoke(pred,
+                          invoke(proj, first[(c - 1) / static_cast<D>(Arity)]),
+                          invoke(proj, first[c])))
+                    return first + c;
+            return first + n;
+        }
+
+        // Fetches the grandchildren of the element whose children start at c into the
+        // cache while the largest child is being selected. The selection does not
+        // branch, so the processor would not run ahead into the next level otherwise.
+        template<std::size_t Arity, typename I>
+        void dary_prefetch_(I first, iter_difference_t<I> c, iter_difference_t<I> len,
+                            std::true_type)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            using D = iter_difference_t<I>;
+            D const g = static_cast<D>(Arity) * c + 1;
+            if(g >= len)
+                return;
+            D const bytes = static_cast<D>(Arity * Arity * sizeof(iter_value_t<I>));
+            char const * const p =
+                reinterpret_cast<char const *>(std::addressof(*(first + g)));
+            for(D b = 0; b < bytes; b += 64)
+                __builtin_prefetch(p + b);
+#else
+            (void)first, (void)c, (void)len;
+#endif
+        }
+        template<std::size_t Arity, typename I>
+        void dary_prefetch_(I, iter_difference_t<I>, iter_difference_t<I>,
+                            std::false_type)
+        {}
+
+        // The largest of the children of an element, the first of which is at c, in a
+        // heap of len elements.
+        template<std::size_t Arity, typename I, typename C, typename P>
+        iter_difference_t<I> dary_largest_child(I first, iter_difference_t<I> c,
+                                                iter_difference_t<I> len, C & pred,
+                                                P & proj)
+        {
+            using D = iter_difference_t<I>;
+            D best = c;
+            if(len - c >= static_cast<D>(Arity))
+            {
+                // Selected with a mask: the comparisons of random keys are
+                // unpredictable, and compilers keep the branches otherwise.
+                for(D i = c + 1; i != c + static_cast<D>(Arity); ++i)
+                {
+                    D const greater = invoke(
+                        pred, invoke(proj, first[best]), invoke(proj, first[i]));
+                    best ^= (best ^ i) & -greater;
+                }
+            }
+            else
+            {
+                for(D i = c + 1; i < len; ++i)
+                    if(invoke(pred, invoke(proj, first[best]), invoke(proj, first[i])))
+                        best = i;
+            }
+            return best;
+        }
+
+        // Moves the hole at hole up until the parent is not less than val, and fills
+        // it with val.
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_push_hole_up(I first, iter_difference_t<I> hole, iter_value_t<I> val,
+                               C & pred, P & proj)
+        {
+            using D = iter_difference_t<I>;
+            while(hole > 0)
+            {
+                D const parent = (hole - 1) / static_cast<D>(Arity);
+                if(!invoke(pred, invoke(proj, first[parent]), invoke(proj, val)))
+                    break;
+                first[hole] = iter_move(first + parent);
+                hole = parent;
+            }
+            first[hole] = std::move(val);
+        }
+
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_sift_up_n(I first, iter_difference_t<I> len, C & pred, P & proj)
+        {
+            using D = iter_difference_t<I>;
+            if(len < 2)
+                return;
+            D const hole = len - 1;
+            if(!invoke(pred,
+                       invoke(proj, first[(hole - 1) / static_cast<D>(Arity)]),
+                       invoke(proj, first[hole])))
+                return;
+            detail::dary_push_hole_up<Arity>(
+                first, hole, iter_move(first + hole), pred, proj);
+        }
+
+        // Top-down: stops as soon as no child is greater than the element.
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_sift_down_n(I first, iter_difference_t<I> len,
+                              iter_difference_t<I> hole, C & pred, P & proj)
+        {
+            using D = iter_difference_t<I>;
+            D child = static_cast<D>(Arity) * hole + 1;
+            if(child >= len)
+                return;
+            D best = detail::dary_largest_child<Arity>(first, child, len, pred, proj);
+            if(!invoke(pred, invoke(proj, first[hole]), invoke(proj, first[best])))
+                return;
+            iter_value_t<I> val = iter_move(first + hole);
+            do
+            {
+                first[hole] = iter_move(first + best);
+                hole = best;
+                child = static_cast<D>(Arity) * hole + 1;
+                if(child >= len)
+                    break;
+                best = detail::dary_largest_child<Arity>(first, child, len, pred, proj);
+            } while(invoke(pred, invoke(proj, val), invoke(proj, first[best])));
+            first[hole] = std::move(val);
+        }
+
+        // Replaces the top of the heap [first, first + len) with val. Bottom-up
+        // (Wegener): an element from the back of a heap belongs near the bottom most of
+        // the time, so the hole at the top moves down to a leaf along the largest
+        // children without comparing them to val, which then moves up from there. That
+        // saves a comparison per level.
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_replace_top_n(I first, iter_difference_t<I> len, iter_value_t<I> val,
+                                C & pred, P & proj)
+        {
+            using D = iter_difference_t<I>;
+            D hole = 0;
+            for(D child = 1; child < len; child = static_cast<D>(Arity) * hole + 1)
+            {
+                detail::dary_prefetch_<Arity>(
+                    first, child, len, meta::bool_<contiguous_iterator<I>>{});
+                D const best =
+                    detail::dary_largest_child<Arity>(first, child, len, pred, proj);
+                first[hole] = iter_move(first + best);
+                hole = best;
+            }
+            detail::dary_push_hole_up<Arity>(first, hole, std::move(val), pred, proj);
+        }
+
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_pop_heap_n(I first, iter_difference_t<I> len, C & pred, P & proj)
+        {
+            if(len < 2)
+                return;
+            auto const back = len - 1;
+            iter_value_t<I> val = iter_move(first + back);
+            first[back] = iter_move(first);
+            detail::dary_replace_top_n<Arity>(first, back, std::move(val), pred, proj);
+        }
+
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_make_heap_n(I first, iter_difference_t<I> n, C & pred, P & proj)
+        {
+            using D = iter_difference_t<I>;
+            if(n > 1)
+                for(D start = (n - 2) / static_cast<D>(Arity); start >= 0; --start)
+                    detail::dary_sift_down_n<Arity>(first, n, start, pred, proj);
+        }
+
+        template<std::size_t Arity, typename I, typename C, typename P>
+        void dary_sort_heap_n(I first, iter_difference_t<I> n, C & pred, P & proj)
+        {
+            for(auto i = n; i > 1; --i)
+                detail::dary_pop_heap_n<Arity>(first, i, pred, proj);
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-algorithms
+    /// @{
+
+    // Heap algorithms for heaps with Arity children per element; push_dary_heap<2>
+    // etc. maintain the same heaps as push_heap etc.
+
+    template<std::size_t Arity>
+    struct is_dary_heap_until_fn
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto operator()(I first, S last, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(I)(                                                 //
+                requires random_access_iterator<I> && sentinel_for<S, I> &&
+                indirect_strict_weak_order<C, projected<I, P>>)
+        {
+            auto const n = distance(first, last);
+            return detail::dary_is_heap_until_n<Arity>(std::move(first), n, pred, proj);
+        }
+
+        template<typename Rng, typename C = less, typename P = identity>
+        auto operator()(Rng && rng, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(safe_iterator_t<Rng>)(                         //
+                requires random_access_range<Rng> &&
+                indirect_strict_weak_order<C, projected<iterator_t<Rng>, P>>)
+        {
+            return detail::dary_is_heap_until_n<Arity>(
+                begin(rng), distance(rng), pred, proj);
+        }
+    };
+
+    template<std::size_t Arity>
+    RANGES_INLINE_VAR constexpr is_dary_heap_until_fn<Arity> is_dary_heap_until{};
+
+    template<std::size_t Arity>
+    struct is_dary_heap_fn
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto operator()(I first, S last, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(bool)(                                              //
+                requires random_access_iterator<I> && sentinel_for<S, I> &&
+                indirect_strict_weak_order<C, projected<I, P>>)
+        {
+            auto const n = distance(first, last);
+            return detail::dary_is_heap_until_n<Arity>(first, n, pred, proj) ==
+                   first + n;
+        }
+
+        template<typename Rng, typename C = less, typename P = identity>
+        auto operator()(Rng && rng, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(bool)(                                         //
+                requires random_access_range<Rng> &&
+                indirect_strict_weak_order<C, projected<iterator_t<Rng>, P>>)
+        {
+            auto const first = begin(rng);
+            auto const n = distance(rng);
+            return detail::dary_is_heap_until_n<Arity>(first, n, pred, proj) ==
+                   first + n;
+        }
+    };
+
+    template<std::size_t Arity>
+    RANGES_INLINE_VAR constexpr is_dary_heap_fn<Arity> is_dary_heap{};
+
+    template<std::size_t Arity>
+    struct push_dary_heap_fn
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto operator()(I first, S last, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(I)(                                                 //
+                requires random_access_iterator<I> && sentinel_for<S, I> &&
+                sortable<I, C, P>)
+        {
+            auto const n = distance(first, last);
+            detail::dary_sift_up_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+
+        template<typename Rng, typename C = less, typename P = identity>
+        auto operator()(Rng && rng, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(safe_iterator_t<Rng>)(                         //
+                requires random_access_range<Rng> && sortable<iterator_t<Rng>, C, P>)
+        {
+            iterator_t<Rng> first = ranges::begin(rng);
+            auto const n = distance(rng);
+            detail::dary_sift_up_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+    };
+
+    template<std::size_t Arity>
+    RANGES_INLINE_VAR constexpr push_dary_heap_fn<Arity> push_dary_heap{};
+
+    template<std::size_t Arity>
+    struct pop_dary_heap_fn
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto operator()(I first, S last, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(I)(                                                 //
+                requires random_access_iterator<I> && sentinel_for<S, I> &&
+                sortable<I, C, P>)
+        {
+            auto const n = distance(first, last);
+            detail::dary_pop_heap_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+
+        template<typename Rng, typename C = less, typename P = identity>
+        auto operator()(Rng && rng, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(safe_iterator_t<Rng>)(                         //
+                requires random_access_range<Rng> && sortable<iterator_t<Rng>, C, P>)
+        {
+            iterator_t<Rng> first = ranges::begin(rng);
+            auto const n = distance(rng);
+            detail::dary_pop_heap_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+    };
+
+    template<std::size_t Arity>
+    RANGES_INLINE_VAR constexpr pop_dary_heap_fn<Arity> pop_dary_heap{};
+
+    template<std::size_t Arity>
+    struct make_dary_heap_fn
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto operator()(I first, S last, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(I)(                                                 //
+                requires random_access_iterator<I> && sentinel_for<S, I> &&
+                sortable<I, C, P>)
+        {
+            auto const n = distance(first, last);
+            detail::dary_make_heap_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+
+        template<typename Rng, typename C = less, typename P = identity>
+        auto operator()(Rng && rng, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(safe_iterator_t<Rng>)(                         //
+                requires random_access_range<Rng> && sortable<iterator_t<Rng>, C, P>)
+        {
+            iterator_t<Rng> first = ranges::begin(rng);
+            auto const n = distance(rng);
+            detail::dary_make_heap_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+    };
+
+    template<std::size_t Arity>
+    RANGES_INLINE_VAR constexpr make_dary_heap_fn<Arity> make_dary_heap{};
+
+    template<std::size_t Arity>
+    struct sort_dary_heap_fn
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto operator()(I first, S last, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(I)(                                                 //
+                requires random_access_iterator<I> && sentinel_for<S, I> &&
+                sortable<I, C, P>)
+        {
+            auto const n = distance(first, last);
+            detail::dary_sort_heap_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+
+        template<typename Rng, typename C = less, typename P = identity>
+        auto operator()(Rng && rng, C pred = C{}, P proj = P{}) const //
+            -> CPP_ret(safe_iterator_t<Rng>)(                         //
+                requires random_access_range<Rng> && sortable<iterator_t<Rng>, C, P>)
+        {
+            iterator_t<Rng> first = ranges::begin(rng);
+            auto const n = distance(rng);
+            detail::dary_sort_heap_n<Arity>(first, n, pred, proj);
+            return first + n;
+        }
+    };
+
+    template<std::size_t Arity>
+    RANGES_INLINE_VAR constexpr sort_dary_heap_fn<Arity> sort_dary_heap{};
+    /// @}
 } // namespace ranges
 
 #endif // include guard
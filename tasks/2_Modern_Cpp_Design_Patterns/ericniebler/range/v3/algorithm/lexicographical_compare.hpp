@@ -13,8 +13,15 @@
 #ifndef RANGES_V3_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
 #define RANGES_V3_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
 
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/mismatch.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -27,6 +34,63 @@
 
 namespace ranges
 {
+    /// \cond
+    namespace detail
+    {
+        template<typename I0, typename S0, typename I1, typename S1, typename C,
+                 typename P0, typename P1>
+        bool lexicographical_compare_(I0 begin0, S0 end0, I1 begin1, S1 end1, C & pred,
+                                      P0 & proj0, P1 & proj1, std::false_type)
+        {
+            for(; begin1 != end1; ++begin0, ++begin1)
+            {
+                if(begin0 == end0 ||
+                   invoke(pred, invoke(proj0, *begin0), invoke(proj1, *begin1)))
+                    return true;
+                if(invoke(pred, invoke(proj1, *begin1), invoke(proj0, *begin0)))
+                    return false;
+            }
+            return false;
+        }
+
+        // Contiguous ranges of integers, enums or pointers ordered with less or greater
+        // are compared up to the first elements that differ with
+        // detail::mismatch_bytes, or with memcmp for unsigned bytes and less.
+        template<typename I0, typename S0, typename I1, typename S1, typename C,
+                 typename P0, typename P1>
+        bool lexicographical_compare_(I0 begin0, S0 end0, I1 begin1, S1 end1, C & pred,
+                                      P0 &, P1 &, std::true_type)
+        {
+            using T = iter_value_t<I0>;
+            std::ptrdiff_t const d0 = end0 - begin0;
+            std::ptrdiff_t const d1 = end1 - begin1;
+            std::ptrdiff_t const n = d0 < d1 ? d0 : d1;
+            if(n != 0)
+            {
+                auto const x =
+                    reinterpret_cast<mismatch_byte_t const *>(std::addressof(*begin0));
+                auto const y =
+                    reinterpret_cast<mismatch_byte_t const *>(std::addressof(*begin1));
+                auto const bytes = static_cast<std::size_t>(n) * sizeof(T);
+                if(RANGES_CONSTEXPR_IF(lexicographical_memcmp_<C, T>::value))
+                {
+                    int const r = std::memcmp(x, y, bytes);
+                    if(r != 0)
+                        return r < 0;
+                }
+                else
+                {
+                    auto const i = static_cast<std::ptrdiff_t>(
+                        detail::mismatch_bytes(x, y, bytes) / sizeof(T));
+                    if(i != n)
+                        return invoke(pred, begin0[i], begin1[i]);
+                }
+            }
+            return d0 < d1;
+        }
+    } // namespace detail
+    /// \endcond
+
     /// \addtogroup group-algorithms
     /// @{
     RANGES_BEGIN_NIEBLOID(lexicographical_compare)
@@ -51,15 +115,15 @@ namespace ranges
                 input_iterator<I1> && sentinel_for<S1, I1> &&
                 indirect_strict_weak_order<C, projected<I0, P0>, projected<I1, P1>>)
         {
-            for(; begin1 != end1; ++begin0, ++begin1)
-            {
-                if(begin0 == end0 ||
-                   invoke(pred, invoke(proj0, *begin0), invoke(proj1, *begin1)))
-                    return true;
-                if(invoke(pred, invoke(proj1, *begin1), invoke(proj0, *begin0)))
-                    return false;
-            }
-            return false;
+            return detail::lexicographical_compare_(
+                std::move(begin0),
+                std::move(end0),
+                std::move(begin1),
+                std::move(end1),
+                pred,
+                proj0,
+                proj1,
+                detail::lexicographical_bytes_<I0, S0, I1, S1, C, P0, P1>{});
         }
 
         /// \overload
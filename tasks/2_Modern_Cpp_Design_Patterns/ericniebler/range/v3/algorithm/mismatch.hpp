@@ -13,6 +13,9 @@
 #ifndef RANGES_V3_ALGORITHM_MISMATCH_HPP
 #define RANGES_V3_ALGORITHM_MISMATCH_HPP
 
+#include <cstddef>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 #include <meta/meta.hpp>
@@ -20,6 +23,7 @@
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/algorithm/result_types.hpp>
+#include <range/v3/detail/mismatch.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -38,6 +42,45 @@ namespace ranges
     template<typename I1, typename I2>
     using mismatch_result = detail::in1_in2_result<I1, I2>;
 
+    /// \cond
+    namespace detail
+    {
+        template<typename I1, typename S1, typename I2, typename S2, typename C,
+                 typename P1, typename P2>
+        mismatch_result<I1, I2> mismatch_(I1 begin1, S1 end1, I2 begin2, S2 end2,
+                                          C & pred, P1 & proj1, P2 & proj2,
+                                          std::false_type)
+        {
+            for(; begin1 != end1 && begin2 != end2; ++begin1, ++begin2)
+                if(!invoke(pred, invoke(proj1, *begin1), invoke(proj2, *begin2)))
+                    break;
+            return {begin1, begin2};
+        }
+
+        // Contiguous ranges of integers, enums or pointers compared with equal_to are
+        // compared with detail::mismatch_bytes.
+        template<typename I1, typename S1, typename I2, typename S2, typename C,
+                 typename P1, typename P2>
+        mismatch_result<I1, I2> mismatch_(I1 begin1, S1 end1, I2 begin2, S2 end2, C &,
+                                          P1 &, P2 &, std::true_type)
+        {
+            std::ptrdiff_t const d1 = end1 - begin1;
+            std::ptrdiff_t const d2 = end2 - begin2;
+            std::ptrdiff_t const n = d1 < d2 ? d1 : d2;
+            if(n == 0)
+                return {begin1, begin2};
+            constexpr std::size_t size = sizeof(iter_value_t<I1>);
+            auto const i = static_cast<std::ptrdiff_t>(
+                detail::mismatch_bytes(
+                    reinterpret_cast<mismatch_byte_t const *>(std::addressof(*begin1)),
+                    reinterpret_cast<mismatch_byte_t const *>(std::addressof(*begin2)),
+                    static_cast<std::size_t>(n) * size) /
+                size);
+            return {begin1 + i, begin2 + i};
+        }
+    } // namespace detail
+    /// \endcond
+
     RANGES_BEGIN_NIEBLOID(mismatch)
 
         /// \brief function template \c mismatch
@@ -87,10 +130,15 @@ namespace ranges
                 input_iterator<I2> && sentinel_for<S2, I2> &&
                 indirect_relation<C, projected<I1, P1>, projected<I2, P2>>)
         {
-            for(; begin1 != end1 && begin2 != end2; ++begin1, ++begin2)
-                if(!invoke(pred, invoke(proj1, *begin1), invoke(proj2, *begin2)))
-                    break;
-            return {begin1, begin2};
+            return detail::mismatch_(
+                std::move(begin1),
+                std::move(end1),
+                std::move(begin2),
+                std::move(end2),
+                pred,
+                proj1,
+                proj2,
+                detail::mismatch_bytes_<I1, S1, I2, S2, C, P1, P2>{});
         }
 
         /// \overload
@@ -13,11 +13,14 @@
 #ifndef RANGES_V3_ALGORITHM_MOVE_HPP
 #define RANGES_V3_ALGORITHM_MOVE_HPP
 
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/algorithm/result_types.hpp>
+#include <range/v3/detail/copy_bytes.hpp>
 #include <range/v3/iterator/concepts.hpp>
 #include <range/v3/iterator/traits.hpp>
 #include <range/v3/range/access.hpp>
@@ -34,6 +37,29 @@ namespace ranges
     template<typename I, typename O>
     using move_result = detail::in_out_result<I, O>;
 
+    /// \cond
+    namespace detail
+    {
+        template<typename I, typename S, typename O>
+        move_result<I, O> move_(I first, S last, O out, std::false_type)
+        {
+            for(; first != last; ++first, ++out)
+                *out = iter_move(first);
+            return {first, out};
+        }
+
+        // Contiguous ranges of trivially copyable elements are moved with memmove.
+        template<typename I, typename S, typename O>
+        move_result<I, O> move_(I first, S last, O out, std::true_type)
+        {
+            auto const n = last - first;
+            if(n != 0)
+                detail::copy_bytes(std::addressof(*first), n, std::addressof(*out));
+            return {first + n, out + n};
+        }
+    } // namespace detail
+    /// \endcond
+
     RANGES_HIDDEN_DETAIL(namespace _move CPP_PP_LBRACE())
     RANGES_BEGIN_NIEBLOID(move)
 
@@ -44,9 +70,10 @@ namespace ranges
                 requires input_iterator<I> && sentinel_for<S, I> &&
                 weakly_incrementable<O> && indirectly_movable<I, O>)
         {
-            for(; first != last; ++first, ++out)
-                *out = iter_move(first);
-            return {first, out};
+            return detail::move_(std::move(first),
+                                 std::move(last),
+                                 std::move(out),
+                                 detail::copy_bytes_<I, S, O, true>{});
         }
 
         /// \overload
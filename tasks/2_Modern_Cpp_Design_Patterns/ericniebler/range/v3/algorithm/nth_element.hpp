@@ -10,24 +10,20 @@
 //
 // Project home: https://github.com/ericniebler/range-v3
 //
-
-//===----------------------------------------------------------------------===//
-//
-//                     The LLVM Compiler Infrastructure
-//
-// This file is dual licensed under the MIT and the University of Illinois Open
-// Source Licenses. See LICENSE.TXT for details.
-//
-//===----------------------------------------------------------------------===//
-
 #ifndef RANGES_V3_ALGORITHM_NTH_ELEMENT_HPP
 #define RANGES_V3_ALGORITHM_NTH_ELEMENT_HPP
 
+#include <cmath>
+#include <cstddef>
+#include <functional>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/algorithm/heap_algorithm.hpp>
+#include <range/v3/algorithm/max_element.hpp>
 #include <range/v3/algorithm/min_element.hpp>
+#include <range/v3/algorithm/sort.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -46,264 +42,206 @@ namespace ranges
     /// \cond
     namespace detail
     {
-        // stable, 2-3 compares, 0-2 swaps
+        // Ranges longer than this are narrowed around a pivot that is selected from a
+        // sample, shorter ones around a median of 3.
+        constexpr std::ptrdiff_t floyd_rivest_threshold()
+        {
+            return 600;
+        }
+
+        template<typename C>
+        struct select_greater_
+        {
+            C & pred;
+
+            template<typename A, typename B>
+            bool operator()(A && a, B && b) const
+            {
+                return invoke(pred, static_cast<B &&>(b), static_cast<A &&>(a));
+            }
+        };
 
+        // Turns [first, last) into a heap and exchanges the elements of [other_first,
+        // other_last) that are less than its top into it. Afterwards [first, last)
+        // holds the last - first smallest elements of both ranges.
         template<typename I, typename C, typename P>
-        auto sort3(I x, I y, I z, C & pred, P & proj) -> CPP_ret(unsigned)( //
-            requires forward_iterator<I> && indirect_relation<C, projected<I, P>>)
+        void heap_select(I first, I last, I other_first, I other_last, C & pred,
+                         P & proj)
         {
-            unsigned r = 0;
-            if(!invoke(pred, invoke(proj, *y), invoke(proj, *x))) // if x <= y
+            make_heap(first, last, std::ref(pred), std::ref(proj));
+            auto const len = last - first;
+            for(; other_first != other_last; ++other_first)
             {
-                if(!invoke(pred, invoke(proj, *z), invoke(proj, *y))) // if y <= z
-                    return r;                                         // x <= y && y <= z
-                                                                      // x <= y && y > z
-                ranges::iter_swap(y, z);                              // x <= z && y < z
-                r = 1;
-                if(invoke(pred, invoke(proj, *y), invoke(proj, *x))) // if x > y
+                if(invoke(pred, invoke(proj, *other_first), invoke(proj, *first)))
                 {
-                    ranges::iter_swap(x, y); // x < y && y <= z
-                    r = 2;
+                    ranges::iter_swap(other_first, first);
+                    detail::sift_down_n(
+                        first, len, first, std::ref(pred), std::ref(proj));
                 }
-                return r; // x <= y && y < z
-            }
-            if(invoke(pred, invoke(proj, *z), invoke(proj, *y))) // x > y, if y > z
-            {
-                ranges::iter_swap(x, z); // x < y && y < z
-                r = 1;
-                return r;
-            }
-            ranges::iter_swap(x, y);                             // x > y && y <= z
-            r = 1;                                               // x < y && x <= z
-            if(invoke(pred, invoke(proj, *z), invoke(proj, *y))) // if y > z
-            {
-                ranges::iter_swap(y, z); // x <= y && y < z
-                r = 2;
             }
-            return r;
-        } // x <= y && y <= z
+        }
 
+        // O(n log n) in the worst case: a heap of the elements on the shorter side of
+        // nth, whose top ends up in nth.
         template<typename I, typename C, typename P>
-        auto selection_sort(I first, I last, C & pred, P & proj) -> CPP_ret(void)( //
-            requires bidirectional_iterator<I> && indirect_relation<C, projected<I, P>>)
+        void heap_nth_element(I first, I nth, I last, C & pred, P & proj)
         {
-            RANGES_EXPECT(first != last);
-            for(I lm1 = ranges::prev(last); first != lm1; ++first)
+            if(nth - first < last - nth)
+            {
+                detail::heap_select(first, nth + 1, nth + 1, last, pred, proj);
+                ranges::iter_swap(first, nth);
+            }
+            else
             {
-                I i = ranges::min_element(first, last, std::ref(pred), std::ref(proj));
-                if(i != first)
-                    ranges::iter_swap(first, i);
+                select_greater_<C> greater{pred};
+                detail::heap_select(nth, last, first, nth, greater, proj);
             }
         }
-    } // namespace detail
-    /// \endcond
 
-    /// \addtogroup group-algorithms
-    /// @{
-    RANGES_BEGIN_NIEBLOID(nth_element)
+        // Spreads the sample [first + lo, first + lo + m) evenly over the range, which
+        // keeps it representative for presorted or otherwise structured input.
+        template<typename I>
+        void gather_sample(I first, std::ptrdiff_t size, std::ptrdiff_t lo,
+                           std::ptrdiff_t m)
+        {
+            std::ptrdiff_t const step = size / m;
+            for(std::ptrdiff_t i = 0; i != m; ++i)
+                ranges::iter_swap(first + (lo + i), first + i * step);
+        }
 
-        /// \brief function template \c nth_element
-        template<typename I, typename S, typename C = less, typename P = identity>
-        auto RANGES_FUN_NIEBLOID(nth_element)(
-            I first, I nth, S end_, C pred = C{}, P proj = P{}) //
-            ->CPP_ret(I)(                                       //
-                requires random_access_iterator<I> && sortable<I, C, P>)
+        // Introselect with the pivots of Floyd and Rivest ("Algorithm 489: The
+        // Algorithm SELECT"): the pivot of a long range is selected recursively from a
+        // sample of about n^(2/3) elements gathered next to nth, at the rank of nth in
+        // the range shifted by a few standard deviations towards the middle.
+        // Partitioning around it leaves nth in a small part with high probability, so
+        // that the total is about n + min(k, n - k) comparisons. Shorter ranges are
+        // partitioned around a median of 3 or a pseudomedian of 9. The partitions are
+        // those of pdqsort, branchless for arithmetic keys; elements equal to the pivot
+        // of an enclosing partition are gathered in one pass. After 2 log2(n)
+        // partitions the rest of the range is handled by heap_nth_element.
+        template<typename I, typename C, typename P, typename Branchless>
+        void floyd_rivest_select(I first, I nth, I last, C & pred, P & proj,
+                                 int bad_allowed, bool leftmost, Branchless branchless)
         {
-            I last = ranges::next(nth, end_), end_orig = last;
-            // C is known to be a reference type
-            using difference_type = iter_difference_t<I>;
-            difference_type const limit = 7;
+            sort_compare<C, P> comp{pred, proj};
             while(true)
             {
-            restart:
-                if(nth == last)
-                    return end_orig;
-                difference_type len = last - first;
-                switch(len)
-                {
-                case 0:
-                case 1:
-                    return end_orig;
-                case 2:
-                    if(invoke(pred, invoke(proj, *--last), invoke(proj, *first)))
-                        ranges::iter_swap(first, last);
-                    return end_orig;
-                case 3:
-                {
-                    I m = first;
-                    detail::sort3(first, ++m, --last, pred, proj);
-                    return end_orig;
-                }
-                }
-                if(len <= limit)
+                std::ptrdiff_t const size = last - first;
+                if(size < detail::pdqsort_insertion_threshold())
                 {
-                    detail::selection_sort(first, last, pred, proj);
-                    return end_orig;
+                    if(leftmost)
+                        detail::insertion_sort(first, last, pred, proj);
+                    else
+                        detail::unguarded_insertion_sort(first, last, pred, proj);
+                    return;
                 }
-                // len > limit >= 3
-                I m = first + len / 2;
-                I lm1 = last;
-                unsigned n_swaps = detail::sort3(first, m, --lm1, pred, proj);
-                // *m is median
-                // partition [first, m) < *m and *m <= [m, last)
-                //(this inhibits tossing elements equivalent to m around unnecessarily)
-                I i = first;
-                I j = lm1;
-                // j points beyond range to be tested, *lm1 is known to be <= *m
-                // The search going up is known to be guarded but the search coming down
-                // isn't. Prime the downward search with a guard.
-                if(!invoke(pred, invoke(proj, *i), invoke(proj, *m))) // if *first == *m
+                std::ptrdiff_t const k = nth - first;
+                if(k == 0 || k == size - 1)
                 {
-                    // *first == *m, *first doesn't go in first part
-                    // manually guard downward moving j against i
-                    while(true)
-                    {
-                        if(i == --j)
-                        {
-                            // *first == *m, *m <= all other elements
-                            // Parition instead into [first, i) == *first and *first < [i,
-                            // last)
-                            ++i; // first + 1
-                            j = last;
-                            if(!invoke(
-                                   pred,
-                                   invoke(proj, *first),
-                                   invoke(
-                                       proj,
-                                       *--j))) // we need a guard if *first == *(last-1)
-                            {
-                                while(true)
-                                {
-                                    if(i == j)
-                                        return end_orig; // [first, last) all equivalent
-                                                         // elements
-                                    if(invoke(
-                                           pred, invoke(proj, *first), invoke(proj, *i)))
-                                    {
-                                        ranges::iter_swap(i, j);
-                                        ++n_swaps;
-                                        ++i;
-                                        break;
-                                    }
-                                    ++i;
-                                }
-                            }
-                            // [first, i) == *first and *first < [j, last) and j == last -
-                            // 1
-                            if(i == j)
-                                return end_orig;
-                            while(true)
-                            {
-                                while(
-                                    !invoke(pred, invoke(proj, *first), invoke(proj, *i)))
-                                    ++i;
-                                while(invoke(
-                                    pred, invoke(proj, *first), invoke(proj, *--j)))
-                                    ;
-                                if(i >= j)
-                                    break;
-                                ranges::iter_swap(i, j);
-                                ++n_swaps;
-                                ++i;
-                            }
-                            // [first, i) == *first and *first < [i, last)
-                            // The first part is sorted,
-                            if(nth < i)
-                                return end_orig;
-                            // nth_element the second part
-                            // nth_element<C>(i, nth, last, pred);
-                            first = i;
-                            goto restart;
-                        }
-                        if(invoke(pred, invoke(proj, *j), invoke(proj, *m)))
-                        {
-                            ranges::iter_swap(i, j);
-                            ++n_swaps;
-                            break; // found guard for downward moving j, now use unguarded
-                                   // partition
-                        }
-                    }
+                    I const i =
+                        k == 0 ? min_element(first, last, std::ref(pred), std::ref(proj))
+                               : max_element(first, last, std::ref(pred), std::ref(proj));
+                    ranges::iter_swap(i, nth);
+                    return;
                 }
-                ++i;
-                // j points beyond range to be tested, *lm1 is known to be <= *m
-                // if not yet partitioned...
-                if(i < j)
+                if(bad_allowed-- == 0)
                 {
-                    // known that *(i - 1) < *m
-                    while(true)
-                    {
-                        // m still guards upward moving i
-                        while(invoke(pred, invoke(proj, *i), invoke(proj, *m)))
-                            ++i;
-                        // It is now known that a guard exists for downward moving j
-                        while(!invoke(pred, invoke(proj, *--j), invoke(proj, *m)))
-                            ;
-                        if(i >= j)
-                            break;
-                        ranges::iter_swap(i, j);
-                        ++n_swaps;
-                        // It is known that m != j
-                        // If m just moved, follow it
-                        if(m == i)
-                            m = j;
-                        ++i;
-                    }
+                    detail::heap_nth_element(first, nth, last, pred, proj);
+                    return;
                 }
-                // [first, i) < *m and *m <= [i, last)
-                if(i != m && invoke(pred, invoke(proj, *m), invoke(proj, *i)))
+
+                if(size > detail::floyd_rivest_threshold())
                 {
-                    ranges::iter_swap(i, m);
-                    ++n_swaps;
+                    double const n = static_cast<double>(size);
+                    double const z = std::log(n);
+                    double const s = 0.5 * std::exp(2.0 * z / 3.0);
+                    double const sd = 0.5 * std::sqrt(z * s * (n - s) / n) *
+                                      (2 * k < size ? -1.0 : 1.0);
+                    auto lo = static_cast<std::ptrdiff_t>(k - k * s / n + sd);
+                    auto hi = static_cast<std::ptrdiff_t>(k + (n - k) * s / n + sd);
+                    lo = lo < 0 ? 0 : lo > k ? k : lo;
+                    hi = hi <= k ? k + 1 : hi >= size ? size - 1 : hi;
+                    detail::gather_sample(first, size, lo, hi + 1 - lo);
+                    detail::floyd_rivest_select(
+                        first + lo,
+                        nth,
+                        first + (hi + 1),
+                        pred,
+                        proj,
+                        2 * static_cast<int>(detail::log2(hi + 1 - lo)),
+                        true,
+                        branchless);
+                    // *nth is the pivot, and *(first + hi) is not less than it.
+                    ranges::iter_swap(first, nth);
                 }
-                // [first, i) < *i and *i <= [i+1, last)
-                if(nth == i)
-                    return end_orig;
-                if(n_swaps == 0)
+                else if(size > detail::pdqsort_ninther_threshold())
                 {
-                    // We were given a perfectly partitioned sequence.  Coincidence?
-                    if(nth < i)
-                    {
-                        // Check for [first, i) already sorted
-                        j = m = first;
-                        while(++j != i)
-                        {
-                            if(invoke(pred, invoke(proj, *j), invoke(proj, *m)))
-                                // not yet sorted, so sort
-                                goto not_sorted;
-                            m = j;
-                        }
-                        // [first, i) sorted
-                        return end_orig;
-                    }
-                    else
-                    {
-                        // Check for [i, last) already sorted
-                        j = m = i;
-                        while(++j != last)
-                        {
-                            if(invoke(pred, invoke(proj, *j), invoke(proj, *m)))
-                                // not yet sorted, so sort
-                                goto not_sorted;
-                            m = j;
-                        }
-                        // [i, last) sorted
-                        return end_orig;
-                    }
+                    std::ptrdiff_t const s2 = size / 2;
+                    detail::sort3(first, first + s2, last - 1, comp);
+                    detail::sort3(first + 1, first + (s2 - 1), last - 2, comp);
+                    detail::sort3(first + 2, first + (s2 + 1), last - 3, comp);
+                    detail::sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+                    ranges::iter_swap(first, first + s2);
                 }
-            not_sorted:
-                // nth_element on range containing nth
-                if(nth < i)
+                else
+                    detail::sort3(first + size / 2, first, last - 1, comp);
+
+                // As in pdqsort: a pivot equal to the element before the range is not
+                // greater than any element of the range.
+                if(!leftmost && !comp(*(first - 1), *first))
                 {
-                    // nth_element<C>(first, nth, i, pred);
-                    last = i;
+                    I const pivot_pos = detail::partition_left(first, last, comp);
+                    if(nth <= pivot_pos)
+                        return;
+                    first = pivot_pos + 1;
+                    continue;
                 }
+
+                I const pivot_pos =
+                    detail::partition_right_(first, last, comp, branchless).first;
+                if(nth == pivot_pos)
+                    return;
+                if(nth < pivot_pos)
+                    last = pivot_pos;
                 else
                 {
-                    // nth_element<C>(i+1, nth, last, pred);
-                    first = ++i;
+                    first = pivot_pos + 1;
+                    leftmost = false;
                 }
             }
-            return end_orig;
+        }
+
+        template<typename I, typename C, typename P>
+        void nth_element_(I first, I nth, I last, C & pred, P & proj)
+        {
+            detail::floyd_rivest_select(
+                first,
+                nth,
+                last,
+                pred,
+                proj,
+                2 * static_cast<int>(detail::log2(last - first)),
+                true,
+                sort_branchless<I, C, P>{});
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-algorithms
+    /// @{
+    RANGES_BEGIN_NIEBLOID(nth_element)
+
+        /// \brief function template \c nth_element
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto RANGES_FUN_NIEBLOID(nth_element)(
+            I first, I nth, S end_, C pred = C{}, P proj = P{}) //
+            ->CPP_ret(I)(                                       //
+                requires random_access_iterator<I> && sortable<I, C, P>)
+        {
+            I last = ranges::next(nth, end_);
+            if(nth != last)
+                detail::nth_element_(first, nth, last, pred, proj);
+            return last;
         }
 
         /// \overload
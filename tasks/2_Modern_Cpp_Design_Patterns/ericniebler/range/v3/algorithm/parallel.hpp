@@ -0,0 +1,441 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_ALGORITHM_PARALLEL_HPP
+#define RANGES_V3_ALGORITHM_PARALLEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/algorithm/count_if.hpp>
+#include <range/v3/algorithm/find_if.hpp>
+#include <range/v3/algorithm/for_each.hpp>
+#include <range/v3/algorithm/transform.hpp>
+#include <range/v3/detail/thread_pool.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/functional/reference_wrapper.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/concepts.hpp>
+#include <range/v3/range/dangling.hpp>
+#include <range/v3/range/traits.hpp>
+#include <range/v3/utility/execution.hpp>
+#include <range/v3/utility/static_const.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        template<typename I, typename S, typename F, typename P>
+        I parallel_for_each_(I first, S last, F & fun, P & proj, std::false_type)
+        {
+            return ranges::for_each(std::move(first), std::move(last), ranges::ref(fun),
+                                    ranges::ref(proj))
+                .in;
+        }
+        template<typename I, typename S, typename F, typename P>
+        I parallel_for_each_(I first, S last, F & fun, P & proj, std::true_type)
+        {
+            auto const n = last - first;
+            detail::parallel_for_n(
+                static_cast<std::ptrdiff_t>(n), [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+                    I i = first + static_cast<iter_difference_t<I>>(b);
+                    for(; b != e; ++b, ++i)
+                        invoke(fun, invoke(proj, *i));
+                });
+            return first + n;
+        }
+
+        template<typename I, typename S, typename O, typename F, typename P>
+        unary_transform_result<I, O> parallel_transform_(I first, S last, O out, F & fun,
+                                                         P & proj, std::false_type)
+        {
+            return ranges::transform(std::move(first),
+                                     std::move(last),
+                                     std::move(out),
+                                     ranges::ref(fun),
+                                     ranges::ref(proj));
+        }
+        template<typename I, typename S, typename O, typename F, typename P>
+        unary_transform_result<I, O> parallel_transform_(I first, S last, O out, F & fun,
+                                                         P & proj, std::true_type)
+        {
+            auto const n = static_cast<std::ptrdiff_t>(last - first);
+            detail::parallel_for_n(n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+                I i = first + static_cast<iter_difference_t<I>>(b);
+                O o = out + static_cast<iter_difference_t<O>>(b);
+                for(; b != e; ++b, ++i, ++o)
+                    *o = invoke(fun, invoke(proj, *i));
+            });
+            return {first + static_cast<iter_difference_t<I>>(n),
+                    out + static_cast<iter_difference_t<O>>(n)};
+        }
+
+        template<typename I0, typename S0, typename I1, typename S1, typename O,
+                 typename F, typename P0, typename P1>
+        binary_transform_result<I0, I1, O> parallel_transform_(
+            I0 begin0, S0 end0, I1 begin1, S1 end1, O out, F & fun, P0 & proj0,
+            P1 & proj1, std::false_type)
+        {
+            return ranges::transform(std::move(begin0),
+                                     std::move(end0),
+                                     std::move(begin1),
+                                     std::move(end1),
+                                     std::move(out),
+                                     ranges::ref(fun),
+                                     ranges::ref(proj0),
+                                     ranges::ref(proj1));
+        }
+        template<typename I0, typename S0, typename I1, typename S1, typename O,
+                 typename F, typename P0, typename P1>
+        binary_transform_result<I0, I1, O> parallel_transform_(
+            I0 begin0, S0 end0, I1 begin1, S1 end1, O out, F & fun, P0 & proj0,
+            P1 & proj1, std::true_type)
+        {
+            auto const n0 = static_cast<std::ptrdiff_t>(end0 - begin0);
+            auto const n1 = static_cast<std::ptrdiff_t>(end1 - begin1);
+            std::ptrdiff_t const n = n0 < n1 ? n0 : n1;
+            detail::parallel_for_n(n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+                I0 i0 = begin0 + static_cast<iter_difference_t<I0>>(b);
+                I1 i1 = begin1 + static_cast<iter_difference_t<I1>>(b);
+                O o = out + static_cast<iter_difference_t<O>>(b);
+                for(; b != e; ++b, ++i0, ++i1, ++o)
+                    *o = invoke(fun, invoke(proj0, *i0), invoke(proj1, *i1));
+            });
+            return {begin0 + static_cast<iter_difference_t<I0>>(n),
+                    begin1 + static_cast<iter_difference_t<I1>>(n),
+                    out + static_cast<iter_difference_t<O>>(n)};
+        }
+
+        template<typename I, typename S, typename R, typename P>
+        iter_difference_t<I> parallel_count_if_(I first, S last, R & pred, P & proj,
+                                                std::false_type)
+        {
+            return ranges::count_if(
+                std::move(first), std::move(last), ranges::ref(pred), ranges::ref(proj));
+        }
+        template<typename I, typename S, typename R, typename P>
+        iter_difference_t<I> parallel_count_if_(I first, S last, R & pred, P & proj,
+                                                std::true_type)
+        {
+            std::atomic<std::ptrdiff_t> total{0};
+            detail::parallel_for_n(
+                static_cast<std::ptrdiff_t>(last - first),
+                [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+                    std::ptrdiff_t n = 0;
+                    I i = first + static_cast<iter_difference_t<I>>(b);
+                    for(; b != e; ++b, ++i)
+                        if(invoke(pred, invoke(proj, *i)))
+                            ++n;
+                    total.fetch_add(n, std::memory_order_relaxed);
+                });
+            auto const n = total.load(std::memory_order_relaxed);
+            return static_cast<iter_difference_t<I>>(n);
+        }
+
+        template<typename I, typename S, typename F, typename P>
+        I parallel_find_if_(I first, S last, F & pred, P & proj, std::false_type)
+        {
+            return ranges::find_if(
+                std::move(first), std::move(last), ranges::ref(pred), ranges::ref(proj));
+        }
+        // The chunks publish the position of the first match they find; chunks and
+        // scans past the first published match stop early.
+        template<typename I, typename S, typename F, typename P>
+        I parallel_find_if_(I first, S last, F & pred, P & proj, std::true_type)
+        {
+            auto const n = static_cast<std::ptrdiff_t>(last - first);
+            std::atomic<std::ptrdiff_t> found{n};
+            detail::parallel_for_n(n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+                I i = first + static_cast<iter_difference_t<I>>(b);
+                for(; b != e && b < found.load(std::memory_order_relaxed); ++b, ++i)
+                {
+                    if(invoke(pred, invoke(proj, *i)))
+                    {
+                        std::ptrdiff_t seen = found.load(std::memory_order_relaxed);
+                        while(b < seen && !found.compare_exchange_weak(
+                                              seen, b, std::memory_order_relaxed))
+                            ;
+                        return;
+                    }
+                }
+            });
+            auto const pos = found.load(std::memory_order_relaxed);
+            return first + static_cast<iter_difference_t<I>>(pos);
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-algorithms
+    /// @{
+
+    /// The algorithms that take an execution policy, see ranges::execution, as their
+    /// first argument, like ranges::parallel::for_each(ranges::execution::par, rng,
+    /// fun). They live in their own header so that the sequential algorithms do not
+    /// depend on the thread pool.
+    namespace parallel
+    {
+        RANGES_BEGIN_NIEBLOID(for_each)
+
+            /// \brief function template \c for_each
+            template<typename EP, typename I, typename S, typename F,
+                     typename P = identity>
+            auto RANGES_FUN_NIEBLOID(for_each)(EP &&, I first, S last, F fun,
+                                               P proj = P{}) //
+                ->CPP_ret(for_each_result<I, F>)(            //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_iterator<I> && sentinel_for<S, I> &&
+                    indirectly_unary_invocable<F, projected<I, P>>)
+            {
+                auto last_ =
+                    detail::parallel_for_each_(detail::move(first),
+                                               detail::move(last),
+                                               fun,
+                                               proj,
+                                               detail::execute_in_parallel_<EP, I, S>{});
+                return {detail::move(last_), detail::move(fun)};
+            }
+
+            /// \overload
+            template<typename EP, typename Rng, typename F, typename P = identity>
+            auto RANGES_FUN_NIEBLOID(for_each)(EP && policy, Rng && rng, F fun,
+                                               P proj = P{})
+                ->CPP_ret(for_each_result<safe_iterator_t<Rng>, F>)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_range<Rng> &&
+                    indirectly_unary_invocable<F, projected<iterator_t<Rng>, P>>)
+            {
+                return (*this)(static_cast<EP &&>(policy),
+                               begin(rng),
+                               end(rng),
+                               detail::move(fun),
+                               detail::move(proj));
+            }
+
+        RANGES_END_NIEBLOID(for_each)
+
+        RANGES_BEGIN_NIEBLOID(transform)
+
+            // Single-range variant
+            /// \brief function template \c transform
+            template<typename EP, typename I, typename S, typename O, typename F,
+                     typename P = identity>
+            auto RANGES_FUN_NIEBLOID(transform)(
+                EP &&, I first, S last, O out, F fun, P proj = P{}) //
+                ->CPP_ret(unary_transform_result<I, O>)(            //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_iterator<I> && sentinel_for<S, I> && weakly_incrementable<O> &&
+                    copy_constructible<F> &&
+                    writable<O, indirect_result_t<F &, projected<I, P>>>)
+            {
+                return detail::parallel_transform_(
+                    std::move(first),
+                    std::move(last),
+                    std::move(out),
+                    fun,
+                    proj,
+                    meta::bool_<detail::execute_in_parallel_<EP, I, S>::value &&
+                                random_access_iterator<O>>{});
+            }
+
+            /// \overload
+            template<typename EP, typename Rng, typename O, typename F,
+                     typename P = identity>
+            auto RANGES_FUN_NIEBLOID(transform)(
+                EP && policy, Rng && rng, O out, F fun, P proj = P{})     //
+                ->CPP_ret(unary_transform_result<safe_iterator_t<Rng>, O>)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_range<Rng> && weakly_incrementable<O> &&
+                    copy_constructible<F> &&
+                    writable<O, indirect_result_t<F &, projected<iterator_t<Rng>, P>>>)
+            {
+                return (*this)(static_cast<EP &&>(policy),
+                               begin(rng),
+                               end(rng),
+                               std::move(out),
+                               std::move(fun),
+                               std::move(proj));
+            }
+
+            // Double-range variant
+            /// \overload
+            template<typename EP,
+                     typename I0,
+                     typename S0,
+                     typename I1,
+                     typename S1,
+                     typename O,
+                     typename F,
+                     typename P0 = identity,
+                     typename P1 = identity>
+            auto RANGES_FUN_NIEBLOID(transform)(EP &&,
+                                                I0 begin0,
+                                                S0 end0,
+                                                I1 begin1,
+                                                S1 end1,
+                                                O out,
+                                                F fun,
+                                                P0 proj0 = P0{},
+                                                P1 proj1 = P1{}) //
+                ->CPP_ret(binary_transform_result<I0, I1, O>)(   //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_iterator<I0> && sentinel_for<S0, I0> && input_iterator<I1> &&
+                    sentinel_for<S1, I1> && weakly_incrementable<O> &&
+                    copy_constructible<F> &&
+                    writable<O,
+                             indirect_result_t<F &,
+                                               projected<I0, P0>,
+                                               projected<I1, P1>>>)
+            {
+                return detail::parallel_transform_(
+                    std::move(begin0),
+                    std::move(end0),
+                    std::move(begin1),
+                    std::move(end1),
+                    std::move(out),
+                    fun,
+                    proj0,
+                    proj1,
+                    meta::bool_<detail::execute_in_parallel_<EP, I0, S0>::value &&
+                                random_access_iterator<I1> &&
+                                sized_sentinel_for<S1, I1> &&
+                                random_access_iterator<O>>{});
+            }
+
+            /// \overload
+            template<typename EP,
+                     typename Rng0,
+                     typename Rng1,
+                     typename O,
+                     typename F,
+                     typename P0 = identity,
+                     typename P1 = identity>
+            auto RANGES_FUN_NIEBLOID(transform)(EP && policy,
+                                                Rng0 && rng0,
+                                                Rng1 && rng1,
+                                                O out,
+                                                F fun,
+                                                P0 proj0 = P0{},
+                                                P1 proj1 = P1{}) //
+                ->CPP_ret(binary_transform_result<safe_iterator_t<Rng0>,
+                                                  safe_iterator_t<Rng1>,
+                                                  O>)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_range<Rng0> && input_range<Rng1> && weakly_incrementable<O> &&
+                    copy_constructible<F> &&
+                    writable<O,
+                             indirect_result_t<F &,
+                                               projected<iterator_t<Rng0>, P0>,
+                                               projected<iterator_t<Rng1>, P1>>>)
+            {
+                return (*this)(static_cast<EP &&>(policy),
+                               begin(rng0),
+                               end(rng0),
+                               begin(rng1),
+                               end(rng1),
+                               std::move(out),
+                               std::move(fun),
+                               std::move(proj0),
+                               std::move(proj1));
+            }
+
+        RANGES_END_NIEBLOID(transform)
+
+        RANGES_BEGIN_NIEBLOID(count_if)
+
+            /// \brief function template \c count_if
+            template<typename EP, typename I, typename S, typename R,
+                     typename P = identity>
+            auto RANGES_FUN_NIEBLOID(count_if)(EP &&, I first, S last, R pred,
+                                               P proj = P{})
+                ->CPP_ret(iter_difference_t<I>)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_iterator<I> && sentinel_for<S, I> &&
+                    indirect_unary_predicate<R, projected<I, P>>)
+            {
+                return detail::parallel_count_if_(
+                    std::move(first),
+                    std::move(last),
+                    pred,
+                    proj,
+                    detail::execute_in_parallel_<EP, I, S>{});
+            }
+
+            /// \overload
+            template<typename EP, typename Rng, typename R, typename P = identity>
+            auto RANGES_FUN_NIEBLOID(count_if)(EP && policy, Rng && rng, R pred,
+                                               P proj = P{})
+                ->CPP_ret(iter_difference_t<iterator_t<Rng>>)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_range<Rng> &&
+                    indirect_unary_predicate<R, projected<iterator_t<Rng>, P>>)
+            {
+                return (*this)(static_cast<EP &&>(policy),
+                               begin(rng),
+                               end(rng),
+                               std::move(pred),
+                               std::move(proj));
+            }
+
+        RANGES_END_NIEBLOID(count_if)
+
+        RANGES_BEGIN_NIEBLOID(find_if)
+
+            /// \brief function template \c find_if
+            template<typename EP, typename I, typename S, typename F,
+                     typename P = identity>
+            auto RANGES_FUN_NIEBLOID(find_if)(EP &&, I first, S last, F pred,
+                                              P proj = P{})
+                ->CPP_ret(I)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_iterator<I> && sentinel_for<S, I> &&
+                    indirect_unary_predicate<F, projected<I, P>>)
+            {
+                return detail::parallel_find_if_(
+                    std::move(first),
+                    std::move(last),
+                    pred,
+                    proj,
+                    detail::execute_in_parallel_<EP, I, S>{});
+            }
+
+            /// \overload
+            template<typename EP, typename Rng, typename F, typename P = identity>
+            auto RANGES_FUN_NIEBLOID(find_if)(EP && policy, Rng && rng, F pred,
+                                              P proj = P{})
+                ->CPP_ret(safe_iterator_t<Rng>)( //
+                    requires is_execution_policy<uncvref_t<EP>>::value &&
+                    input_range<Rng> &&
+                    indirect_unary_predicate<F, projected<iterator_t<Rng>, P>>)
+            {
+                return (*this)(static_cast<EP &&>(policy),
+                               begin(rng),
+                               end(rng),
+                               std::move(pred),
+                               std::move(proj));
+            }
+
+        RANGES_END_NIEBLOID(find_if)
+    } // namespace parallel
+    /// @}
+} // namespace ranges
+
+#endif // include guard
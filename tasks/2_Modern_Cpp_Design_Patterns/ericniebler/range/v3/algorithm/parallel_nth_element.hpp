@@ -0,0 +1,237 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2014-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_ALGORITHM_PARALLEL_NTH_ELEMENT_HPP
+#define RANGES_V3_ALGORITHM_PARALLEL_NTH_ELEMENT_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/algorithm/nth_element.hpp>
+#include <range/v3/detail/parallel_invoke.hpp>
+#include <range/v3/functional/comparisons.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/concepts.hpp>
+#include <range/v3/range/dangling.hpp>
+#include <range/v3/range/traits.hpp>
+#include <range/v3/utility/memory.hpp>
+#include <range/v3/utility/static_const.hpp>
+#include <range/v3/utility/swap.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        constexpr std::ptrdiff_t parallel_nth_element_threshold()
+        {
+            return 1 << 16;
+        }
+
+        template<typename I, typename C, typename P>
+        struct select_by_value_
+        {
+            C & pred;
+            P & proj;
+
+            bool operator()(I a, I b) const
+            {
+                return invoke(pred, invoke(proj, *a), invoke(proj, *b));
+            }
+        };
+
+        struct select_counts_
+        {
+            std::ptrdiff_t less = 0, middle = 0, greater = 0;
+        };
+
+        // Selection with two pivots from a sample, as in Floyd and Rivest: they are
+        // the elements a few standard deviations below and above the rank of nth in a
+        // sample of about n^(2/3) elements. The threads count the elements less than
+        // the lower pivot, greater than the upper one and in between in one slice of
+        // the range each, then move them to their parts in a buffer and back. nth
+        // lands in the middle part with high probability, which holds O(n^(5/6))
+        // elements and is left to nth_element.
+        template<typename I, typename C, typename P>
+        void parallel_nth_element_(I first, I nth, std::ptrdiff_t n, std::size_t threads,
+                                   C & pred, P & proj)
+        {
+            using V = iter_value_t<I>;
+            auto const p = detail::get_temporary_buffer<V>(n);
+            std::unique_ptr<V, detail::return_temporary_buffer> const buf{p.first};
+            if(p.second < n)
+            {
+                detail::nth_element_(first, nth, first + n, pred, proj);
+                return;
+            }
+            V * const tmp = p.first;
+
+            // Choose the pivots and swap them to the front, out of the way.
+            std::ptrdiff_t const k = nth - first;
+            double const z = std::log(static_cast<double>(n));
+            auto const s = static_cast<std::ptrdiff_t>(std::exp(2.0 * z / 3.0));
+            auto const d = static_cast<std::ptrdiff_t>(0.5 * std::sqrt(z * s)) + 1;
+            std::vector<I> sample;
+            sample.reserve(static_cast<std::size_t>(s));
+            for(std::ptrdiff_t i = 0; i != s; ++i)
+                sample.push_back(first + i * (n / s));
+            auto const r = static_cast<std::ptrdiff_t>(static_cast<double>(k) * s / n);
+            auto const lo_rank = r - d < 0 ? 0 : r - d;
+            auto const hi_rank = r + d >= s ? s - 1 : r + d;
+            select_by_value_<I, C, P> by_value{pred, proj};
+            identity ident;
+            auto const sbegin = sample.begin();
+            detail::nth_element_(sbegin, sbegin + hi_rank, sample.end(), by_value, ident);
+            detail::nth_element_(sbegin, sbegin + lo_rank, sbegin + hi_rank, by_value,
+                                 ident);
+            I lo = sample[static_cast<std::size_t>(lo_rank)];
+            I hi = sample[static_cast<std::size_t>(hi_rank)];
+            ranges::iter_swap(first, lo);
+            if(hi == first)
+                hi = lo;
+            ranges::iter_swap(first + 1, hi);
+
+            I const rest = first + 2;
+            std::ptrdiff_t const m = n - 2;
+            auto const slice = (m + static_cast<std::ptrdiff_t>(threads) - 1) /
+                               static_cast<std::ptrdiff_t>(threads);
+            auto classify = [&](I i) {
+                auto && x = invoke(proj, *i);
+                return invoke(pred, x, invoke(proj, *first))
+                           ? 0
+                           : invoke(pred, invoke(proj, first[1]), x) ? 2 : 1;
+            };
+            std::vector<select_counts_> counts(threads);
+            auto count = [&](std::size_t t) {
+                std::ptrdiff_t const b = static_cast<std::ptrdiff_t>(t) * slice;
+                std::ptrdiff_t const e = b + slice < m ? b + slice : m;
+                select_counts_ c;
+                for(std::ptrdiff_t i = b; i < e; ++i)
+                {
+                    switch(classify(rest + i))
+                    {
+                    case 0: ++c.less; break;
+                    case 1: ++c.middle; break;
+                    default: ++c.greater; break;
+                    }
+                }
+                counts[t] = c;
+            };
+            detail::parallel_invoke_n(threads, count);
+
+            // Turn the counts into the positions of the slices in the parts.
+            select_counts_ total;
+            for(auto & c : counts)
+            {
+                select_counts_ const here = c;
+                c = total;
+                total.less += here.less;
+                total.middle += here.middle;
+                total.greater += here.greater;
+            }
+            std::ptrdiff_t const nl = total.less, nm = total.middle;
+            auto scatter = [&](std::size_t t) {
+                std::ptrdiff_t const b = static_cast<std::ptrdiff_t>(t) * slice;
+                std::ptrdiff_t const e = b + slice < m ? b + slice : m;
+                std::ptrdiff_t pos[3] = {counts[t].less, nl + counts[t].middle,
+                                         nl + nm + counts[t].greater};
+                for(std::ptrdiff_t i = b; i < e; ++i)
+                {
+                    std::ptrdiff_t & p = pos[classify(rest + i)];
+                    ::new(static_cast<void *>(tmp + p++)) V(iter_move(rest + i));
+                }
+            };
+            detail::parallel_invoke_n(threads, scatter);
+
+            // [less][lower pivot][middle][upper pivot][greater]
+            V lo_val = iter_move(first);
+            V hi_val = iter_move(first + 1);
+            auto gather = [&](std::size_t t) {
+                std::ptrdiff_t const b = static_cast<std::ptrdiff_t>(t) * slice;
+                std::ptrdiff_t const e = b + slice < m ? b + slice : m;
+                for(std::ptrdiff_t i = b; i < e; ++i)
+                {
+                    first[i + (i >= nl) + (i >= nl + nm)] = std::move(tmp[i]);
+                    tmp[i].~V();
+                }
+            };
+            detail::parallel_invoke_n(threads, gather);
+            first[nl] = std::move(lo_val);
+            first[nl + nm + 1] = std::move(hi_val);
+
+            if(k < nl)
+                detail::nth_element_(first, nth, first + nl, pred, proj);
+            else if(k <= nl + nm + 1)
+                detail::nth_element_(first + nl, nth, first + (nl + nm + 2), pred, proj);
+            else
+                detail::nth_element_(first + (nl + nm + 2), nth, first + n, pred, proj);
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-algorithms
+    /// @{
+
+    // Parallel selection on std::thread::hardware_concurrency() threads. Falls back to
+    // nth_element for small ranges or when no buffer for the elements can be
+    // allocated. The comparator, the projection and the element moves must not throw;
+    // otherwise std::terminate is called.
+
+    RANGES_BEGIN_NIEBLOID(parallel_nth_element)
+
+        /// \brief function template \c parallel_nth_element
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto RANGES_FUN_NIEBLOID(parallel_nth_element)(
+            I first, I nth, S end_, C pred = C{}, P proj = P{}) //
+            ->CPP_ret(I)(                                       //
+                requires random_access_iterator<I> && sortable<I, C, P>)
+        {
+            I last = ranges::next(nth, end_);
+            if(nth == last)
+                return last;
+            auto const n = last - first;
+            auto const threads = std::thread::hardware_concurrency();
+            if(n < detail::parallel_nth_element_threshold() || threads <= 1)
+                detail::nth_element_(first, nth, last, pred, proj);
+            else
+                detail::parallel_nth_element_(first, nth, n, threads, pred, proj);
+            return last;
+        }
+
+        /// \overload
+        template<typename Rng, typename C = less, typename P = identity>
+        auto RANGES_FUN_NIEBLOID(parallel_nth_element)(
+            Rng && rng, iterator_t<Rng> nth, C pred = C{}, P proj = P{}) //
+            ->CPP_ret(safe_iterator_t<Rng>)(                             //
+                requires random_access_range<Rng> && sortable<iterator_t<Rng>, C, P>)
+        {
+            return (*this)(
+                begin(rng), std::move(nth), end(rng), std::move(pred), std::move(proj));
+        }
+
+    RANGES_END_NIEBLOID(parallel_nth_element)
+    /// @}
+} // namespace ranges
+
+#endif // include guard
@@ -0,0 +1,244 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_ALGORITHM_PARALLEL_SORT_HPP
+#define RANGES_V3_ALGORITHM_PARALLEL_SORT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/algorithm/sort.hpp>
+#include <range/v3/detail/parallel_invoke.hpp>
+#include <range/v3/functional/comparisons.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/concepts.hpp>
+#include <range/v3/range/dangling.hpp>
+#include <range/v3/range/traits.hpp>
+#include <range/v3/utility/memory.hpp>
+#include <range/v3/utility/static_const.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        constexpr std::ptrdiff_t parallel_sort_threshold()
+        {
+            return 1 << 15;
+        }
+
+        // Number of elements of [a, a + n) among the first d elements of the stable
+        // merge of [a, a + n) and [b, b + m).
+        template<typename I, typename J, typename C, typename P>
+        std::ptrdiff_t merge_path_split(I a, std::ptrdiff_t n, J b, std::ptrdiff_t m,
+                                        std::ptrdiff_t d, C & pred, P & proj)
+        {
+            std::ptrdiff_t lo = d > m ? d - m : 0, hi = d < n ? d : n;
+            while(lo < hi)
+            {
+                std::ptrdiff_t const i = lo + (hi - lo) / 2, j = d - i;
+                if(j == 0 || invoke(pred, invoke(proj, b[j - 1]), invoke(proj, a[i])))
+                    hi = i;
+                else
+                    lo = i + 1;
+            }
+            return lo;
+        }
+
+        template<typename I, typename O, typename C, typename P>
+        O merge_move(I first1, I last1, I first2, I last2, O out, C & pred, P & proj)
+        {
+            for(; first1 != last1 && first2 != last2; ++out)
+            {
+                if(invoke(pred, invoke(proj, *first2), invoke(proj, *first1)))
+                    *out = iter_move(first2++);
+                else
+                    *out = iter_move(first1++);
+            }
+            for(; first1 != last1; ++first1, ++out)
+                *out = iter_move(first1);
+            for(; first2 != last2; ++first2, ++out)
+                *out = iter_move(first2);
+            return out;
+        }
+
+        // Merges the adjacent sorted runs of length width in [src, src + n) pairwise into
+        // dst. The output is split into equal slices, one per thread. The merge path
+        // binary searches that locate the inputs of the slices all run before any
+        // element is moved, as the searches of one slice read elements that another
+        // slice moves.
+        template<typename I, typename O, typename C, typename P>
+        void parallel_merge_runs(I src, O dst, std::ptrdiff_t n, std::ptrdiff_t width,
+                                 std::size_t threads, C & pred, P & proj)
+        {
+            auto const slice = (n + static_cast<std::ptrdiff_t>(threads) - 1) /
+                               static_cast<std::ptrdiff_t>(threads);
+            // Number of elements of the first run of the pair holding pos among the
+            // elements of the pair before pos in the merge.
+            auto split_at = [&](std::ptrdiff_t pos) {
+                std::ptrdiff_t const lo = pos / (2 * width) * (2 * width);
+                std::ptrdiff_t const mid = lo + width < n ? lo + width : n;
+                std::ptrdiff_t const hi = mid + width < n ? mid + width : n;
+                return detail::merge_path_split(
+                    src + lo, mid - lo, src + mid, hi - mid, pos - lo, pred, proj);
+            };
+            std::vector<std::ptrdiff_t> splits(threads + 1, 0);
+            auto find_split = [&](std::size_t t) {
+                std::ptrdiff_t const pos = static_cast<std::ptrdiff_t>(t) * slice;
+                if(pos < n)
+                    splits[t] = split_at(pos);
+            };
+            detail::parallel_invoke_n(threads, find_split);
+
+            auto merge_slice = [&](std::size_t t) {
+                std::ptrdiff_t pos = static_cast<std::ptrdiff_t>(t) * slice;
+                std::ptrdiff_t const end = pos + slice < n ? pos + slice : n;
+                bool first_segment = true;
+                while(pos < end)
+                {
+                    std::ptrdiff_t const lo = pos / (2 * width) * (2 * width);
+                    std::ptrdiff_t const mid = lo + width < n ? lo + width : n;
+                    std::ptrdiff_t const hi = mid + width < n ? mid + width : n;
+                    std::ptrdiff_t const stop = hi < end ? hi : end;
+
+                    // Later segments start at the start of a pair and all but the
+                    // last end at its end, where the split needs no search.
+                    auto const i0 = first_segment ? splits[t] : std::ptrdiff_t{0};
+                    auto const i1 = stop == hi ? mid - lo : splits[t + 1];
+                    detail::merge_move(src + lo + i0,
+                                       src + lo + i1,
+                                       src + mid + (pos - lo - i0),
+                                       src + mid + (stop - lo - i1),
+                                       dst + pos,
+                                       pred,
+                                       proj);
+                    pos = stop;
+                    first_segment = false;
+                }
+            };
+            detail::parallel_invoke_n(threads, merge_slice);
+        }
+
+        // Parallel merge sort: every thread sorts one run with ranges::sort, the runs
+        // are then merged pairwise, ping-ponging between the range and a buffer, with
+        // all threads working on every merge round.
+        template<typename I, typename C, typename P>
+        void parallel_sort_(I first, std::ptrdiff_t n, std::size_t threads, C & pred,
+                            P & proj)
+        {
+            using V = iter_value_t<I>;
+            auto const p = detail::get_temporary_buffer<V>(n);
+            std::unique_ptr<V, detail::return_temporary_buffer> const buf{p.first};
+            if(p.second < n)
+            {
+                detail::sort_(first, first + n, pred, proj, use_radix_sort<I, C, P>{});
+                return;
+            }
+            V * const tmp = p.first;
+
+            auto const width = (n + static_cast<std::ptrdiff_t>(threads) - 1) /
+                               static_cast<std::ptrdiff_t>(threads);
+            auto sort_run = [&](std::size_t t) {
+                std::ptrdiff_t const lo = static_cast<std::ptrdiff_t>(t) * width;
+                std::ptrdiff_t const hi = lo + width < n ? lo + width : n;
+                if(lo >= hi)
+                    return;
+                detail::sort_(
+                    first + lo, first + hi, pred, proj, use_radix_sort<I, C, P>{});
+                for(std::ptrdiff_t i = lo; i != hi; ++i)
+                    ::new(static_cast<void *>(tmp + i)) V(iter_move(first + i));
+            };
+            detail::parallel_invoke_n(threads, sort_run);
+
+            bool in_buf = true;
+            for(std::ptrdiff_t w = width; w < n; w *= 2, in_buf = !in_buf)
+            {
+                if(in_buf)
+                    detail::parallel_merge_runs(tmp, first, n, w, threads, pred, proj);
+                else
+                    detail::parallel_merge_runs(first, tmp, n, w, threads, pred, proj);
+            }
+
+            auto const slice = width;
+            auto finish = [&](std::size_t t) {
+                std::ptrdiff_t const lo = static_cast<std::ptrdiff_t>(t) * slice;
+                std::ptrdiff_t const hi = lo + slice < n ? lo + slice : n;
+                for(std::ptrdiff_t i = lo; i < hi; ++i)
+                {
+                    if(in_buf)
+                        first[i] = std::move(tmp[i]);
+                    tmp[i].~V();
+                }
+            };
+            detail::parallel_invoke_n(threads, finish);
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-algorithms
+    /// @{
+
+    // Parallel merge sort on std::thread::hardware_concurrency() threads. Falls back
+    // to sort for small ranges or when no buffer for the elements can be allocated.
+    // The comparator, the projection and the element moves must not throw; otherwise
+    // std::terminate is called.
+
+    RANGES_BEGIN_NIEBLOID(parallel_sort)
+
+        /// \brief function template \c parallel_sort
+        template<typename I, typename S, typename C = less, typename P = identity>
+        auto RANGES_FUN_NIEBLOID(parallel_sort)(I first, S end_, C pred = C{},
+                                                P proj = P{}) //
+            ->CPP_ret(I)(                                     //
+                requires sortable<I, C, P> && random_access_iterator<I> &&
+                sentinel_for<S, I>)
+        {
+            I last = ranges::next(first, std::move(end_));
+            auto const n = last - first;
+            auto const threads = std::thread::hardware_concurrency();
+            if(n < detail::parallel_sort_threshold() || threads <= 1)
+            {
+                if(first != last)
+                    detail::sort_(
+                        first, last, pred, proj, detail::use_radix_sort<I, C, P>{});
+            }
+            else
+                detail::parallel_sort_(first, n, threads, pred, proj);
+            return last;
+        }
+
+        /// \overload
+        template<typename Rng, typename C = less, typename P = identity>
+        auto RANGES_FUN_NIEBLOID(parallel_sort)(Rng && rng, C pred = C{},
+                                                P proj = P{}) //
+            ->CPP_ret(safe_iterator_t<Rng>)(                  //
+                requires sortable<iterator_t<Rng>, C, P> && random_access_range<Rng>)
+        {
+            return (*this)(begin(rng), end(rng), std::move(pred), std::move(proj));
+        }
+
+    RANGES_END_NIEBLOID(parallel_sort)
+    /// @}
+} // namespace ranges
+
+#endif // include guard
@@ -13,15 +13,20 @@
 #ifndef RANGES_V3_ALGORITHM_PARTIAL_SORT_HPP
 #define RANGES_V3_ALGORITHM_PARTIAL_SORT_HPP
 
+#include <cstddef>
 #include <functional>
+#include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/algorithm/heap_algorithm.hpp>
+#include <range/v3/algorithm/nth_element.hpp>
+#include <range/v3/algorithm/sort.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
 #include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/operations.hpp>
 #include <range/v3/iterator/traits.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/range/concepts.hpp>
@@ -31,6 +36,110 @@
 
 namespace ranges
 {
+    /// \cond
+    namespace detail
+    {
+        // Up to this many elements are kept sorted by insertion instead of in a heap.
+        constexpr std::ptrdiff_t partial_sort_insertion_limit()
+        {
+            return 16;
+        }
+
+        // Up to this fraction of the range the elements are selected in one pass;
+        // beyond, with nth_element followed by a sort.
+        constexpr std::ptrdiff_t partial_sort_scan_ratio()
+        {
+            return 1024;
+        }
+
+        // A pass gives up once this fraction of the elements has been taken in, as on
+        // descending input.
+        constexpr std::ptrdiff_t partial_sort_scan_budget_ratio()
+        {
+            return 16;
+        }
+
+        // The smallest elements are kept sorted in [first, middle); an element less
+        // than the largest of them is inserted, and the largest one goes to its place.
+        // Returns whether the pass finished within the budget.
+        template<typename I, typename C, typename P>
+        bool partial_insertion_select(I first, I middle, I last, std::ptrdiff_t budget,
+                                      C & pred, P & proj)
+        {
+            detail::insertion_sort(first, middle, pred, proj);
+            I const back = middle - 1;
+            for(I i = middle; i != last; ++i)
+            {
+                if(!invoke(pred, invoke(proj, *i), invoke(proj, *back)))
+                    continue;
+                if(budget-- == 0)
+                    return false;
+                iter_value_t<I> val = iter_move(i);
+                *i = iter_move(back);
+                I j = back, k = back;
+                while(j != first && invoke(pred, invoke(proj, val), invoke(proj, *--k)))
+                {
+                    *j = iter_move(k);
+                    j = k;
+                }
+                *j = std::move(val);
+            }
+            return true;
+        }
+
+        // The same with the smallest elements in a heap, which is sorted at the end.
+        template<typename I, typename C, typename P>
+        bool partial_heap_select(I first, I middle, I last, std::ptrdiff_t budget,
+                                 C & pred, P & proj)
+        {
+            make_heap(first, middle, std::ref(pred), std::ref(proj));
+            auto const len = middle - first;
+            for(I i = middle; i != last; ++i)
+            {
+                if(!invoke(pred, invoke(proj, *i), invoke(proj, *first)))
+                    continue;
+                if(budget-- == 0)
+                    return false;
+                ranges::iter_swap(i, first);
+                detail::sift_down_n(first, len, first, std::ref(pred), std::ref(proj));
+            }
+            sort_heap(first, middle, std::ref(pred), std::ref(proj));
+            return true;
+        }
+
+        // Few elements are selected in a single pass, which reads the range and
+        // touches only the elements that are less than the largest one selected so
+        // far: O(n) on random input, but O(n k) or O(n log k) on descending input.
+        // Hence the pass is cut short after n / 16 such elements, and a larger share
+        // of the range is selected with nth_element, which is O(n) anyway, and sorted
+        // afterwards.
+        template<typename I, typename C, typename P>
+        void partial_sort_(I first, I middle, I last, C & pred, P & proj)
+        {
+            auto const len = middle - first;
+            auto const n = last - first;
+            if(len == 0)
+                return;
+            if(len <= n / detail::partial_sort_scan_ratio() ||
+               len <= detail::partial_sort_insertion_limit())
+            {
+                auto const budget = n / detail::partial_sort_scan_budget_ratio();
+                if(len <= detail::partial_sort_insertion_limit()
+                       ? detail::partial_insertion_select(
+                             first, middle, last, budget, pred, proj)
+                       : detail::partial_heap_select(
+                             first, middle, last, budget, pred, proj))
+                    return;
+            }
+            I const back = middle - 1;
+            detail::nth_element_(first, back, last, pred, proj);
+            if(first != back)
+                detail::sort_(
+                    first, back, pred, proj, detail::use_radix_sort<I, C, P>{});
+        }
+    } // namespace detail
+    /// \endcond
+
     /// \addtogroup group-algorithms
     /// @{
     RANGES_BEGIN_NIEBLOID(partial_sort)
@@ -38,25 +147,14 @@ namespace ranges
         /// \brief function template \c partial_sort
         template<typename I, typename S, typename C = less, typename P = identity>
         auto RANGES_FUN_NIEBLOID(partial_sort)(
-            I first, I middle, S last, C pred = C{}, P proj = P{}) //
+            I first, I middle, S end_, C pred = C{}, P proj = P{}) //
             ->CPP_ret(I)(                                          //
                 requires sortable<I, C, P> && random_access_iterator<I> &&
                 sentinel_for<S, I>)
         {
-            make_heap(first, middle, std::ref(pred), std::ref(proj));
-            auto const len = middle - first;
-            I i = middle;
-            for(; i != last; ++i)
-            {
-                if(invoke(pred, invoke(proj, *i), invoke(proj, *first)))
-                {
-                    iter_swap(i, first);
-                    detail::sift_down_n(
-                        first, len, first, std::ref(pred), std::ref(proj));
-                }
-            }
-            sort_heap(first, middle, std::ref(pred), std::ref(proj));
-            return i;
+            I last = ranges::next(middle, std::move(end_));
+            detail::partial_sort_(first, middle, last, pred, proj);
+            return last;
         }
 
         /// \overload
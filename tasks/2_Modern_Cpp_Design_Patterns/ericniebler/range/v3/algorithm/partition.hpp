@@ -21,10 +21,13 @@
 #ifndef RANGES_V3_ALGORITHM_PARTITION_HPP
 #define RANGES_V3_ALGORITHM_PARTITION_HPP
 
+#include <type_traits>
+
 #include <meta/meta.hpp>
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/block_partition.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
 #include <range/v3/iterator/concepts.hpp>
@@ -91,6 +94,37 @@ namespace ranges
                 ++first;
             }
         }
+
+        template<typename I, typename S, typename C, typename P>
+        I partition_random_access_(I first, S last, C & pred, P & proj, std::false_type)
+        {
+            return detail::partition_impl(std::move(first),
+                                          std::move(last),
+                                          pred,
+                                          proj,
+                                          detail::bidirectional_iterator_tag_{});
+        }
+
+        template<typename I, typename S, typename C, typename P>
+        I partition_random_access_(I first, S end_, C & pred, P & proj, std::true_type)
+        {
+            I last = ranges::next(first, std::move(end_));
+            return detail::partition_blocks(
+                std::move(first), std::move(last), pred, proj);
+        }
+
+        // Random-access ranges with arithmetic or pointer keys are partitioned in
+        // blocks, without a branch on the predicate.
+        template<typename I, typename S, typename C, typename P>
+        I partition_impl(I first, S last, C pred, P proj,
+                         detail::random_access_iterator_tag_)
+        {
+            return detail::partition_random_access_(std::move(first),
+                                                    std::move(last),
+                                                    pred,
+                                                    proj,
+                                                    partition_branchless<I, P>{});
+        }
     } // namespace detail
     /// \endcond
 
@@ -14,6 +14,7 @@
 #ifndef RANGES_V3_ALGORITHM_SAMPLE_HPP
 #define RANGES_V3_ALGORITHM_SAMPLE_HPP
 
+#include <cstdint>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
@@ -41,6 +42,41 @@ namespace ranges
     /// \cond
     namespace detail
     {
+        // Draws from [0, n), [0, n - 1), [0, n - 2), ... in turn. With a 64-bit
+        // generator, each output of gen serves two consecutive draws.
+        template<typename Gen, bool Paired = bounded_rand_bits_<Gen>::value == 64>
+        struct countdown_rand
+        {
+            Gen & gen_;
+
+            std::uint64_t operator()(std::uint64_t n)
+            {
+                return detail::bounded_rand(gen_, n);
+            }
+        };
+        template<typename Gen>
+        struct countdown_rand<Gen, true>
+        {
+            Gen & gen_;
+            std::uint64_t next_ = 0;
+            bool has_next_ = false;
+
+            std::uint64_t operator()(std::uint64_t n)
+            {
+                if(has_next_)
+                {
+                    has_next_ = false;
+                    return next_;
+                }
+                if(n < 2 || n > 0xffffffffu)
+                    return detail::bounded_rand(gen_, n);
+                std::uint64_t r;
+                detail::bounded_rand2(gen_, n, n - 1, r, next_);
+                has_next_ = true;
+                return r;
+            }
+        };
+
         template<typename I, typename S, typename O, typename Gen>
         auto sample_sized_impl(I first, S last, iter_difference_t<I> pop_size, O out,
                                iter_difference_t<O> sample_size, Gen && gen)
@@ -48,14 +84,14 @@ namespace ranges
         {
             if(pop_size > 0 && sample_size > 0)
             {
-                std::uniform_int_distribution<iter_difference_t<I>> dist;
-                using param_t = typename decltype(dist)::param_type;
+                countdown_rand<std::remove_reference_t<Gen>> rand{gen};
                 for(; first != last; ++first)
                 {
                     if(sample_size >= pop_size)
                         return copy_n(std::move(first), pop_size, std::move(out));
 
-                    if(dist(gen, param_t{0, --pop_size}) < sample_size)
+                    auto const n = static_cast<std::uint64_t>(pop_size--);
+                    if(rand(n) < static_cast<std::uint64_t>(sample_size))
                     {
                         *out = *first;
                         ++out;
@@ -115,11 +151,9 @@ namespace ranges
                         *next(out, i) = *first;
                     }
 
-                    std::uniform_int_distribution<iter_difference_t<O>> dist;
-                    using param_t = typename decltype(dist)::param_type;
                     for(auto pop_size = n; first != last; (void)++first, ++pop_size)
                     {
-                        auto const i = dist(gen, param_t{0, pop_size});
+                        auto const i = detail::bounded_rand(gen, pop_size + 1);
                         if(i < n)
                             *next(out, i) = *first;
                     }
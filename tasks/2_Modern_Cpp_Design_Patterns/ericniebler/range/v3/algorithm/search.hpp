@@ -21,10 +21,14 @@
 #ifndef RANGES_V3_ALGORITHM_SEARCH_HPP
 #define RANGES_V3_ALGORITHM_SEARCH_HPP
 
+#include <memory>
+#include <utility>
+
 #include <meta/meta.hpp>
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/search.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -98,6 +102,39 @@ namespace ranges
             }
         }
 
+        template<typename I1, typename S1, typename D1, typename I2, typename S2,
+                 typename D2, typename C, typename P1, typename P2>
+        subrange<I1> search_sized_(I1 begin1, S1 end1, D1 d1, I2 begin2, S2 end2, D2 d2,
+                                   C & pred, P1 & proj1, P2 & proj2, std::false_type)
+        {
+            return detail::search_sized_impl(std::move(begin1),
+                                             std::move(end1),
+                                             d1,
+                                             std::move(begin2),
+                                             std::move(end2),
+                                             d2,
+                                             pred,
+                                             proj1,
+                                             proj2);
+        }
+
+        // Contiguous ranges of bytes compared for equality are searched with
+        // detail::search_bytes; the pattern is not empty.
+        template<typename I1, typename S1, typename D1, typename I2, typename S2,
+                 typename D2, typename C, typename P1, typename P2>
+        subrange<I1> search_sized_(I1 begin1, S1, D1 d1, I2 begin2, S2, D2 d2, C &,
+                                   P1 &, P2 &, std::true_type)
+        {
+            if(d1 < d2)
+                return {begin1 + d1, begin1 + d1};
+            auto const pos = detail::search_bytes(
+                reinterpret_cast<search_byte_t const *>(std::addressof(*begin1)), d1,
+                reinterpret_cast<search_byte_t const *>(std::addressof(*begin2)), d2);
+            if(pos < 0)
+                return {begin1 + d1, begin1 + d1};
+            return {begin1 + pos, begin1 + (pos + d2)};
+        }
+
         template<typename I1, typename S1, typename I2, typename S2, typename C,
                  typename P1, typename P2>
         subrange<I1> search_impl(I1 begin1, S1 end1, I2 begin2, S2 end2, C & pred,
@@ -167,15 +204,17 @@ namespace ranges
                 return {begin1, begin1};
             if(RANGES_CONSTEXPR_IF(sized_sentinel_for<S1, I1> &&
                                    sized_sentinel_for<S2, I2>))
-                return detail::search_sized_impl(std::move(begin1),
-                                                 std::move(end1),
-                                                 distance(begin1, end1),
-                                                 std::move(begin2),
-                                                 std::move(end2),
-                                                 distance(begin2, end2),
-                                                 pred,
-                                                 proj1,
-                                                 proj2);
+                return detail::search_sized_(
+                    std::move(begin1),
+                    std::move(end1),
+                    distance(begin1, end1),
+                    std::move(begin2),
+                    std::move(end2),
+                    distance(begin2, end2),
+                    pred,
+                    proj1,
+                    proj2,
+                    detail::search_bytes_<I1, S1, I2, S2, C, P1, P2>{});
             else
                 return detail::search_impl(std::move(begin1),
                                            std::move(end1),
@@ -201,15 +240,19 @@ namespace ranges
             if(empty(rng2))
                 return subrange<iterator_t<Rng1>>{begin(rng1), begin(rng1)};
             if(RANGES_CONSTEXPR_IF(sized_range<Rng1> && sized_range<Rng2>))
-                return detail::search_sized_impl(begin(rng1),
-                                                 end(rng1),
-                                                 distance(rng1),
-                                                 begin(rng2),
-                                                 end(rng2),
-                                                 distance(rng2),
-                                                 pred,
-                                                 proj1,
-                                                 proj2);
+                return detail::search_sized_(
+                    begin(rng1),
+                    end(rng1),
+                    distance(rng1),
+                    begin(rng2),
+                    end(rng2),
+                    distance(rng2),
+                    pred,
+                    proj1,
+                    proj2,
+                    detail::search_bytes_<iterator_t<Rng1>, sentinel_t<Rng1>,
+                                          iterator_t<Rng2>, sentinel_t<Rng2>, C, P1,
+                                          P2>{});
             else
                 return detail::search_impl(
                     begin(rng1), end(rng1), begin(rng2), end(rng2), pred, proj1, proj2);
@@ -27,6 +27,7 @@
 
 #include <range/v3/algorithm/copy.hpp>
 #include <range/v3/algorithm/result_types.hpp>
+#include <range/v3/detail/set_intersection.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -214,22 +215,16 @@ namespace ranges
                 requires sentinel_for<S1, I1> && sentinel_for<S2, I2> &&
                 mergeable<I1, I2, O, C, P1, P2>)
         {
-            while(begin1 != end1 && begin2 != end2)
-            {
-                if(invoke(pred, invoke(proj1, *begin1), invoke(proj2, *begin2)))
-                    ++begin1;
-                else
-                {
-                    if(!invoke(pred, invoke(proj2, *begin2), invoke(proj1, *begin1)))
-                    {
-                        *out = *begin1;
-                        ++out;
-                        ++begin1;
-                    }
-                    ++begin2;
-                }
-            }
-            return out;
+            return detail::set_intersection_(
+                std::move(begin1),
+                std::move(end1),
+                std::move(begin2),
+                std::move(end2),
+                std::move(out),
+                pred,
+                proj1,
+                proj2,
+                detail::set_intersection_tag_t<I1, S1, I2, S2, C, P1, P2>{});
         }
 
         /// \overload
@@ -31,6 +31,61 @@
 
 namespace ranges
 {
+    /// \cond
+    namespace detail
+    {
+        template<typename I, typename S, typename Gen>
+        I shuffle_(I const first, S const last, Gen & gen, std::false_type)
+        {
+            auto mid = first;
+            if(mid == last)
+                return mid;
+            using D1 = iter_difference_t<I>;
+            using D2 = detail::if_then_t<std::is_integral<D1>::value, D1, std::ptrdiff_t>;
+            while(++mid != last)
+            {
+                RANGES_ENSURE(mid - first <= PTRDIFF_MAX);
+                if(auto const i = detail::bounded_rand(gen, D2(mid - first) + 1))
+                    ranges::iter_swap(mid - i, mid);
+            }
+            return mid;
+        }
+
+        // With a 64-bit generator, positions are shuffled in pairs, each pair taking
+        // one output of gen, as long as the product of their bounds fits in 64 bits.
+        template<typename I, typename S, typename Gen>
+        I shuffle_(I const first, S const last, Gen & gen, std::true_type)
+        {
+            auto mid = first;
+            if(mid == last)
+                return mid;
+            using D1 = iter_difference_t<I>;
+            using D2 = detail::if_then_t<std::is_integral<D1>::value, D1, std::ptrdiff_t>;
+            for(++mid; mid != last;)
+            {
+                auto const d = static_cast<std::uint64_t>(mid - first);
+                auto second = mid + 1;
+                if(second == last || d >= 0xfffffffeu)
+                {
+                    RANGES_ENSURE(mid - first <= PTRDIFF_MAX);
+                    if(auto const i = detail::bounded_rand(gen, D2(mid - first) + 1))
+                        ranges::iter_swap(mid - i, mid);
+                    ++mid;
+                    continue;
+                }
+                std::uint64_t i, j;
+                detail::bounded_rand2(gen, d + 1, d + 2, i, j);
+                if(i != 0)
+                    ranges::iter_swap(mid - static_cast<D1>(i), mid);
+                if(j != 0)
+                    ranges::iter_swap(second - static_cast<D1>(j), second);
+                mid = second + 1;
+            }
+            return mid;
+        }
+    } // namespace detail
+    /// \endcond
+
     /// \addtogroup group-algorithms
     /// @{
     RANGES_BEGIN_NIEBLOID(shuffle)
@@ -46,20 +101,8 @@ namespace ranges
                 uniform_random_bit_generator<std::remove_reference_t<Gen>> &&
                 convertible_to<invoke_result_t<Gen &>, iter_difference_t<I>>)
         {
-            auto mid = first;
-            if(mid == last)
-                return mid;
-            using D1 = iter_difference_t<I>;
-            using D2 = detail::if_then_t<std::is_integral<D1>::value, D1, std::ptrdiff_t>;
-            std::uniform_int_distribution<D2> uid{};
-            using param_t = typename decltype(uid)::param_type;
-            while(++mid != last)
-            {
-                RANGES_ENSURE(mid - first <= PTRDIFF_MAX);
-                if(auto const i = uid(gen, param_t{0, D2(mid - first)}))
-                    ranges::iter_swap(mid - i, mid);
-            }
-            return mid;
+            using bits = detail::bounded_rand_bits_<std::remove_reference_t<Gen>>;
+            return detail::shuffle_(first, last, gen, meta::bool_<bits::value == 64>{});
         }
 
         /// \overload
@@ -36,11 +36,25 @@
 #ifndef RANGES_V3_ALGORITHM_SORT_HPP
 #define RANGES_V3_ALGORITHM_SORT_HPP
 
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <meta/meta.hpp>
+
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/algorithm/heap_algorithm.hpp>
+#include <range/v3/algorithm/move.hpp>
 #include <range/v3/algorithm/move_backward.hpp>
-#include <range/v3/algorithm/partial_sort.hpp>
+#include <range/v3/detail/block_partition.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -51,6 +65,7 @@
 #include <range/v3/range/concepts.hpp>
 #include <range/v3/range/dangling.hpp>
 #include <range/v3/range/traits.hpp>
+#include <range/v3/utility/memory.hpp>
 #include <range/v3/utility/static_const.hpp>
 
 namespace ranges
@@ -58,42 +73,6 @@ namespace ranges
     /// \cond
     namespace detail
     {
-        template<typename I, typename C, typename P>
-        inline I unguarded_partition(I first, I last, C & pred, P & proj)
-        {
-            I mid = first + (last - first) / 2, penultimate = ranges::prev(last);
-            auto &&x = *first, &&y = *mid, &&z = *penultimate;
-            auto &&a = invoke(proj, (decltype(x) &&)x),
-                 &&b = invoke(proj, (decltype(y) &&)y),
-                 &&c = invoke(proj, (decltype(z) &&)z);
-
-            // Find the median:
-            I pivot_pnt =
-                invoke(pred, a, b)
-                    ? (invoke(pred, b, c) ? mid
-                                          : (invoke(pred, a, c) ? penultimate : first))
-                    : (invoke(pred, a, c) ? first
-                                          : (invoke(pred, b, c) ? penultimate : mid));
-
-            // Do the partition:
-            while(true)
-            {
-                auto && v = *pivot_pnt;
-                auto && pivot = invoke(proj, (decltype(v) &&)v);
-                while(invoke(pred, invoke(proj, *first), pivot))
-                    ++first;
-                --last;
-                while(invoke(pred, pivot, invoke(proj, *last)))
-                    --last;
-                if(!(first < last))
-                    return first;
-                ranges::iter_swap(first, last);
-                pivot_pnt =
-                    pivot_pnt == first ? last : (pivot_pnt == last ? first : pivot_pnt);
-                ++first;
-            }
-        }
-
         template<typename I, typename C, typename P>
         inline void unguarded_linear_insert(I last, iter_value_t<I> val, C & pred,
                                             P & proj)
@@ -137,56 +116,769 @@ namespace ranges
                 detail::unguarded_linear_insert(i, iter_move(i), pred, proj);
         }
 
-        constexpr int introsort_threshold()
+        template<typename Size>
+        inline Size log2(Size n)
+        {
+            Size k = 0;
+            for(; n != 1; n >>= 1)
+                ++k;
+            return k;
+        }
+
+        // Pattern-defeating quicksort (pdqsort) by Orson Peters: quicksort with a
+        // median-of-3 (ninther for large ranges) pivot, which shuffles the range when
+        // partitions get unbalanced and switches to heapsort after log2(n) bad
+        // partitions. Ranges that turn out to be partitioned already are finished with
+        // a bounded insertion sort, which makes sorted input linear. Equal elements
+        // are gathered in one pass. For cheap comparisons (arithmetic keys) the
+        // partitioning is branchless: the results of the comparisons of a block of
+        // elements are stored as offsets and the misplaced elements swapped afterwards.
+        constexpr std::ptrdiff_t pdqsort_insertion_threshold()
+        {
+            return 24;
+        }
+        constexpr std::ptrdiff_t pdqsort_ninther_threshold()
+        {
+            return 128;
+        }
+        constexpr std::ptrdiff_t pdqsort_partial_insertion_limit()
         {
-            return 16;
+            return 8;
+        }
+        constexpr std::ptrdiff_t pdqsort_block_size()
+        {
+            return 64;
+        }
+
+        template<typename I, typename C, typename P>
+        using sort_branchless = meta::bool_<
+            std::is_arithmetic<uncvref_t<indirect_result_t<P &, I>>>::value ||
+            std::is_pointer<uncvref_t<indirect_result_t<P &, I>>>::value>;
+
+        template<typename C, typename P>
+        struct sort_compare
+        {
+            C & pred;
+            P & proj;
+
+            template<typename A, typename B>
+            bool operator()(A && a, B && b) const
+            {
+                return invoke(pred,
+                              invoke(proj, static_cast<A &&>(a)),
+                              invoke(proj, static_cast<B &&>(b)));
+            }
+        };
+
+        template<typename I, typename C, typename P>
+        inline void sort2(I a, I b, sort_compare<C, P> comp)
+        {
+            if(comp(*b, *a))
+                ranges::iter_swap(a, b);
+        }
+
+        template<typename I, typename C, typename P>
+        inline void sort3(I a, I b, I c, sort_compare<C, P> comp)
+        {
+            detail::sort2(a, b, comp);
+            detail::sort2(b, c, comp);
+            detail::sort2(a, b, comp);
+        }
+
+        // Insertion sort which gives up after moving pdqsort_partial_insertion_limit()
+        // elements. Returns whether the range is sorted.
+        template<typename I, typename C, typename P>
+        inline bool partial_insertion_sort(I first, I last, sort_compare<C, P> comp)
+        {
+            if(first == last)
+                return true;
+
+            std::ptrdiff_t moved = 0;
+            for(I cur = first + 1; cur != last; ++cur)
+            {
+                I sift = cur, sift_1 = cur - 1;
+                if(comp(*sift, *sift_1))
+                {
+                    iter_value_t<I> tmp = iter_move(sift);
+                    do
+                    {
+                        *sift-- = iter_move(sift_1);
+                    } while(sift != first && comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                    moved += cur - sift;
+                }
+                if(moved > detail::pdqsort_partial_insertion_limit())
+                    return false;
+            }
+            return true;
         }
 
+        // Partitions [first, last) around the pivot *first into elements less than the
+        // pivot and elements not less than the pivot. Returns the final position of the
+        // pivot and whether the range was already partitioned. Requires an element not
+        // less than the pivot in the range.
         template<typename I, typename C, typename P>
-        inline void final_insertion_sort(I first, I last, C & pred, P & proj)
+        inline std::pair<I, bool> partition_right(I begin, I end, sort_compare<C, P> comp)
         {
-            if(last - first > detail::introsort_threshold())
+            iter_value_t<I> pivot = iter_move(begin);
+            I first = begin, last = end;
+
+            while(comp(*++first, pivot))
+                ;
+            if(first - 1 == begin)
+                while(first < last && !comp(*--last, pivot))
+                    ;
+            else
+                while(!comp(*--last, pivot))
+                    ;
+
+            bool const already_partitioned = first >= last;
+            while(first < last)
             {
-                detail::insertion_sort(
-                    first, first + detail::introsort_threshold(), pred, proj);
-                detail::unguarded_insertion_sort(
-                    first + detail::introsort_threshold(), last, pred, proj);
+                ranges::iter_swap(first, last);
+                while(comp(*++first, pivot))
+                    ;
+                while(!comp(*--last, pivot))
+                    ;
             }
+
+            I pivot_pos = first - 1;
+            *begin = iter_move(pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        // Branchless variant of partition_right (BlockQuicksort).
+        template<typename I, typename C, typename P>
+        inline std::pair<I, bool> partition_right_branchless(I begin, I end,
+                                                             sort_compare<C, P> comp)
+        {
+            constexpr std::ptrdiff_t block_size = detail::pdqsort_block_size();
+
+            iter_value_t<I> pivot = iter_move(begin);
+            I first = begin, last = end;
+
+            while(comp(*++first, pivot))
+                ;
+            if(first - 1 == begin)
+                while(first < last && !comp(*--last, pivot))
+                    ;
             else
-                detail::insertion_sort(first, last, pred, proj);
+                while(!comp(*--last, pivot))
+                    ;
+
+            bool const already_partitioned = first >= last;
+            if(!already_partitioned)
+            {
+                ranges::iter_swap(first, last);
+                ++first;
+
+                alignas(64) unsigned char offsets_l[block_size];
+                alignas(64) unsigned char offsets_r[block_size];
+                I offsets_l_base = first, offsets_r_base = last;
+                std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+                while(first < last)
+                {
+                    // Fill the offset blocks; the last, partial blocks share the
+                    // remaining elements.
+                    std::ptrdiff_t const num_unknown = last - first;
+                    std::ptrdiff_t const left_split =
+                        num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                    std::ptrdiff_t const right_split =
+                        num_r == 0 ? (num_unknown - left_split) : 0;
+
+                    std::ptrdiff_t const left_block =
+                        left_split < block_size ? left_split : block_size;
+                    for(std::ptrdiff_t i = 0; i < left_block; ++i, ++first)
+                    {
+                        offsets_l[num_l] = static_cast<unsigned char>(i);
+                        num_l += !comp(*first, pivot);
+                    }
+                    std::ptrdiff_t const right_block =
+                        right_split < block_size ? right_split : block_size;
+                    for(std::ptrdiff_t i = 0; i < right_block;)
+                    {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+
+                    // Swap the misplaced elements.
+                    std::ptrdiff_t const num = num_l < num_r ? num_l : num_r;
+                    detail::swap_offsets(offsets_l_base,
+                                         offsets_r_base,
+                                         offsets_l + start_l,
+                                         offsets_r + start_r,
+                                         num,
+                                         num_l == num_r);
+                    num_l -= num;
+                    num_r -= num;
+                    start_l += num;
+                    start_r += num;
+                    if(num_l == 0)
+                    {
+                        start_l = 0;
+                        offsets_l_base = first;
+                    }
+                    if(num_r == 0)
+                    {
+                        start_r = 0;
+                        offsets_r_base = last;
+                    }
+                }
+
+                // Move the remaining misplaced elements to the middle.
+                if(num_l)
+                {
+                    while(num_l--)
+                        ranges::iter_swap(offsets_l_base + offsets_l[start_l + num_l],
+                                          --last);
+                    first = last;
+                }
+                if(num_r)
+                {
+                    while(num_r--)
+                        ranges::iter_swap(offsets_r_base - offsets_r[start_r + num_r],
+                                          first),
+                            ++first;
+                    last = first;
+                }
+            }
+
+            I pivot_pos = first - 1;
+            *begin = iter_move(pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
         }
 
-        template<typename Size>
-        inline Size log2(Size n)
+        template<typename I, typename C, typename P>
+        inline std::pair<I, bool> partition_right_(I first, I last,
+                                                   sort_compare<C, P> comp,
+                                                   std::false_type)
         {
-            Size k = 0;
-            for(; n != 1; n >>= 1)
-                ++k;
-            return k;
+            return detail::partition_right(first, last, comp);
+        }
+        template<typename I, typename C, typename P>
+        inline std::pair<I, bool> partition_right_(I first, I last,
+                                                   sort_compare<C, P> comp,
+                                                   std::true_type)
+        {
+            return detail::partition_right_branchless(first, last, comp);
         }
 
-        template<typename I, typename Size, typename C, typename P>
-        inline void introsort_loop(I first, I last, Size depth_limit, C & pred, P & proj)
+        // Partitions [first, last) around the pivot *first into elements not greater
+        // than the pivot and elements greater than the pivot. Used if the pivot equals
+        // the element before the range: all elements equal to the pivot end up left of
+        // it and need no further sorting.
+        template<typename I, typename C, typename P>
+        inline I partition_left(I begin, I end, sort_compare<C, P> comp)
         {
-            while(last - first > detail::introsort_threshold())
+            iter_value_t<I> pivot = iter_move(begin);
+            I first = begin, last = end;
+
+            while(comp(pivot, *--last))
+                ;
+            if(last + 1 == end)
+                while(first < last && !comp(pivot, *++first))
+                    ;
+            else
+                while(!comp(pivot, *++first))
+                    ;
+
+            while(first < last)
             {
-                if(depth_limit == 0)
-                    return partial_sort(
-                               first, last, last, std::ref(pred), std::ref(proj)),
-                           void();
-                I cut = detail::unguarded_partition(first, last, pred, proj);
-                detail::introsort_loop(cut, last, --depth_limit, pred, proj);
-                last = cut;
+                ranges::iter_swap(first, last);
+                while(comp(pivot, *--last))
+                    ;
+                while(!comp(pivot, *++first))
+                    ;
+            }
+
+            I pivot_pos = last;
+            *begin = iter_move(pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return pivot_pos;
+        }
+
+        template<typename I, typename C, typename P, typename Branchless>
+        void pdqsort_loop(I begin, I end, C & pred, P & proj, int bad_allowed,
+                          bool leftmost, Branchless branchless)
+        {
+            constexpr std::ptrdiff_t insertion_threshold =
+                detail::pdqsort_insertion_threshold();
+            constexpr std::ptrdiff_t ninther_threshold =
+                detail::pdqsort_ninther_threshold();
+            sort_compare<C, P> comp{pred, proj};
+
+            while(true)
+            {
+                std::ptrdiff_t const size = end - begin;
+                if(size < insertion_threshold)
+                {
+                    if(leftmost)
+                        detail::insertion_sort(begin, end, pred, proj);
+                    else
+                        detail::unguarded_insertion_sort(begin, end, pred, proj);
+                    return;
+                }
+
+                // Choose the pivot as median of 3 or pseudomedian of 9 and move it to
+                // the front.
+                std::ptrdiff_t const s2 = size / 2;
+                if(size > ninther_threshold)
+                {
+                    detail::sort3(begin, begin + s2, end - 1, comp);
+                    detail::sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                    detail::sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                    detail::sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                    ranges::iter_swap(begin, begin + s2);
+                }
+                else
+                    detail::sort3(begin + s2, begin, end - 1, comp);
+
+                // If the pivot equals the element before the range (the pivot of an
+                // enclosing partition), the range contains many equal elements. Put
+                // them to the left; they are in their final position already.
+                if(!leftmost && !comp(*(begin - 1), *begin))
+                {
+                    begin = detail::partition_left(begin, end, comp) + 1;
+                    continue;
+                }
+
+                auto const part = detail::partition_right_(begin, end, comp, branchless);
+                I const pivot_pos = part.first;
+                bool const already_partitioned = part.second;
+
+                std::ptrdiff_t const l_size = pivot_pos - begin;
+                std::ptrdiff_t const r_size = end - (pivot_pos + 1);
+                if(l_size < size / 8 || r_size < size / 8)
+                {
+                    // Too many bad partitions: fall back to heapsort.
+                    if(--bad_allowed == 0)
+                    {
+                        make_heap(begin, end, std::ref(pred), std::ref(proj));
+                        sort_heap(begin, end, std::ref(pred), std::ref(proj));
+                        return;
+                    }
+
+                    // Break patterns that may lead to bad pivots.
+                    std::ptrdiff_t const l4 = l_size / 4, r4 = r_size / 4;
+                    if(l_size >= insertion_threshold)
+                    {
+                        ranges::iter_swap(begin, begin + l4);
+                        ranges::iter_swap(pivot_pos - 1, pivot_pos - l4);
+                        if(l_size > ninther_threshold)
+                        {
+                            ranges::iter_swap(begin + 1, begin + (l4 + 1));
+                            ranges::iter_swap(begin + 2, begin + (l4 + 2));
+                            ranges::iter_swap(pivot_pos - 2, pivot_pos - (l4 + 1));
+                            ranges::iter_swap(pivot_pos - 3, pivot_pos - (l4 + 2));
+                        }
+                    }
+                    if(r_size >= insertion_threshold)
+                    {
+                        ranges::iter_swap(pivot_pos + 1, pivot_pos + (1 + r4));
+                        ranges::iter_swap(end - 1, end - r4);
+                        if(r_size > ninther_threshold)
+                        {
+                            ranges::iter_swap(pivot_pos + 2, pivot_pos + (2 + r4));
+                            ranges::iter_swap(pivot_pos + 3, pivot_pos + (3 + r4));
+                            ranges::iter_swap(end - 2, end - (1 + r4));
+                            ranges::iter_swap(end - 3, end - (2 + r4));
+                        }
+                    }
+                }
+                else if(already_partitioned &&
+                        detail::partial_insertion_sort(begin, pivot_pos, comp) &&
+                        detail::partial_insertion_sort(pivot_pos + 1, end, comp))
+                {
+                    // A well-balanced partition without swaps: the range was most
+                    // likely sorted already.
+                    return;
+                }
+
+                // Recurse into the left part, loop on the right part.
+                detail::pdqsort_loop(
+                    begin, pivot_pos, pred, proj, bad_allowed, leftmost, branchless);
+                begin = pivot_pos + 1;
+                leftmost = false;
             }
         }
+
+        // Reverses [first, last) if it is sorted in descending order. Stops at the first
+        // ascending pair, i.e., right away for most inputs.
+        template<typename I, typename C, typename P>
+        inline bool reverse_if_descending(I first, I last, C & pred, P & proj)
+        {
+            sort_compare<C, P> comp{pred, proj};
+            I i = first;
+            for(I next = i + 1; next != last; i = next++)
+            {
+                if(comp(*i, *next))
+                    return false;
+            }
+            for(--last; first < last; ++first, --last)
+                ranges::iter_swap(first, last);
+            return true;
+        }
+
+        template<typename I, typename C, typename P>
+        void pdqsort(I first, I last, C & pred, P & proj)
+        {
+            if(first == last || detail::reverse_if_descending(first, last, pred, proj))
+                return;
+            detail::pdqsort_loop(first,
+                                 last,
+                                 pred,
+                                 proj,
+                                 static_cast<int>(detail::log2(last - first)),
+                                 true,
+                                 sort_branchless<I, C, P>{});
+        }
+
+        // Radix sort. sort uses it instead of pdqsort for trivially copyable elements
+        // that are ordered with less or greater by an arithmetic key, i.e., by the
+        // element itself or by one of its data members.
+        template<typename C>
+        struct radix_sort_order : meta::int_<0>
+        {};
+        template<>
+        struct radix_sort_order<less> : meta::int_<1>
+        {};
+        template<>
+        struct radix_sort_order<std::less<>> : meta::int_<1>
+        {};
+        template<>
+        struct radix_sort_order<greater> : meta::int_<-1>
+        {};
+        template<>
+        struct radix_sort_order<std::greater<>> : meta::int_<-1>
+        {};
+
+        template<typename P>
+        using radix_sort_projection =
+            meta::bool_<std::is_same<P, identity>::value ||
+                        std::is_member_object_pointer<P>::value>;
+
+        template<typename K>
+        using radix_sort_key =
+            meta::bool_<(std::is_integral<K>::value && !std::is_same<K, bool>::value &&
+                         sizeof(K) <= sizeof(std::uint64_t)) ||
+                        (std::is_floating_point<K>::value &&
+                         std::numeric_limits<K>::is_iec559 &&
+                         (sizeof(K) == sizeof(std::uint32_t) ||
+                          sizeof(K) == sizeof(std::uint64_t)))>;
+
+        template<typename I, typename C, typename P, typename = void>
+        struct use_radix_sort : std::false_type
+        {};
+        template<typename I, typename C, typename P>
+        struct use_radix_sort<
+            I, C, P,
+            meta::if_c<radix_sort_order<C>::value != 0 &&
+                       radix_sort_projection<P>::value>>
+          : meta::bool_<
+                radix_sort_key<uncvref_t<indirect_result_t<P &, I>>>::value &&
+                std::is_same<iter_reference_t<I>, iter_value_t<I> &>::value &&
+                std::is_trivially_copyable<iter_value_t<I>>::value &&
+                alignof(iter_value_t<I>) <= alignof(std::max_align_t)>
+        {};
+
+        // Below this size comparison sorting is faster than radix sorting keys with the
+        // given number of bytes.
+        constexpr std::ptrdiff_t radix_sort_threshold(std::size_t digits)
+        {
+            return std::ptrdiff_t(16) << digits;
+        }
+
+        // Maps an arithmetic key to an unsigned integer with the same order.
+        template<typename K>
+        using radix_bits_t = meta::if_c<sizeof(K) <= sizeof(std::uint32_t), std::uint32_t,
+                                        std::uint64_t>;
+
+        template<typename K>
+        radix_bits_t<K> radix_bits(K k, std::true_type /*integral*/) noexcept
+        {
+            using U = meta::_t<std::make_unsigned<K>>;
+            constexpr U sign = std::is_signed<K>::value
+                                   ? static_cast<U>(U(1) << (CHAR_BIT * sizeof(K) - 1))
+                                   : U(0);
+            return static_cast<U>(static_cast<U>(k) ^ sign);
+        }
+        template<typename K>
+        radix_bits_t<K> radix_bits(K k, std::false_type /*floating point*/) noexcept
+        {
+            using U = radix_bits_t<K>;
+            constexpr U sign = U(1) << (CHAR_BIT * sizeof(K) - 1);
+            U u;
+            std::memcpy(&u, &k, sizeof(K));
+            // Negative values: flip all bits; positive values: flip the sign bit.
+            return u ^ ((u & sign) ? ~U(0) : sign);
+        }
+
+        template<typename K, typename P, int Order>
+        struct radix_key_fn
+        {
+            static constexpr std::size_t digits = sizeof(K);
+            P & proj;
+
+            template<typename V>
+            radix_bits_t<K> operator()(V const & v) const noexcept
+            {
+                auto const bits =
+                    detail::radix_bits(K(invoke(proj, v)), std::is_integral<K>{});
+                return Order < 0 ? static_cast<radix_bits_t<K>>(~bits) : bits;
+            }
+        };
+
+        constexpr std::ptrdiff_t radix_sort_msd_threshold()
+        {
+            return 1 << 16;
+        }
+
+        // LSD radix sort over the lowest digits bytes of the keys, one counting pass per
+        // byte, ping-ponging between the range and buf, which holds n constructed
+        // elements. Passes in which all keys share the same byte are skipped.
+        template<typename I, typename V, typename Key>
+        void radix_sort_lsd(I first, std::ptrdiff_t n, V * buf, std::size_t digits,
+                            Key key)
+        {
+            using bits_t = decltype(key(*first));
+
+            std::ptrdiff_t counts[Key::digits][256] = {};
+            for(std::ptrdiff_t i = 0; i != n; ++i)
+            {
+                bits_t const k = key(first[i]);
+                for(std::size_t d = 0; d != digits; ++d)
+                    ++counts[d][(k >> (CHAR_BIT * d)) & 0xFF];
+            }
+
+            bool in_buf = false;
+            for(std::size_t d = 0; d != digits; ++d)
+            {
+                auto & count = counts[d];
+                auto const shift = CHAR_BIT * d;
+                auto const first_digit =
+                    (key(in_buf ? buf[0] : first[0]) >> shift) & 0xFF;
+                if(count[first_digit] == n)
+                    continue;
+
+                std::ptrdiff_t offset = 0;
+                for(auto & c : count)
+                {
+                    auto const tmp = c;
+                    c = offset;
+                    offset += tmp;
+                }
+                if(in_buf)
+                {
+                    for(std::ptrdiff_t i = 0; i != n; ++i)
+                        first[count[(key(buf[i]) >> shift) & 0xFF]++] = std::move(buf[i]);
+                }
+                else
+                {
+                    for(std::ptrdiff_t i = 0; i != n; ++i)
+                        buf[count[(key(first[i]) >> shift) & 0xFF]++] =
+                            std::move(first[i]);
+                }
+                in_buf = !in_buf;
+            }
+            if(in_buf)
+                ranges::move(buf, buf + n, first);
+        }
+
+        // In-place MSD radix sort (American flag sort), for when no buffer is available.
+        template<typename I, typename Key, typename C, typename P>
+        void radix_sort_msd(I first, I last, std::size_t digit, Key key, C & pred,
+                            P & proj)
+        {
+            if(last - first <= detail::pdqsort_insertion_threshold() * 2)
+                return detail::insertion_sort(first, last, pred, proj);
+
+            auto const shift = CHAR_BIT * digit;
+            std::ptrdiff_t head[256] = {}, tail[256];
+            for(I i = first; i != last; ++i)
+                ++head[(key(*i) >> shift) & 0xFF];
+            std::ptrdiff_t offset = 0;
+            for(int b = 0; b != 256; ++b)
+            {
+                offset += head[b];
+                tail[b] = offset;
+                head[b] = offset - head[b];
+            }
+
+            for(int b = 0; b != 256; ++b)
+            {
+                while(head[b] != tail[b])
+                {
+                    auto const d = (key(first[head[b]]) >> shift) & 0xFF;
+                    if(static_cast<int>(d) == b)
+                        ++head[b];
+                    else
+                        ranges::iter_swap(first + head[b], first + head[d]++);
+                }
+            }
+
+            if(digit == 0)
+                return;
+            I bucket = first;
+            for(int b = 0; b != 256; ++b)
+            {
+                I const next = first + tail[b];
+                detail::radix_sort_msd(bucket, next, digit - 1, key, pred, proj);
+                bucket = next;
+            }
+        }
+
+        template<typename I, typename Key>
+        void radix_count(I first, std::ptrdiff_t n, std::size_t shift, Key key,
+                         std::ptrdiff_t (&count)[256])
+        {
+            for(std::ptrdiff_t i = 0; i != n; ++i)
+                ++count[(key(first[i]) >> shift) & 0xFF];
+        }
+
+        template<typename I, typename O, typename Key>
+        void radix_scatter(I first, std::ptrdiff_t n, O out, std::size_t shift, Key key,
+                           std::ptrdiff_t (&offsets)[256])
+        {
+            for(std::ptrdiff_t i = 0; i != n; ++i)
+                out[offsets[(key(first[i]) >> shift) & 0xFF]++] = std::move(first[i]);
+        }
+
+        // MSD radix sort step for large ranges: splits [first, first + n) (or buf, if
+        // in_buf) by the given byte of the keys into the other storage. Buckets that
+        // are still large are split further, the others are sorted by their lower
+        // bytes in the range, i.e., in the cache.
+        template<typename I, typename V, typename Key, typename C, typename P>
+        void radix_sort_split(I first, V * buf, std::ptrdiff_t n, std::size_t digit,
+                              bool in_buf, Key key, C & pred, P & proj)
+        {
+            std::ptrdiff_t offsets[256];
+            while(true)
+            {
+                for(auto & offset : offsets)
+                    offset = 0;
+                if(in_buf)
+                    detail::radix_count(buf, n, CHAR_BIT * digit, key, offsets);
+                else
+                    detail::radix_count(first, n, CHAR_BIT * digit, key, offsets);
+                V const & front = in_buf ? buf[0] : first[0];
+                if(offsets[(key(front) >> (CHAR_BIT * digit)) & 0xFF] != n)
+                    break;
+                if(digit == 0)
+                {
+                    // All keys are equal.
+                    if(in_buf)
+                        ranges::move(buf, buf + n, first);
+                    return;
+                }
+                --digit;
+            }
+
+            std::ptrdiff_t bounds[257];
+            bounds[0] = 0;
+            for(int b = 0; b != 256; ++b)
+            {
+                bounds[b + 1] = bounds[b] + offsets[b];
+                offsets[b] = bounds[b];
+            }
+            if(in_buf)
+                detail::radix_scatter(buf, n, first, CHAR_BIT * digit, key, offsets);
+            else
+                detail::radix_scatter(first, n, buf, CHAR_BIT * digit, key, offsets);
+            in_buf = !in_buf;
+
+            for(int b = 0; b != 256; ++b)
+            {
+                std::ptrdiff_t const lo = bounds[b], size = bounds[b + 1] - lo;
+                if(size >= detail::radix_sort_msd_threshold() && digit > 0)
+                {
+                    detail::radix_sort_split(
+                        first + lo, buf + lo, size, digit - 1, in_buf, key, pred, proj);
+                    continue;
+                }
+                if(in_buf)
+                    ranges::move(buf + lo, buf + lo + size, first + lo);
+                if(digit == 0)
+                    continue;
+                if(size < detail::radix_sort_threshold(digit))
+                    detail::pdqsort(first + lo, first + lo + size, pred, proj);
+                else
+                    detail::radix_sort_lsd(first + lo, size, buf + lo, digit, key);
+            }
+        }
+
+        // Radix sort with a buffer. Large ranges are split by their most significant
+        // bytes (MSD) until the buckets fit into the cache, which are then sorted by
+        // their remaining bytes (LSD). Sorted and reverse sorted input is detected on
+        // the way.
+        template<typename I, typename C, typename P>
+        void radix_sort(I first, I last, C & pred, P & proj)
+        {
+            using V = iter_value_t<I>;
+            using K = uncvref_t<decltype(invoke(proj, *first))>;
+            radix_key_fn<K, P, radix_sort_order<C>::value> key{proj};
+            using bits_t = decltype(key(*first));
+            constexpr std::size_t digits = sizeof(K);
+
+            auto const n = last - first;
+            std::unique_ptr<V, detail::return_temporary_buffer> buf{static_cast<V *>(
+                ::operator new(sizeof(V) * static_cast<std::size_t>(n), std::nothrow))};
+            if(!buf)
+                return detail::radix_sort_msd(first, last, digits - 1, key, pred, proj);
+            V * const tmp = buf.get();
+
+            std::ptrdiff_t ascents = 0, descents = 0;
+            bits_t prev = key(*first);
+            for(std::ptrdiff_t i = 0; i != n; ++i)
+            {
+                ::new(static_cast<void *>(tmp + i)) V(first[i]);
+                bits_t const k = key(tmp[i]);
+                ascents += prev < k;
+                descents += k < prev;
+                prev = k;
+            }
+            if(descents == 0)
+                return;
+            if(ascents == 0)
+            {
+                for(--last; first < last; ++first, --last)
+                    ranges::iter_swap(first, last);
+                return;
+            }
+
+            if(n < detail::radix_sort_msd_threshold())
+                detail::radix_sort_lsd(first, n, tmp, digits, key);
+            else
+                detail::radix_sort_split(
+                    first, tmp, n, digits - 1, true, key, pred, proj);
+        }
+
+        template<typename I, typename C, typename P>
+        void sort_(I first, I last, C & pred, P & proj, std::false_type)
+        {
+            detail::pdqsort(first, last, pred, proj);
+        }
+        template<typename I, typename C, typename P>
+        void sort_(I first, I last, C & pred, P & proj, std::true_type)
+        {
+            using K = uncvref_t<indirect_result_t<P &, I>>;
+            if(last - first < detail::radix_sort_threshold(sizeof(K)))
+                detail::pdqsort(first, last, pred, proj);
+            else
+                detail::radix_sort(first, last, pred, proj);
+        }
     } // namespace detail
     /// \endcond
 
     /// \addtogroup group-algorithms
     /// @{
 
-    // Introsort: Quicksort to a certain depth, then Heapsort. Insertion
-    // sort below a certain threshold.
+    // Pattern-defeating quicksort: Quicksort with branchless partitioning for
+    // arithmetic keys and detection of sorted and reverse sorted input, Heapsort
+    // after too many bad partitions, Insertion sort below a certain threshold.
+    // Radix sort for arithmetic keys that are compared with less or greater.
     // TODO Forward iterators, like EoP?
 
     RANGES_BEGIN_NIEBLOID(sort)
@@ -200,11 +892,7 @@ namespace ranges
         {
             I last = ranges::next(first, std::move(end_));
             if(first != last)
-            {
-                detail::introsort_loop(
-                    first, last, detail::log2(last - first) * 2, pred, proj);
-                detail::final_insertion_sort(first, last, pred, proj);
-            }
+                detail::sort_(first, last, pred, proj, detail::use_radix_sort<I, C, P>{});
             return last;
         }
 
@@ -32,6 +32,7 @@
 #include <range/v3/algorithm/move.hpp>
 #include <range/v3/algorithm/partition_copy.hpp>
 #include <range/v3/algorithm/rotate.hpp>
+#include <range/v3/detail/block_partition.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
 #include <range/v3/iterator/concepts.hpp>
@@ -54,6 +55,84 @@ namespace ranges
     /// \cond
     namespace detail
     {
+        // Whether stable_partition may copy the elements through a buffer of
+        // iter_value_t<I> without branching on the predicate: the range has random
+        // access, the keys are arithmetic or pointers and so are the elements.
+        template<typename I, typename P>
+        using stable_partition_branchless = meta::bool_<
+            partition_branchless<I, P>::value &&
+            same_as<iter_reference_t<I>, iter_value_t<I> &> &&
+            (std::is_arithmetic<iter_value_t<I>>::value ||
+             std::is_pointer<iter_value_t<I>>::value)>;
+
+        // Ranges of up to this many bytes are partitioned through a buffer on the
+        // stack rather than a temporary buffer.
+        constexpr std::ptrdiff_t stable_partition_stack_bytes()
+        {
+            return 4096;
+        }
+
+        // Partitions [first, last] of len elements, where *first is false and *last
+        // is true, through buf, which holds len elements: every element is copied
+        // both to the next slot of the trues, which trails the element read, and to
+        // the next slot of the falses in buf, and the test result advances one of the
+        // two. The falses are moved back behind the trues at the end.
+        template<typename I, typename C, typename P, typename T>
+        I stable_partition_buffered_(I first, I last, C & pred, P & proj, T * buf)
+        {
+            T * out_false = buf;
+            *out_false++ = *first;
+            I out_true = first;
+            for(I i = first + 1; i != last; ++i)
+            {
+                T val = *i;
+                bool const keep = invoke(pred, invoke(proj, val));
+                *out_true = val;
+                *out_false = val;
+                out_true += static_cast<iter_difference_t<I>>(keep);
+                out_false += !keep;
+            }
+            *out_true++ = *last;
+            ranges::move(buf, out_false, out_true);
+            return out_true;
+        }
+
+        template<typename I, typename C, typename P, typename Pair>
+        I stable_partition_buffered_(I first, I last, C pred, P proj, Pair const p,
+                                     std::false_type)
+        {
+            // Move the falses into the temporary buffer, and the trues to the front of
+            // the line Update first to always point to the last of the trues
+            auto tmpbuf = ranges::make_raw_buffer(p.first);
+            auto buf = tmpbuf.begin();
+            *buf = iter_move(first);
+            ++buf;
+            auto res = partition_copy(make_move_iterator(next(first)),
+                                      make_move_sentinel(last),
+                                      first,
+                                      buf,
+                                      std::ref(pred),
+                                      std::ref(proj));
+            first = res.out1;
+            // move *last, known to be true
+            *first = iter_move(res.in);
+            ++first;
+            // All trues now at start of range, all falses in buffer
+            // Move falses back into range, but don't mess up first which points to
+            // first false
+            ranges::move(p.first, res.out2.base().base(), first);
+            // h destructs moved-from values out of the temp buffer, but doesn't
+            // deallocate buffer
+            return first;
+        }
+
+        template<typename I, typename C, typename P, typename Pair>
+        I stable_partition_buffered_(I first, I last, C pred, P proj, Pair const p,
+                                     std::true_type)
+        {
+            return detail::stable_partition_buffered_(first, last, pred, proj, p.first);
+        }
+
         template<typename I, typename C, typename P, typename D, typename Pair>
         I stable_partition_impl(I first, I last, C pred, P proj, D len, Pair const p,
                                 detail::forward_iterator_tag_ fi)
@@ -181,29 +260,8 @@ namespace ranges
             }
             if(len <= p.second)
             { // The buffer is big enough to use
-                // Move the falses into the temporary buffer, and the trues to the front
-                // of the line Update first to always point to the last of the trues
-                auto tmpbuf = ranges::make_raw_buffer(p.first);
-                auto buf = tmpbuf.begin();
-                *buf = iter_move(first);
-                ++buf;
-                auto res = partition_copy(make_move_iterator(next(first)),
-                                          make_move_sentinel(last),
-                                          first,
-                                          buf,
-                                          std::ref(pred),
-                                          std::ref(proj));
-                first = res.out1;
-                // move *last, known to be true
-                *first = iter_move(res.in);
-                ++first;
-                // All trues now at start of range, all falses in buffer
-                // Move falses back into range, but don't mess up first which points to
-                // first false
-                ranges::move(p.first, res.out2.base().base(), first);
-                // h destructs moved-from values out of the temp buffer, but doesn't
-                // deallocate buffer
-                return first;
+                return detail::stable_partition_buffered_(
+                    first, last, pred, proj, p, stable_partition_branchless<I, P>{});
             }
             // Else not enough buffer, do in place
             // len >= 4
@@ -285,6 +343,70 @@ namespace ranges
             std::unique_ptr<value_type, detail::return_temporary_buffer> const h{p.first};
             return detail::stable_partition_impl(first, last, pred, proj, len, p, bi);
         }
+
+        template<typename I, typename S, typename C, typename P>
+        I stable_partition_random_access_(I first, S end_, C pred, P proj,
+                                          std::false_type)
+        {
+            return detail::stable_partition_impl(std::move(first),
+                                                 std::move(end_),
+                                                 pred,
+                                                 proj,
+                                                 detail::bidirectional_iterator_tag_{});
+        }
+
+        template<typename I, typename S, typename C, typename P>
+        I stable_partition_random_access_(I first, S end_, C pred, P proj,
+                                          std::true_type)
+        {
+            using value_type = iter_value_t<I>;
+            constexpr std::ptrdiff_t stack_size =
+                detail::stable_partition_stack_bytes() /
+                static_cast<std::ptrdiff_t>(sizeof(value_type));
+            // Either prove all true and return first or point to first false
+            while(true)
+            {
+                if(first == end_)
+                    return first;
+                if(!invoke(pred, invoke(proj, *first)))
+                    break;
+                ++first;
+            }
+            // Either prove [first, last) is all false and return first, or point last to
+            // last true
+            I last = ranges::next(first, end_);
+            do
+            {
+                if(first == --last)
+                    return first;
+            } while(!invoke(pred, invoke(proj, *last)));
+            // *first is known to be false, *last is known to be true
+            auto len = last - first + 1;
+            if(len <= stack_size)
+            {
+                value_type buf[stack_size];
+                return detail::stable_partition_buffered_(first, last, pred, proj, buf);
+            }
+            // One temporary buffer serves the whole recursion.
+            auto p = detail::get_temporary_buffer<value_type>(len);
+            std::unique_ptr<value_type, detail::return_temporary_buffer> const h{p.first};
+            return detail::stable_partition_impl(
+                first, last, pred, proj, len, p, detail::bidirectional_iterator_tag_{});
+        }
+
+        // Random-access ranges of arithmetic or pointer elements are copied through
+        // a buffer without a branch on the predicate; see stable_partition_buffered_.
+        template<typename I, typename S, typename C, typename P>
+        I stable_partition_impl(I first, S end_, C pred, P proj,
+                                detail::random_access_iterator_tag_)
+        {
+            return detail::stable_partition_random_access_(
+                std::move(first),
+                std::move(end_),
+                std::move(pred),
+                std::move(proj),
+                stable_partition_branchless<I, P>{});
+        }
     } // namespace detail
     /// endcond
 
@@ -0,0 +1,73 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_BLOCK_ITERATION_HPP
+#define RANGES_V3_DETAIL_BLOCK_ITERATION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/traits.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Block iteration protocol. A range whose elements are produced behind an
+        // indirect call (e.g., an input any_view) may opt in by providing
+        //
+        //   using block_value_type = T;
+        //   template<typename Fun> iterator_t<Rng> for_each_block(Fun & fun);
+        //
+        // for_each_block starts a traversal, passes the elements in order to
+        // fun(T * first, std::size_t n) in blocks of one or more elements and returns
+        // the exhausted iterator. The elements of a block may be moved from. Algorithms
+        // that visit every element exactly once use this to pay for the indirection
+        // once per block instead of once per element.
+        template<typename Rng, typename = void>
+        struct has_block_iteration : std::false_type
+        {};
+        template<typename Rng>
+        struct has_block_iteration<Rng,
+                                   meta::void_<typename uncvref_t<Rng>::block_value_type>>
+          : std::true_type
+        {};
+
+        template<typename Rng>
+        using block_value_t = typename uncvref_t<Rng>::block_value_type;
+
+        // The type with which a buffered element is handed to the user; binds like
+        // the range's reference type.
+        template<typename Rng>
+        using block_reference_t = range_reference_t<Rng> &&;
+
+        template<typename Rng, typename Fun, typename Proj>
+        iterator_t<Rng> for_each_in_blocks(Rng & rng, Fun & fun, Proj & proj)
+        {
+            auto block = [&fun, &proj](block_value_t<Rng> * first, std::size_t n) {
+                for(auto last = first + n; first != last; ++first)
+                    invoke(fun,
+                           invoke(proj, static_cast<block_reference_t<Rng>>(*first)));
+            };
+            return rng.for_each_block(block);
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
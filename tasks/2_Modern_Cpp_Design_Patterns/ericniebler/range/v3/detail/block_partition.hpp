@@ -0,0 +1,163 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_BLOCK_PARTITION_HPP
+#define RANGES_V3_DETAIL_BLOCK_PARTITION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/iterator/access.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/utility/swap.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Partitioning in blocks (BlockQuicksort, by Edelkamp and Weiss) first tests a
+        // block of elements at either end of the range and stores the offsets of the
+        // misplaced ones, adding the test results to the counts instead of branching
+        // on them; then it swaps the misplaced elements of both blocks pairwise. With
+        // unpredictable tests this avoids the mispredicted branch per element of the
+        // classic loops, which pays off where the tests are cheap, as for arithmetic
+        // keys.
+        constexpr std::ptrdiff_t partition_block_size()
+        {
+            return 64;
+        }
+
+        template<typename I, typename P>
+        using partition_branchless = meta::bool_<
+            random_access_iterator<I> &&
+            (std::is_arithmetic<uncvref_t<indirect_result_t<P &, I>>>::value ||
+             std::is_pointer<uncvref_t<indirect_result_t<P &, I>>>::value)>;
+
+        // Exchanges the elements first + offsets_l[i] and last - offsets_r[i] for i in
+        // [0, num).
+        template<typename I>
+        inline void swap_offsets(I first, I last, unsigned char const * offsets_l,
+                                 unsigned char const * offsets_r, std::ptrdiff_t num,
+                                 bool use_swaps)
+        {
+            if(use_swaps)
+            {
+                // Needed if the number of misplaced elements on the left and on the
+                // right are equal: the cyclic permutation below would not be valid.
+                for(std::ptrdiff_t i = 0; i < num; ++i)
+                    ranges::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+            }
+            else if(num > 0)
+            {
+                I l = first + offsets_l[0], r = last - offsets_r[0];
+                iter_value_t<I> tmp = iter_move(l);
+                *l = iter_move(r);
+                for(std::ptrdiff_t i = 1; i < num; ++i)
+                {
+                    l = first + offsets_l[i];
+                    *r = iter_move(l);
+                    r = last - offsets_r[i];
+                    *l = iter_move(r);
+                }
+                *r = std::move(tmp);
+            }
+        }
+
+        // Moves the elements of [first, last) that satisfy pred to the front and
+        // returns the end of them, applying pred once to every element.
+        template<typename I, typename C, typename P>
+        I partition_blocks(I first, I last, C & pred, P & proj)
+        {
+            constexpr std::ptrdiff_t block_size = detail::partition_block_size();
+
+            alignas(64) unsigned char offsets_l[block_size];
+            alignas(64) unsigned char offsets_r[block_size];
+            I offsets_l_base = first, offsets_r_base = last;
+            std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+            while(first < last)
+            {
+                // Fill the offset blocks; the last, partial blocks share the remaining
+                // elements.
+                std::ptrdiff_t const num_unknown = last - first;
+                std::ptrdiff_t const left_split =
+                    num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                std::ptrdiff_t const right_split =
+                    num_r == 0 ? (num_unknown - left_split) : 0;
+
+                std::ptrdiff_t const left_block =
+                    left_split < block_size ? left_split : block_size;
+                for(std::ptrdiff_t i = 0; i < left_block; ++i, ++first)
+                {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !invoke(pred, invoke(proj, *first));
+                }
+                std::ptrdiff_t const right_block =
+                    right_split < block_size ? right_split : block_size;
+                for(std::ptrdiff_t i = 0; i < right_block;)
+                {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i);
+                    num_r += static_cast<bool>(invoke(pred, invoke(proj, *--last)));
+                }
+
+                // Swap the misplaced elements.
+                std::ptrdiff_t const num = num_l < num_r ? num_l : num_r;
+                detail::swap_offsets(offsets_l_base,
+                                     offsets_r_base,
+                                     offsets_l + start_l,
+                                     offsets_r + start_r,
+                                     num,
+                                     num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if(num_l == 0)
+                {
+                    start_l = 0;
+                    offsets_l_base = first;
+                }
+                if(num_r == 0)
+                {
+                    start_r = 0;
+                    offsets_r_base = last;
+                }
+            }
+
+            // Move the remaining misplaced elements to the middle.
+            if(num_l)
+            {
+                while(num_l--)
+                    ranges::iter_swap(offsets_l_base + offsets_l[start_l + num_l],
+                                      --last);
+                first = last;
+            }
+            if(num_r)
+            {
+                while(num_r--)
+                    ranges::iter_swap(offsets_r_base - offsets_r[start_r + num_r],
+                                      first),
+                        ++first;
+            }
+            return first;
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
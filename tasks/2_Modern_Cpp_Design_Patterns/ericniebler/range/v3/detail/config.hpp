@@ -523,6 +523,18 @@ namespace ranges
 #define RANGES_NDEBUG_CONSTEXPR inline
 #endif
 
+// RANGES_IS_CONSTANT_EVALUATED() is only defined where the compiler can tell constant
+// evaluation apart, which lets constexpr algorithms call memcmp and friends at run time.
+#ifndef RANGES_IS_CONSTANT_EVALUATED
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define RANGES_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define RANGES_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+
 #ifndef RANGES_CXX_INLINE_VARIABLES
 #ifdef __cpp_inline_variables
 #define RANGES_CXX_INLINE_VARIABLES __cpp_inline_variables
@@ -0,0 +1,152 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_COPY_BYTES_HPP
+#define RANGES_V3_DETAIL_COPY_BYTES_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/traits.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGES_COPY_BYTES_SSE2 1
+#include <emmintrin.h>
+#else
+#define RANGES_COPY_BYTES_SSE2 0
+#endif
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Whether the elements of a contiguous sized range [I, S) may be copied (or,
+        // with Move, moved) to a contiguous O with memmove: the elements are lvalues of
+        // the same trivially copyable type, whose copy (move) assignment is trivial.
+        // The element types are looked at only for contiguous iterators, as O need not
+        // be readable.
+        template<typename I, typename S, typename O, bool Move,
+                 bool = contiguous_iterator<I> && sized_sentinel_for<S, I> &&
+                        contiguous_iterator<O>>
+        struct copy_bytes_ : std::false_type
+        {};
+        template<typename I, typename S, typename O, bool Move>
+        struct copy_bytes_<I, S, O, Move, true>
+          : meta::bool_<
+                same_as<iter_value_t<I>, iter_value_t<O>> &&
+                same_as<iter_reference_t<O>, iter_value_t<O> &> &&
+                (same_as<iter_reference_t<I>, iter_value_t<I> &> ||
+                 same_as<iter_reference_t<I>, iter_value_t<I> const &>) &&
+                std::is_trivially_copyable<iter_value_t<I>>::value &&
+                (Move ? std::is_trivially_move_assignable<iter_value_t<I>>::value
+                      : std::is_trivially_copy_assignable<iter_value_t<I>>::value)>
+        {};
+
+        // Whether a contiguous sized range [O, S) of scalars may be filled with the bytes
+        // of one element: assigning val converts it the same way every time, which holds
+        // for arithmetic types and for val of the element type.
+        template<typename O, typename S, typename V,
+                 bool = contiguous_iterator<O> && sized_sentinel_for<S, O>>
+        struct fill_bytes_ : std::false_type
+        {};
+        template<typename O, typename S, typename V>
+        struct fill_bytes_<O, S, V, true>
+          : meta::bool_<same_as<iter_reference_t<O>, iter_value_t<O> &> &&
+                        std::is_scalar<iter_value_t<O>>::value &&
+                        ((std::is_arithmetic<iter_value_t<O>>::value &&
+                          std::is_arithmetic<V>::value) ||
+                         same_as<iter_value_t<O>, V>)>
+        {};
+
+        // Copies the n elements at first to out, which may overlap.
+        template<typename T>
+        void copy_bytes(T const * first, std::ptrdiff_t n, T * out)
+        {
+            std::memmove(out, first, static_cast<std::size_t>(n) * sizeof(T));
+        }
+
+        template<typename T>
+        bool fill_bytes_repeat_(T const & val)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, std::addressof(val), sizeof(T));
+            for(std::size_t i = 1; i != sizeof(T); ++i)
+                if(bytes[i] != bytes[0])
+                    return false;
+            return true;
+        }
+
+#if RANGES_COPY_BYTES_SSE2
+        // val repeated in 16 bytes, for elements of 1, 2, 4 or 8 bytes.
+        template<typename T>
+        __m128i fill_bytes_broadcast_(T const & val)
+        {
+            unsigned char bytes[16];
+            for(std::size_t i = 0; i != 16; i += sizeof(T))
+                std::memcpy(bytes + i, std::addressof(val), sizeof(T));
+            return _mm_loadu_si128(reinterpret_cast<__m128i const *>(bytes));
+        }
+#endif
+
+        // Stores val to the n elements at out. Values made of a single repeated byte,
+        // like zero, go to memset. Otherwise, for elements of 2, 4 or 8 bytes, SSE2
+        // stores val repeated in 16 bytes, four per iteration; a tail of 16 bytes or
+        // more is written in one store that overlaps the bytes before it.
+        template<typename T>
+        void fill_bytes(T * out, std::ptrdiff_t n, T const & val)
+        {
+            if(detail::fill_bytes_repeat_(val))
+            {
+                unsigned char byte;
+                std::memcpy(&byte, std::addressof(val), 1);
+                std::memset(out, byte, static_cast<std::size_t>(n) * sizeof(T));
+                return;
+            }
+#if RANGES_COPY_BYTES_SSE2
+            if(RANGES_CONSTEXPR_IF(16 % sizeof(T) == 0))
+            {
+                auto const bytes = static_cast<std::size_t>(n) * sizeof(T);
+                if(bytes >= 16)
+                {
+                    __m128i const v = detail::fill_bytes_broadcast_(val);
+                    auto const p = reinterpret_cast<unsigned char *>(out);
+                    std::size_t i = 0;
+                    for(; i + 64 <= bytes; i += 64)
+                    {
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i), v);
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i + 16), v);
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i + 32), v);
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i + 48), v);
+                    }
+                    for(; i + 16 <= bytes; i += 16)
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i), v);
+                    if(i != bytes)
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + bytes - 16), v);
+                    return;
+                }
+            }
+#endif
+            for(; n != 0; --n, ++out)
+                *out = val;
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
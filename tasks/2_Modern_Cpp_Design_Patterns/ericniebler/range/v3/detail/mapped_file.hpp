@@ -0,0 +1,124 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_MAPPED_FILE_HPP
+#define RANGES_V3_DETAIL_MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <system_error>
+
+#include <range/v3/detail/config.hpp>
+
+#ifndef RANGES_HAVE_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define RANGES_HAVE_MMAP 1
+#else
+#define RANGES_HAVE_MMAP 0
+#endif
+#endif
+
+#if RANGES_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // The read-only contents of a file. The file is mapped into memory if mmap is
+        // available and read into memory otherwise. Throws std::system_error if the
+        // file cannot be opened.
+        struct mapped_file
+        {
+            explicit mapped_file(char const * path)
+            {
+#if RANGES_HAVE_MMAP
+                int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+                if(fd == -1)
+                    fail(path);
+                struct ::stat st;
+                if(::fstat(fd, &st) == -1)
+                {
+                    int const err = errno;
+                    ::close(fd);
+                    fail(path, err);
+                }
+                size_ = static_cast<std::size_t>(st.st_size);
+                if(size_ != 0)
+                {
+                    void * const p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if(p == MAP_FAILED)
+                    {
+                        int const err = errno;
+                        ::close(fd);
+                        fail(path, err);
+                    }
+                    (void)::posix_madvise(p, size_, POSIX_MADV_SEQUENTIAL);
+                    data_ = static_cast<char const *>(p);
+                }
+                ::close(fd);
+#else
+                std::ifstream in(path, std::ios::binary | std::ios::ate);
+                if(!in)
+                    fail(path, ENOENT);
+                size_ = static_cast<std::size_t>(in.tellg());
+                buffer_.reset(new char[size_ != 0 ? size_ : 1]);
+                in.seekg(0);
+                if(!in.read(buffer_.get(), static_cast<std::streamsize>(size_)))
+                    fail(path, EIO);
+                data_ = buffer_.get();
+#endif
+            }
+            mapped_file(mapped_file const &) = delete;
+            mapped_file & operator=(mapped_file const &) = delete;
+            ~mapped_file()
+            {
+#if RANGES_HAVE_MMAP
+                if(data_)
+                    ::munmap(const_cast<char *>(data_), size_);
+#endif
+            }
+
+            char const * data() const noexcept
+            {
+                return data_;
+            }
+            std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+        private:
+            [[noreturn]] static void fail(char const * path, int err = errno)
+            {
+                throw std::system_error(err, std::generic_category(), path);
+            }
+
+            char const * data_ = nullptr;
+            std::size_t size_ = 0;
+#if !RANGES_HAVE_MMAP
+            std::unique_ptr<char[]> buffer_;
+#endif
+        };
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
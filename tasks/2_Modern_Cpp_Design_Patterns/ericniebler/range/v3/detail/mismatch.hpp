@@ -0,0 +1,162 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2014-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_MISMATCH_HPP
+#define RANGES_V3_DETAIL_MISMATCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/functional/comparisons.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/traits.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGES_MISMATCH_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define RANGES_MISMATCH_SSE2 0
+#endif
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Types whose values are equal exactly when their object representations are.
+        template<typename T>
+        using mismatch_trivial_ =
+            meta::bool_<std::is_integral<T>::value || std::is_enum<T>::value ||
+                        std::is_pointer<T>::value>;
+
+        template<typename C, typename T>
+        using mismatch_equal_to_ =
+            meta::bool_<same_as<C, equal_to> || same_as<C, std::equal_to<T>> ||
+                        same_as<C, std::equal_to<>>>;
+
+        template<typename C, typename T>
+        using mismatch_less_ =
+            meta::bool_<same_as<C, less> || same_as<C, std::less<T>> ||
+                        same_as<C, std::less<>>>;
+
+        template<typename C, typename T>
+        using mismatch_greater_ =
+            meta::bool_<same_as<C, greater> || same_as<C, std::greater<T>> ||
+                        same_as<C, std::greater<>>>;
+
+        // Whether two ranges may be compared as raw bytes: contiguous sized ranges of
+        // the same trivial type without projections.
+        template<typename I0, typename S0, typename I1, typename S1, typename P0,
+                 typename P1>
+        using mismatch_contiguous_ =
+            meta::bool_<contiguous_iterator<I0> && sized_sentinel_for<S0, I0> &&
+                        contiguous_iterator<I1> && sized_sentinel_for<S1, I1> &&
+                        same_as<iter_value_t<I0>, iter_value_t<I1>> &&
+                        mismatch_trivial_<iter_value_t<I0>>::value &&
+                        same_as<P0, identity> && same_as<P1, identity>>;
+
+        // ... compared with equal_to, for equal and mismatch.
+        template<typename I0, typename S0, typename I1, typename S1, typename C,
+                 typename P0, typename P1>
+        using mismatch_bytes_ =
+            meta::bool_<mismatch_contiguous_<I0, S0, I1, S1, P0, P1>::value &&
+                        mismatch_equal_to_<C, iter_value_t<I0>>::value>;
+
+        // ... ordered with less or greater, for lexicographical_compare. The first
+        // elements that differ decide.
+        template<typename I0, typename S0, typename I1, typename S1, typename C,
+                 typename P0, typename P1>
+        using lexicographical_bytes_ =
+            meta::bool_<mismatch_contiguous_<I0, S0, I1, S1, P0, P1>::value &&
+                        (mismatch_less_<C, iter_value_t<I0>>::value ||
+                         mismatch_greater_<C, iter_value_t<I0>>::value)>;
+
+        // memcmp orders unsigned bytes like less does.
+        template<typename C, typename T>
+        using lexicographical_memcmp_ =
+            meta::bool_<std::is_unsigned<T>::value && sizeof(T) == 1 &&
+                        mismatch_less_<C, T>::value>;
+
+        using mismatch_byte_t = unsigned char;
+
+#if RANGES_MISMATCH_SSE2
+        inline int mismatch_ctz_(unsigned mask)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long i;
+            _BitScanForward(&i, mask);
+            return static_cast<int>(i);
+#else
+            return __builtin_ctz(mask);
+#endif
+        }
+
+        inline __m128i mismatch_eq_(mismatch_byte_t const * x, mismatch_byte_t const * y)
+        {
+            return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(x)),
+                                  _mm_loadu_si128(reinterpret_cast<__m128i const *>(y)));
+        }
+
+        // The bits of the bytes that differ in the 16 at x and y.
+        inline unsigned mismatch_mask_(mismatch_byte_t const * x,
+                                       mismatch_byte_t const * y)
+        {
+            return static_cast<unsigned>(_mm_movemask_epi8(mismatch_eq_(x, y))) ^ 0xFFFFu;
+        }
+#endif
+
+        // The index of the first byte that differs in [x, x + n) and [y, y + n), or n.
+        // With SSE2, 64 bytes are compared per branch; the block that differs is then
+        // searched 16 bytes at a time, and a tail of 16 bytes or more is compared in
+        // one block that overlaps the bytes before it.
+        inline std::size_t mismatch_bytes(mismatch_byte_t const * x,
+                                          mismatch_byte_t const * y, std::size_t n)
+        {
+            std::size_t i = 0;
+#if RANGES_MISMATCH_SSE2
+            for(; i + 64 <= n; i += 64)
+            {
+                __m128i const eq =
+                    _mm_and_si128(_mm_and_si128(mismatch_eq_(x + i, y + i),
+                                                mismatch_eq_(x + i + 16, y + i + 16)),
+                                  _mm_and_si128(mismatch_eq_(x + i + 32, y + i + 32),
+                                                mismatch_eq_(x + i + 48, y + i + 48)));
+                if(_mm_movemask_epi8(eq) != 0xFFFF)
+                    break;
+            }
+            for(; i + 16 <= n; i += 16)
+                if(unsigned const mask = detail::mismatch_mask_(x + i, y + i))
+                    return i + static_cast<std::size_t>(detail::mismatch_ctz_(mask));
+            if(n >= 16)
+            {
+                if(unsigned const mask = detail::mismatch_mask_(x + n - 16, y + n - 16))
+                    return n - 16 + static_cast<std::size_t>(detail::mismatch_ctz_(mask));
+                return n;
+            }
+#endif
+            for(; i != n && x[i] == y[i]; ++i)
+                ;
+            return i;
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
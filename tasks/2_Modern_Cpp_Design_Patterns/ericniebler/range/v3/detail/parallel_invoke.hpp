@@ -0,0 +1,42 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_PARALLEL_INVOKE_HPP
+#define RANGES_V3_DETAIL_PARALLEL_INVOKE_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <range/v3/range_fwd.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Runs fun(0), ..., fun(n - 1) concurrently; fun(0) on the calling thread.
+        template<typename Fun>
+        void parallel_invoke_n(std::size_t n, Fun & fun)
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(n - 1);
+            for(std::size_t t = 1; t < n; ++t)
+                threads.emplace_back([&fun, t] { fun(t); });
+            fun(0);
+            for(auto & thread : threads)
+                thread.join();
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
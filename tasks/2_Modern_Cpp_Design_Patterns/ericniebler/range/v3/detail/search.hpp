@@ -0,0 +1,320 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2014-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_SEARCH_HPP
+#define RANGES_V3_DETAIL_SEARCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/functional/comparisons.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/traits.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGES_SEARCH_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define RANGES_SEARCH_SSE2 0
+#endif
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Whether search may compare raw bytes: contiguous sized ranges of the same
+        // byte-sized integral type, compared with equal_to and without projections.
+        template<typename C, typename T>
+        using search_equal_to_ =
+            meta::bool_<same_as<C, equal_to> || same_as<C, std::equal_to<T>> ||
+                        same_as<C, std::equal_to<>>>;
+
+        template<typename I1, typename S1, typename I2, typename S2, typename C,
+                 typename P1, typename P2>
+        using search_bytes_ =
+            meta::bool_<contiguous_iterator<I1> && sized_sentinel_for<S1, I1> &&
+                        contiguous_iterator<I2> && sized_sentinel_for<S2, I2> &&
+                        same_as<iter_value_t<I1>, iter_value_t<I2>> &&
+                        std::is_integral<iter_value_t<I1>>::value &&
+                        sizeof(iter_value_t<I1>) == 1 &&
+                        !same_as<iter_value_t<I1>, bool> &&
+                        search_equal_to_<C, iter_value_t<I1>>::value &&
+                        same_as<P1, identity> && same_as<P2, identity>>;
+
+        using search_byte_t = unsigned char;
+
+        // Patterns shorter than this are found with the SSE2 filter, longer ones
+        // with Horspool's shifts.
+        constexpr std::ptrdiff_t search_horspool_length()
+        {
+            return 64;
+        }
+
+        // Compares the m bytes at x and y and charges the compared bytes to work.
+        inline bool search_verify_(search_byte_t const * x, search_byte_t const * y,
+                                   std::ptrdiff_t m, std::ptrdiff_t & work)
+        {
+            std::ptrdiff_t i = 0;
+            while(i != m && x[i] == y[i])
+                ++i;
+            work += i + 1;
+            return i == m;
+        }
+
+        // The filters below verify candidates byte by byte, which takes O(n m) time
+        // on inputs like a^n and a^(m-1) b. Once the bytes compared exceed twice the
+        // bytes passed (plus some slack), they hand the rest of the text over to the
+        // two-way algorithm, which is linear in the worst case.
+        inline bool search_over_budget_(std::ptrdiff_t work, std::ptrdiff_t passed)
+        {
+            return work > 2 * passed + 1024;
+        }
+
+        // The position of the maximal suffix of [x, x + m) under the byte order or,
+        // with Reverse, under the reverse order, minus one; stores its period in per.
+        template<bool Reverse>
+        std::ptrdiff_t search_maximal_suffix_(search_byte_t const * x, std::ptrdiff_t m,
+                                              std::ptrdiff_t & per)
+        {
+            std::ptrdiff_t ms = -1, j = 0, k = 1;
+            per = 1;
+            while(j + k < m)
+            {
+                search_byte_t const a = x[j + k], b = x[ms + k];
+                if(Reverse ? b < a : a < b)
+                {
+                    j += k;
+                    k = 1;
+                    per = j - ms;
+                }
+                else if(a == b)
+                {
+                    if(k != per)
+                        ++k;
+                    else
+                    {
+                        j += per;
+                        k = 1;
+                    }
+                }
+                else
+                {
+                    ms = j++;
+                    k = per = 1;
+                }
+            }
+            return ms;
+        }
+
+        // The first occurrence of [p, p + m) in [h, h + n), or -1, by the two-way
+        // algorithm of Crochemore and Perrin: the pattern is split at a critical
+        // factorization, the right part is matched left to right and the left part
+        // right to left, and mismatches shift by the period or past the right part.
+        // O(n + m) time and constant space.
+        inline std::ptrdiff_t search_two_way_(search_byte_t const * h, std::ptrdiff_t n,
+                                              search_byte_t const * p, std::ptrdiff_t m)
+        {
+            std::ptrdiff_t p1, p2;
+            std::ptrdiff_t const i1 = detail::search_maximal_suffix_<false>(p, m, p1);
+            std::ptrdiff_t const i2 = detail::search_maximal_suffix_<true>(p, m, p2);
+            std::ptrdiff_t const ell = i1 > i2 ? i1 : i2;
+            std::ptrdiff_t per = i1 > i2 ? p1 : p2;
+            if(std::memcmp(p, p + per, static_cast<std::size_t>(ell + 1)) == 0)
+            {
+                // Periodic pattern: remember the prefix matched by the last shift.
+                std::ptrdiff_t memory = -1;
+                for(std::ptrdiff_t j = 0; j <= n - m;)
+                {
+                    std::ptrdiff_t i = (ell > memory ? ell : memory) + 1;
+                    while(i < m && p[i] == h[i + j])
+                        ++i;
+                    if(i < m)
+                    {
+                        j += i - ell;
+                        memory = -1;
+                        continue;
+                    }
+                    i = ell;
+                    while(i > memory && p[i] == h[i + j])
+                        --i;
+                    if(i <= memory)
+                        return j;
+                    j += per;
+                    memory = m - per - 1;
+                }
+            }
+            else
+            {
+                per = (ell + 1 > m - ell - 1 ? ell + 1 : m - ell - 1) + 1;
+                for(std::ptrdiff_t j = 0; j <= n - m;)
+                {
+                    std::ptrdiff_t i = ell + 1;
+                    while(i < m && p[i] == h[i + j])
+                        ++i;
+                    if(i < m)
+                    {
+                        j += i - ell;
+                        continue;
+                    }
+                    i = ell;
+                    while(i >= 0 && p[i] == h[i + j])
+                        --i;
+                    if(i < 0)
+                        return j;
+                    j += per;
+                }
+            }
+            return -1;
+        }
+
+        // Continues a search at position j with the two-way algorithm.
+        inline std::ptrdiff_t search_two_way_from_(search_byte_t const * h,
+                                                   std::ptrdiff_t n, std::ptrdiff_t j,
+                                                   search_byte_t const * p,
+                                                   std::ptrdiff_t m)
+        {
+            if(n - j < m)
+                return -1;
+            auto const pos = detail::search_two_way_(h + j, n - j, p, m);
+            return pos < 0 ? -1 : j + pos;
+        }
+
+        // Horspool's simplification of Boyer-Moore, on pairs of bytes: the window is
+        // shifted by the distance of its last two bytes to their last occurrence in
+        // the pattern. With single bytes the shifts of a long pattern over a small
+        // alphabet would stay short, as every byte occurs close to its end. The pairs
+        // are hashed into 4096 entries, which keeps the table small enough to build
+        // for every search; a collision only shortens a shift.
+        inline std::size_t search_pair_hash_(search_byte_t a, search_byte_t b)
+        {
+            return ((std::size_t{a} << 5) ^ b) & 4095u;
+        }
+
+        // For m > 1.
+        inline std::ptrdiff_t search_horspool_(search_byte_t const * h, std::ptrdiff_t n,
+                                               search_byte_t const * p, std::ptrdiff_t m)
+        {
+            using shift_t = std::uint16_t;
+            auto const limit =
+                static_cast<std::ptrdiff_t>(std::numeric_limits<shift_t>::max());
+            auto const cap = [limit](std::ptrdiff_t s) {
+                return static_cast<shift_t>(s < limit ? s : limit);
+            };
+            shift_t shift[4096];
+            for(auto & s : shift)
+                s = cap(m - 1);
+            for(std::ptrdiff_t i = 0; i < m - 2; ++i)
+                shift[detail::search_pair_hash_(p[i], p[i + 1])] = cap(m - 2 - i);
+            auto const last = detail::search_pair_hash_(p[m - 2], p[m - 1]);
+            std::ptrdiff_t const skip = shift[last];
+            shift[last] = 0;
+
+            std::ptrdiff_t work = 0;
+            for(std::ptrdiff_t j = 0; j <= n - m;)
+            {
+                std::ptrdiff_t const s =
+                    shift[detail::search_pair_hash_(h[j + m - 2], h[j + m - 1])];
+                if(s != 0)
+                {
+                    j += s;
+                    continue;
+                }
+                if(detail::search_verify_(h + j, p, m, work))
+                    return j;
+                j += skip;
+                if(detail::search_over_budget_(work, j))
+                    return detail::search_two_way_from_(h, n, j, p, m);
+            }
+            return -1;
+        }
+
+#if RANGES_SEARCH_SSE2
+        inline int search_ctz_(unsigned mask)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long i;
+            _BitScanForward(&i, mask);
+            return static_cast<int>(i);
+#else
+            return __builtin_ctz(mask);
+#endif
+        }
+
+        // Compares the first and the last byte of the pattern with the text at 16
+        // window positions at a time (Mula, "SIMD-friendly algorithms for substring
+        // searching") and verifies only the windows where both match.
+        inline std::ptrdiff_t search_sse2_(search_byte_t const * h, std::ptrdiff_t n,
+                                           search_byte_t const * p, std::ptrdiff_t m)
+        {
+            __m128i const first = _mm_set1_epi8(static_cast<char>(p[0]));
+            __m128i const last = _mm_set1_epi8(static_cast<char>(p[m - 1]));
+            std::ptrdiff_t work = 0;
+            std::ptrdiff_t j = 0;
+            for(; j + 16 + m - 1 <= n; j += 16)
+            {
+                __m128i const b0 =
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(h + j));
+                __m128i const b1 =
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(h + j + m - 1));
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(first, b0), _mm_cmpeq_epi8(last, b1))));
+                for(; mask != 0; mask &= mask - 1)
+                {
+                    auto const k = j + detail::search_ctz_(mask);
+                    if(detail::search_verify_(h + k + 1, p + 1, m - 2, work))
+                        return k;
+                }
+                if(detail::search_over_budget_(work, j))
+                    return detail::search_two_way_from_(h, n, j + 16, p, m);
+            }
+            for(; j <= n - m; ++j)
+                if(h[j] == p[0] && h[j + m - 1] == p[m - 1] &&
+                   detail::search_verify_(h + j + 1, p + 1, m - 2, work))
+                    return j;
+            return -1;
+        }
+#endif
+
+        // The first occurrence of [p, p + m) in [h, h + n) for m > 0, or -1.
+        inline std::ptrdiff_t search_bytes(search_byte_t const * h, std::ptrdiff_t n,
+                                           search_byte_t const * p, std::ptrdiff_t m)
+        {
+            if(n < m)
+                return -1;
+            if(m == 1)
+            {
+                auto const q = std::memchr(h, p[0], static_cast<std::size_t>(n));
+                return q ? static_cast<search_byte_t const *>(q) - h : -1;
+            }
+#if RANGES_SEARCH_SSE2
+            if(m < search_horspool_length())
+                return detail::search_sse2_(h, n, p, m);
+#endif
+            return detail::search_horspool_(h, n, p, m);
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
@@ -0,0 +1,118 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_SEGMENTED_ITERATION_HPP
+#define RANGES_V3_DETAIL_SEGMENTED_ITERATION_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/detail/block_iteration.hpp>
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/traits.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Segmented iteration protocol (Austern, "Segmented Iterators and
+        // Hierarchical Algorithms"). A range whose elements are stored in a sequence
+        // of underlying ranges (e.g., concat_view or join_view) may opt in by
+        // providing
+        //
+        //   template<typename Fun> iterator_t<Rng> for_each_segment(Fun & fun);
+        //
+        // for_each_segment starts a traversal, passes the underlying ranges in order
+        // to fun(Seg & segment), which returns the iterator_t<Seg> at which it
+        // stopped, i.e., the end of the segment, and returns the exhausted iterator.
+        // Algorithms that visit every element exactly once use this to run a plain
+        // loop over each segment instead of dispatching on the position in every
+        // increment and dereference. Segments may be segmented themselves.
+        struct segment_probe_
+        {
+            template<typename Seg>
+            iterator_t<Seg> operator()(Seg &) const;
+        };
+
+        template<typename Rng, typename = void>
+        struct has_segmented_iteration : std::false_type
+        {};
+        template<typename Rng>
+        struct has_segmented_iteration<
+            Rng, meta::void_<decltype(std::declval<Rng &>().for_each_segment(
+                     std::declval<segment_probe_ &>()))>> : std::true_type
+        {};
+
+        // How an algorithm traverses a whole range: in segments, in blocks
+        // (std::true_type) or element by element (std::false_type).
+        struct segmented_tag
+        {};
+        template<typename Rng>
+        using traversal_tag_t = meta::if_<has_segmented_iteration<Rng>, segmented_tag,
+                                          has_block_iteration<Rng>>;
+
+        // Descends into nested segmented ranges and calls leaf(segment) on every
+        // segment that is not segmented itself.
+        template<typename Leaf>
+        struct segment_visitor
+        {
+            Leaf & leaf_;
+
+            template<typename Seg>
+            iterator_t<Seg> operator()(Seg & seg)
+            {
+                return visit_(seg, has_segmented_iteration<Seg>{});
+            }
+
+        private:
+            template<typename Seg>
+            iterator_t<Seg> visit_(Seg & seg, std::true_type)
+            {
+                return seg.for_each_segment(*this);
+            }
+            template<typename Seg>
+            iterator_t<Seg> visit_(Seg & seg, std::false_type)
+            {
+                return leaf_(seg);
+            }
+        };
+
+        template<typename Rng, typename Leaf>
+        iterator_t<Rng> for_each_leaf_segment(Rng & rng, Leaf & leaf)
+        {
+            segment_visitor<Leaf> visitor{leaf};
+            return rng.for_each_segment(visitor);
+        }
+
+        template<typename Rng, typename Fun, typename Proj>
+        iterator_t<Rng> for_each_in_segments(Rng & rng, Fun & fun, Proj & proj)
+        {
+            auto leaf = [&fun, &proj](auto & seg) {
+                auto first = ranges::begin(seg);
+                auto const last = ranges::end(seg);
+                for(; first != last; ++first)
+                    invoke(fun,
+                           invoke(proj, static_cast<range_reference_t<Rng>>(*first)));
+                return first;
+            };
+            return detail::for_each_leaf_segment(rng, leaf);
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
@@ -0,0 +1,268 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2014-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_SET_INTERSECTION_HPP
+#define RANGES_V3_DETAIL_SET_INTERSECTION_HPP
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/functional/comparisons.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/traits.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGES_SET_INTERSECTION_SSE2 1
+#include <emmintrin.h>
+#else
+#define RANGES_SET_INTERSECTION_SSE2 0
+#endif
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // The first position in [first, first + n) at which !pred(proj(*i), val).
+        // Probes at exponentially growing distances from first and bisects the last
+        // step, which takes O(log k) comparisons if the position is k elements away.
+        template<typename I, typename V, typename C, typename P>
+        I gallop_lower_bound_n(I first, iter_difference_t<I> n, V const & val, C & pred,
+                               P & proj)
+        {
+            iter_difference_t<I> step = 1;
+            while(step <= n && invoke(pred, invoke(proj, first[step - 1]), val))
+            {
+                first += step;
+                n -= step;
+                step *= 2;
+            }
+            if(step <= n)
+                n = step - 1;
+            while(n != 0)
+            {
+                auto const half = n / 2;
+                auto middle = first + half;
+                if(invoke(pred, invoke(proj, *middle), val))
+                {
+                    first = ++middle;
+                    n -= half + 1;
+                }
+                else
+                    n = half;
+            }
+            return first;
+        }
+
+        // Galloping pays off once one input is this many times longer than the other.
+        constexpr std::ptrdiff_t set_intersection_gallop_ratio()
+        {
+            return 16;
+        }
+
+        // How set_intersection traverses its inputs: by a linear merge (std::false_type),
+        // adaptively for random-access inputs of known size (std::true_type), or in
+        // addition with SSE2 block comparisons for contiguous 32-bit integers.
+        struct set_intersection_sse2_tag
+        {};
+
+        template<typename I1, typename S1, typename I2, typename S2>
+        using set_intersection_sized_ =
+            meta::bool_<random_access_iterator<I1> && sized_sentinel_for<S1, I1> &&
+                        random_access_iterator<I2> && sized_sentinel_for<S2, I2>>;
+
+        template<typename C, typename T>
+        using set_intersection_less_ =
+            meta::bool_<same_as<C, less> || same_as<C, std::less<T>> ||
+                        same_as<C, std::less<>>>;
+
+        template<typename I1, typename S1, typename I2, typename S2, typename C,
+                 typename P1, typename P2>
+        using set_intersection_tag_t = meta::if_c<
+            RANGES_SET_INTERSECTION_SSE2 && contiguous_iterator<I1> &&
+                contiguous_iterator<I2> && sized_sentinel_for<S1, I1> &&
+                sized_sentinel_for<S2, I2> &&
+                same_as<iter_value_t<I1>, iter_value_t<I2>> &&
+                std::is_integral<iter_value_t<I1>>::value &&
+                sizeof(iter_value_t<I1>) == 4 &&
+                set_intersection_less_<C, iter_value_t<I1>>::value &&
+                same_as<P1, identity> && same_as<P2, identity>,
+            set_intersection_sse2_tag, set_intersection_sized_<I1, S1, I2, S2>>;
+
+        template<typename I1, typename S1, typename I2, typename S2, typename O,
+                 typename C, typename P1, typename P2>
+        O set_intersection_(I1 begin1, S1 end1, I2 begin2, S2 end2, O out, C & pred,
+                            P1 & proj1, P2 & proj2, std::false_type)
+        {
+            while(begin1 != end1 && begin2 != end2)
+            {
+                if(invoke(pred, invoke(proj1, *begin1), invoke(proj2, *begin2)))
+                    ++begin1;
+                else
+                {
+                    if(!invoke(pred, invoke(proj2, *begin2), invoke(proj1, *begin1)))
+                    {
+                        *out = *begin1;
+                        ++out;
+                        ++begin1;
+                    }
+                    ++begin2;
+                }
+            }
+            return out;
+        }
+
+        // Looks up each element of the shorter input in the longer one by galloping
+        // from the previous match. Emits the same elements as the linear merge.
+        template<typename I1, typename I2, typename O, typename C, typename P1,
+                 typename P2>
+        O set_intersection_gallop_(I1 begin1, iter_difference_t<I1> n1, I2 begin2,
+                                   iter_difference_t<I2> n2, O out, C & pred,
+                                   P1 & proj1, P2 & proj2)
+        {
+            if(n1 <= n2)
+            {
+                for(auto const end1 = begin1 + n1; begin1 != end1 && n2 != 0; ++begin1)
+                {
+                    auto && val = invoke(proj1, *begin1);
+                    auto const pos = detail::gallop_lower_bound_n(begin2, n2, val, pred,
+                                                                  proj2);
+                    n2 -= pos - begin2;
+                    begin2 = pos;
+                    if(n2 != 0 && !invoke(pred, val, invoke(proj2, *begin2)))
+                    {
+                        *out = *begin1;
+                        ++out;
+                        ++begin2;
+                        --n2;
+                    }
+                }
+            }
+            else
+            {
+                for(auto const end2 = begin2 + n2; begin2 != end2 && n1 != 0; ++begin2)
+                {
+                    auto && val = invoke(proj2, *begin2);
+                    auto const pos = detail::gallop_lower_bound_n(begin1, n1, val, pred,
+                                                                  proj1);
+                    n1 -= pos - begin1;
+                    begin1 = pos;
+                    if(n1 != 0 && !invoke(pred, val, invoke(proj1, *begin1)))
+                    {
+                        *out = *begin1;
+                        ++out;
+                        ++begin1;
+                        --n1;
+                    }
+                }
+            }
+            return out;
+        }
+
+        template<typename I1, typename S1, typename I2, typename S2, typename O,
+                 typename C, typename P1, typename P2>
+        O set_intersection_(I1 begin1, S1 end1, I2 begin2, S2 end2, O out, C & pred,
+                            P1 & proj1, P2 & proj2, std::true_type)
+        {
+            auto const n1 = end1 - begin1;
+            auto const n2 = end2 - begin2;
+            if(n1 / set_intersection_gallop_ratio() >= n2 ||
+               n2 / set_intersection_gallop_ratio() >= n1)
+                return detail::set_intersection_gallop_(
+                    std::move(begin1), n1, std::move(begin2), n2, std::move(out), pred,
+                    proj1, proj2);
+            return detail::set_intersection_(std::move(begin1), std::move(end1),
+                                             std::move(begin2), std::move(end2),
+                                             std::move(out), pred, proj1, proj2,
+                                             std::false_type{});
+        }
+
+#if RANGES_SET_INTERSECTION_SSE2
+        // Compares blocks of four elements of either input all-against-all. Since both
+        // inputs are sorted, a pair of blocks without a common element lets the block
+        // with the smaller last element be skipped as a whole. Blocks with a common
+        // element are merged element by element until one of them is exhausted, which
+        // keeps the multiset semantics of the linear merge for repeated elements.
+        template<typename I1, typename S1, typename I2, typename S2, typename O,
+                 typename C, typename P1, typename P2>
+        O set_intersection_(I1 begin1, S1 end1, I2 begin2, S2 end2, O out, C & pred,
+                            P1 & proj1, P2 & proj2, set_intersection_sse2_tag)
+        {
+            using T = iter_value_t<I1>;
+            auto const n1 = end1 - begin1;
+            auto const n2 = end2 - begin2;
+            if(n1 < 4 || n2 < 4 || n1 / set_intersection_gallop_ratio() >= n2 ||
+               n2 / set_intersection_gallop_ratio() >= n1)
+                return detail::set_intersection_(std::move(begin1), std::move(end1),
+                                                 std::move(begin2), std::move(end2),
+                                                 std::move(out), pred, proj1, proj2,
+                                                 std::true_type{});
+            T const * const a = std::addressof(*begin1);
+            T const * const b = std::addressof(*begin2);
+            iter_difference_t<I1> i = 0;
+            iter_difference_t<I2> j = 0;
+            while(i + 4 <= n1 && j + 4 <= n2)
+            {
+                __m128i const va =
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(a + i));
+                __m128i const vb =
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(b + j));
+                __m128i const vb1 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+                __m128i const vb2 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+                __m128i const vb3 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+                __m128i const eq =
+                    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                                              _mm_cmpeq_epi32(va, vb1)),
+                                 _mm_or_si128(_mm_cmpeq_epi32(va, vb2),
+                                              _mm_cmpeq_epi32(va, vb3)));
+                if(_mm_movemask_epi8(eq) == 0)
+                {
+                    // The last elements differ, or the blocks would have a common one.
+                    T const last1 = a[i + 3];
+                    T const last2 = b[j + 3];
+                    i += last1 < last2 ? 4 : 0;
+                    j += last2 < last1 ? 4 : 0;
+                    continue;
+                }
+                for(auto const i4 = i + 4, j4 = j + 4; i != i4 && j != j4;)
+                {
+                    if(a[i] < b[j])
+                        ++i;
+                    else
+                    {
+                        if(!(b[j] < a[i]))
+                        {
+                            *out = begin1[i];
+                            ++out;
+                            ++i;
+                        }
+                        ++j;
+                    }
+                }
+            }
+            return detail::set_intersection_(begin1 + i, std::move(end1), begin2 + j,
+                                             std::move(end2), std::move(out), pred,
+                                             proj1, proj2, std::false_type{});
+        }
+#endif
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
@@ -0,0 +1,261 @@
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_DETAIL_THREAD_POOL_HPP
+#define RANGES_V3_DETAIL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <range/v3/range_fwd.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        // Loops over fewer elements run on the calling thread; longer ones are split
+        // into chunks of at least parallel_for_grain() elements, up to eight per thread
+        // so that threads that finish early can steal work.
+        constexpr std::ptrdiff_t parallel_for_threshold()
+        {
+            return 1 << 13;
+        }
+        constexpr std::ptrdiff_t parallel_for_grain()
+        {
+            return 1 << 10;
+        }
+
+        struct parallel_job_
+        {
+            void (*run)(parallel_job_ &, std::size_t chunk);
+            std::atomic<std::size_t> left;
+
+            explicit parallel_job_(void (*r)(parallel_job_ &, std::size_t))
+              : run(r)
+              , left(0)
+            {}
+        };
+
+        // A loop over [0, n) in chunks of about equal size.
+        template<typename Body>
+        struct parallel_for_job_ : parallel_job_
+        {
+            Body & body;
+            std::ptrdiff_t n;
+            std::size_t chunks;
+
+            parallel_for_job_(Body & b, std::ptrdiff_t size, std::size_t c)
+              : parallel_job_(&run_chunk)
+              , body(b)
+              , n(size)
+              , chunks(c)
+            {}
+
+            static void run_chunk(parallel_job_ & job, std::size_t chunk)
+            {
+                auto & self = static_cast<parallel_for_job_ &>(job);
+                auto const start = [&self](std::ptrdiff_t c) {
+                    auto const k = static_cast<std::ptrdiff_t>(self.chunks);
+                    auto const r = self.n % k;
+                    return self.n / k * c + (c < r ? c : r);
+                };
+                auto const c = static_cast<std::ptrdiff_t>(chunk);
+                self.body(start(c), start(c + 1));
+            }
+        };
+
+        // A pool of threads with a queue of tasks each. A job deals its chunks out to
+        // the queues in turn; the threads take tasks from the front of their own queue
+        // and, when it runs empty, steal from the back of the others. The thread that
+        // waits for a job helps with any task until the job is done, so jobs may nest.
+        class thread_pool_
+        {
+            struct task_
+            {
+                parallel_job_ * job;
+                std::size_t chunk;
+            };
+            struct queue_
+            {
+                std::mutex mutex;
+                std::deque<task_> tasks;
+            };
+
+            std::size_t size_;
+            std::unique_ptr<queue_[]> queues_;
+            std::atomic<std::size_t> queued_;
+            std::mutex sleep_mutex_;
+            std::condition_variable wake_;
+            bool stop_;
+            std::vector<std::thread> threads_;
+
+            bool pop_(std::size_t q, task_ & t, bool front)
+            {
+                queue_ & queue = queues_[q];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if(queue.tasks.empty())
+                    return false;
+                if(front)
+                {
+                    t = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                else
+                {
+                    t = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            // Takes a task from the queue of thread self, if it is one of the pool's,
+            // and otherwise steals one.
+            bool take_(std::size_t self, task_ & t)
+            {
+                if(queued_.load(std::memory_order_relaxed) == 0)
+                    return false;
+                if(self < size_ && pop_(self, t, true))
+                    return true;
+                for(std::size_t i = 1; i <= size_; ++i)
+                    if(pop_((self + i) % size_, t, false))
+                        return true;
+                return false;
+            }
+
+            // Running the task is the last access to its job, which the waiting thread
+            // may destroy as soon as left drops to zero.
+            static void run_(task_ const & t) noexcept
+            {
+                parallel_job_ & job = *t.job;
+                job.run(job, t.chunk);
+                job.left.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            void work_(std::size_t self)
+            {
+                task_ t;
+                while(true)
+                {
+                    if(take_(self, t))
+                    {
+                        run_(t);
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(sleep_mutex_);
+                    wake_.wait(lock, [this] { return stop_ || queued_.load() != 0; });
+                    if(stop_)
+                        return;
+                }
+            }
+
+        public:
+            explicit thread_pool_(std::size_t size)
+              : size_(size)
+              , queues_(new queue_[size])
+              , queued_(0)
+              , stop_(false)
+            {
+                threads_.reserve(size);
+                for(std::size_t i = 0; i != size; ++i)
+                    threads_.emplace_back([this, i] { work_(i); });
+            }
+            thread_pool_(thread_pool_ const &) = delete;
+            thread_pool_ & operator=(thread_pool_ const &) = delete;
+            ~thread_pool_()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    stop_ = true;
+                }
+                wake_.notify_all();
+                for(auto & thread : threads_)
+                    thread.join();
+            }
+
+            std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            // Runs the chunks of job on the pool, helped by the calling thread, and
+            // returns when all of them are done.
+            void run(parallel_job_ & job, std::size_t chunks)
+            {
+                job.left.store(chunks, std::memory_order_relaxed);
+                queued_.fetch_add(chunks);
+                for(std::size_t q = 0; q != size_; ++q)
+                {
+                    std::lock_guard<std::mutex> lock(queues_[q].mutex);
+                    for(std::size_t c = q; c < chunks; c += size_)
+                        queues_[q].tasks.push_back(task_{&job, c});
+                }
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                }
+                wake_.notify_all();
+                task_ t;
+                while(job.left.load(std::memory_order_acquire) != 0)
+                {
+                    if(take_(size_, t))
+                        run_(t);
+                    else
+                        std::this_thread::yield();
+                }
+            }
+        };
+
+        // Started on first use, with a thread less than the hardware runs concurrently,
+        // as the calling thread helps.
+        inline thread_pool_ & parallel_pool()
+        {
+            static thread_pool_ pool{std::thread::hardware_concurrency() > 1
+                                         ? std::thread::hardware_concurrency() - 1
+                                         : 0u};
+            return pool;
+        }
+
+        // Calls body(b, e) for disjoint [b, e) that cover [0, n), on the thread pool
+        // for large n.
+        template<typename Body>
+        void parallel_for_n(std::ptrdiff_t n, Body body)
+        {
+            if(n < parallel_for_threshold())
+            {
+                body(std::ptrdiff_t{0}, n);
+                return;
+            }
+            thread_pool_ & pool = detail::parallel_pool();
+            if(pool.size() == 0)
+            {
+                body(std::ptrdiff_t{0}, n);
+                return;
+            }
+            auto const most = 8 * (pool.size() + 1);
+            auto const chunks =
+                static_cast<std::size_t>(n / parallel_for_grain()) < most
+                    ? static_cast<std::size_t>(n / parallel_for_grain())
+                    : most;
+            parallel_for_job_<Body> job{body, n, chunks};
+            pool.run(job, chunks);
+        }
+    } // namespace detail
+    /// \endcond
+} // namespace ranges
+
+#endif
@@ -15,6 +15,8 @@
 
 #include <meta/meta.hpp>
 
+#include <range/v3/detail/block_iteration.hpp>
+#include <range/v3/detail/segmented_iteration.hpp>
 #include <range/v3/functional/arithmetic.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -51,10 +53,48 @@ namespace ranges
                 indirectly_binary_invocable_<Op, T *, projected<iterator_t<Rng>, P>> &&
                     assignable_from<
                         T &, indirect_result_t<Op &, T *, projected<iterator_t<Rng>, P>>>)
+        {
+            return impl_(
+                rng, std::move(init), op, proj, detail::traversal_tag_t<Rng>{});
+        }
+
+    private:
+        template<typename Rng, typename T, typename Op, typename P>
+        T impl_(Rng & rng, T init, Op & op, P & proj, std::false_type) const
         {
             return (*this)(
                 begin(rng), end(rng), std::move(init), std::move(op), std::move(proj));
         }
+        template<typename Rng, typename T, typename Op, typename P>
+        T impl_(Rng & rng, T init, Op & op, P & proj, std::true_type) const
+        {
+            auto block = [&](detail::block_value_t<Rng> * first, std::size_t n) {
+                for(auto last = first + n; first != last; ++first)
+                    init = invoke(
+                        op,
+                        init,
+                        invoke(proj,
+                               static_cast<detail::block_reference_t<Rng>>(*first)));
+            };
+            rng.for_each_block(block);
+            return init;
+        }
+        template<typename Rng, typename T, typename Op, typename P>
+        T impl_(Rng & rng, T init, Op & op, P & proj, detail::segmented_tag) const
+        {
+            auto leaf = [&](auto & seg) {
+                auto first = ranges::begin(seg);
+                auto const last = ranges::end(seg);
+                for(; first != last; ++first)
+                    init = invoke(
+                        op,
+                        init,
+                        invoke(proj, static_cast<range_reference_t<Rng>>(*first)));
+                return first;
+            };
+            detail::for_each_leaf_segment(rng, leaf);
+            return init;
+        }
     };
 
     RANGES_INLINE_VARIABLE(accumulate_fn, accumulate)
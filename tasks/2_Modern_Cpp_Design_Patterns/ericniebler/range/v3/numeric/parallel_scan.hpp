@@ -0,0 +1,376 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+#ifndef RANGES_V3_NUMERIC_PARALLEL_SCAN_HPP
+#define RANGES_V3_NUMERIC_PARALLEL_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/detail/parallel_invoke.hpp>
+#include <range/v3/functional/arithmetic.hpp>
+#include <range/v3/functional/identity.hpp>
+#include <range/v3/functional/invoke.hpp>
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/numeric/partial_sum.hpp>
+#include <range/v3/range/access.hpp>
+#include <range/v3/range/concepts.hpp>
+#include <range/v3/range/dangling.hpp>
+#include <range/v3/range/traits.hpp>
+#include <range/v3/utility/optional.hpp>
+#include <range/v3/utility/static_const.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGES_PARALLEL_SCAN_SSE2 1
+#include <emmintrin.h>
+#else
+#define RANGES_PARALLEL_SCAN_SSE2 0
+#endif
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        constexpr std::ptrdiff_t parallel_scan_threshold()
+        {
+            return 1 << 16;
+        }
+
+        // Whether a scan may run on SSE2 registers: a sum with the identity projection
+        // over contiguous 32- or 64-bit integers whose accumulator has the same type.
+        template<typename BOp, typename T>
+        using scan_plus_ = meta::bool_<same_as<BOp, plus> || same_as<BOp, std::plus<T>> ||
+                                       same_as<BOp, std::plus<>>>;
+
+        template<typename I, typename O, typename T, typename BOp, typename P>
+        using scan_sse2_ =
+            meta::bool_<RANGES_PARALLEL_SCAN_SSE2 && contiguous_iterator<I> &&
+                        contiguous_iterator<O> && same_as<iter_value_t<I>, T> &&
+                        same_as<iter_value_t<O>, T> && std::is_integral<T>::value &&
+                        (sizeof(T) == 4 || sizeof(T) == 8) && scan_plus_<BOp, T>::value &&
+                        same_as<P, identity>>;
+
+        // Writes the inclusive (or, with Exclusive, the exclusive) scan of the n
+        // elements at in, continued from carry, to out, and returns the new carry.
+        // Every element is read before the corresponding output is written, so out
+        // may equal in.
+        template<bool Exclusive, typename I, typename O, typename T, typename BOp,
+                 typename P>
+        T scan_block_(I in, std::ptrdiff_t n, O out, T carry, BOp & bop, P & proj,
+                      std::false_type)
+        {
+            coerce<iter_value_t<I>> val_i;
+            coerce<T> val_t;
+            for(; n != 0; --n, ++in, ++out)
+            {
+                auto && cur = val_i(*in);
+                T next = val_t(invoke(bop, carry, invoke(proj, cur)));
+                if(Exclusive)
+                    *out = carry;
+                carry = std::move(next);
+                if(!Exclusive)
+                    *out = carry;
+            }
+            return carry;
+        }
+
+#if RANGES_PARALLEL_SCAN_SSE2
+        inline __m128i scan_set1_(std::int32_t x, meta::size_t<4>)
+        {
+            return _mm_set1_epi32(x);
+        }
+        inline __m128i scan_set1_(std::int64_t x, meta::size_t<8>)
+        {
+            return _mm_set_epi32(static_cast<int>(x >> 32), static_cast<int>(x),
+                                 static_cast<int>(x >> 32), static_cast<int>(x));
+        }
+        inline __m128i scan_add_(__m128i x, __m128i y, meta::size_t<4>)
+        {
+            return _mm_add_epi32(x, y);
+        }
+        inline __m128i scan_add_(__m128i x, __m128i y, meta::size_t<8>)
+        {
+            return _mm_add_epi64(x, y);
+        }
+        // The inclusive scan of the lanes of x by log2(lanes) shifted additions.
+        inline __m128i scan_lanes_(__m128i x, meta::size_t<4>)
+        {
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        }
+        inline __m128i scan_lanes_(__m128i x, meta::size_t<8>)
+        {
+            return _mm_add_epi64(x, _mm_slli_si128(x, 8));
+        }
+        inline __m128i scan_last_(__m128i x, meta::size_t<4>)
+        {
+            return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        inline __m128i scan_last_(__m128i x, meta::size_t<8>)
+        {
+            return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        // Scans 16 bytes at a time in a register and adds the broadcast carry, which
+        // is then updated from the last lane. Integer sums are associative, so the
+        // results equal those of the element-wise loop.
+        template<bool Exclusive, typename I, typename O, typename T, typename BOp,
+                 typename P>
+        T scan_block_(I in, std::ptrdiff_t n, O out, T carry, BOp & bop, P & proj,
+                      std::true_type)
+        {
+            using W = meta::size_t<sizeof(T)>;
+            using S = meta::if_c<sizeof(T) == 4, std::int32_t, std::int64_t>;
+            constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+            if(n < lanes)
+                return detail::scan_block_<Exclusive>(in, n, out, carry, bop, proj,
+                                                      std::false_type{});
+            T const * src = std::addressof(*in);
+            T * dst = std::addressof(*out);
+            __m128i c = detail::scan_set1_(static_cast<S>(carry), W{});
+            std::ptrdiff_t i = 0;
+            for(; i + lanes <= n; i += lanes)
+            {
+                __m128i const x =
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+                __m128i const s = detail::scan_lanes_(x, W{});
+                __m128i const r = Exclusive ? _mm_slli_si128(s, sizeof(T)) : s;
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                                 detail::scan_add_(r, c, W{}));
+                c = detail::scan_add_(c, detail::scan_last_(s, W{}), W{});
+            }
+            T last[lanes];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(last), c);
+            return detail::scan_block_<Exclusive>(
+                src + i, n - i, dst + i, last[0], bop, proj, std::false_type{});
+        }
+#endif
+
+        // The left fold of the n > 0 elements at in.
+        template<typename T, typename I, typename BOp, typename P>
+        T reduce_block_(I in, std::ptrdiff_t n, BOp & bop, P & proj)
+        {
+            coerce<iter_value_t<I>> val_i;
+            coerce<T> val_t;
+            auto && first = val_i(*in);
+            T acc = invoke(proj, first);
+            for(++in; --n != 0; ++in)
+            {
+                auto && cur = val_i(*in);
+                acc = val_t(invoke(bop, acc, invoke(proj, cur)));
+            }
+            return acc;
+        }
+
+        // Two-pass blocked scan (reduce, then scan) of the n > 0 elements at first.
+        // Every thread owns one contiguous chunk. The first pass reduces all chunks
+        // but the last, the chunk totals are then scanned on the calling thread, and
+        // the second pass scans every chunk from its carry. The input is read twice
+        // and the output written once; the scans within a chunk are those of the
+        // sequential algorithm. An exclusive scan starts from *init, an inclusive scan
+        // (init == nullptr) from the first element.
+        template<bool Exclusive, typename T, typename I, typename O, typename BOp,
+                 typename P>
+        void parallel_scan_(I first, std::ptrdiff_t n, O out, T const * init,
+                            std::size_t threads, BOp & bop, P & proj)
+        {
+            using tag = scan_sse2_<I, O, T, BOp, P>;
+            auto const chunk = (n + static_cast<std::ptrdiff_t>(threads) - 1) /
+                               static_cast<std::ptrdiff_t>(threads);
+            threads = static_cast<std::size_t>((n + chunk - 1) / chunk);
+            std::vector<optional<T>> carries(threads);
+            if(init)
+                carries[0].emplace(*init);
+
+            auto reduce_chunk = [&](std::size_t t) {
+                std::ptrdiff_t const lo = static_cast<std::ptrdiff_t>(t) * chunk;
+                if(t + 1 < threads)
+                    carries[t + 1].emplace(
+                        detail::reduce_block_<T>(first + lo, chunk, bop, proj));
+            };
+            detail::parallel_invoke_n(threads, reduce_chunk);
+
+            coerce<T> val_t;
+            for(std::size_t t = 1; t < threads; ++t)
+                if(carries[t - 1])
+                    carries[t].emplace(val_t(invoke(bop, *carries[t - 1], *carries[t])));
+
+            auto scan_chunk = [&](std::size_t t) {
+                std::ptrdiff_t const lo = static_cast<std::ptrdiff_t>(t) * chunk;
+                std::ptrdiff_t const len = lo + chunk < n ? chunk : n - lo;
+                if(carries[t])
+                {
+                    detail::scan_block_<Exclusive>(
+                        first + lo, len, out + lo, *carries[t], bop, proj, tag{});
+                    return;
+                }
+                // The first chunk of an inclusive scan.
+                coerce<iter_value_t<I>> val_i;
+                auto && cur = val_i(*first);
+                T carry = invoke(proj, cur);
+                *out = carry;
+                detail::scan_block_<Exclusive>(
+                    first + 1, len - 1, out + 1, std::move(carry), bop, proj, tag{});
+            };
+            detail::parallel_invoke_n(threads, scan_chunk);
+        }
+
+        template<bool Exclusive, typename T, typename I, typename O, typename BOp,
+                 typename P>
+        void scan_(I first, std::ptrdiff_t n, O out, T const * init, BOp & bop,
+                   P & proj)
+        {
+            if(n <= 0)
+                return;
+            auto threads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+            if(n < parallel_scan_threshold() || threads <= 1)
+                threads = 1;
+            detail::parallel_scan_<Exclusive>(first, n, out, init, threads, bop, proj);
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-numerics
+    /// @{
+
+    // Parallel partial_sum and exclusive scan of random-access ranges on
+    // std::thread::hardware_concurrency() threads, for associative operations.
+    // Small ranges are scanned on the calling thread. Sums of contiguous 32- and
+    // 64-bit integers are scanned four or two elements at a time with SSE2. The
+    // operation, the projection and the element copies must not throw; otherwise
+    // std::terminate is called.
+
+    struct parallel_partial_sum_fn
+    {
+        template<typename I, typename S, typename O, typename BOp = plus,
+                 typename P = identity>
+        auto operator()(I first, S last, O result, BOp bop = BOp{}, P proj = P{}) const
+            -> CPP_ret(partial_sum_result<I, O>)( //
+                requires sized_sentinel_for<S, I> && random_access_iterator<I> &&
+                    random_access_iterator<O> && partial_sum_constraints<I, O, BOp, P>)
+        {
+            using X = projected<projected<I, detail::as_value_type_t<I>>, P>;
+            auto const n = last - first;
+            detail::scan_<false>(
+                first, n, result, static_cast<iter_value_t<X> const *>(nullptr), bop,
+                proj);
+            return {first + n, result + n};
+        }
+
+        template<typename Rng, typename ORef, typename BOp = plus, typename P = identity,
+                 typename I = iterator_t<Rng>, typename O = uncvref_t<ORef>>
+        auto operator()(Rng && rng, ORef && result, BOp bop = BOp{}, P proj = P{}) const
+            -> CPP_ret(partial_sum_result<safe_iterator_t<Rng>, O>)( //
+                requires sized_range<Rng> && random_access_range<Rng> &&
+                    random_access_iterator<O> && partial_sum_constraints<I, O, BOp, P>)
+        {
+            return (*this)(begin(rng),
+                           end(rng),
+                           static_cast<ORef &&>(result),
+                           std::move(bop),
+                           std::move(proj));
+        }
+
+        template<typename Rng, typename ORng, typename BOp = plus, typename P = identity,
+                 typename I = iterator_t<Rng>, typename O = iterator_t<ORng>>
+        auto operator()(Rng && rng, ORng && result, BOp bop = BOp{}, P proj = P{}) const
+            -> CPP_ret(
+                partial_sum_result<safe_iterator_t<Rng>, safe_iterator_t<ORng>>)( //
+                requires sized_range<Rng> && random_access_range<Rng> &&
+                    sized_range<ORng> && random_access_range<ORng> &&
+                    partial_sum_constraints<I, O, BOp, P>)
+        {
+            auto const m = distance(rng), k = distance(result);
+            auto const n = k < m ? k : m;
+            return (*this)(begin(rng),
+                           begin(rng) + n,
+                           begin(result),
+                           std::move(bop),
+                           std::move(proj));
+        }
+    };
+
+    RANGES_INLINE_VARIABLE(parallel_partial_sum_fn, parallel_partial_sum)
+
+    // axiom: BOp is associative over T.
+    // clang-format off
+    CPP_def
+    (
+        template(typename I, typename O, typename T, typename BOp, typename P)
+        concept parallel_exclusive_scan_constraints,
+            input_iterator<I> &&
+            copy_constructible<T> &&
+            convertible_to<indirect_result_t<P &, I>, T> &&
+            invocable<BOp &, T, indirect_result_t<P &, I>> &&
+            invocable<BOp &, T, T> &&
+            assignable_from<T &, invoke_result_t<BOp &, T, indirect_result_t<P &, I>>> &&
+            assignable_from<T &, invoke_result_t<BOp &, T, T>> &&
+            output_iterator<O, T const &>
+    );
+    // clang-format on
+
+    template<typename I, typename O>
+    using parallel_exclusive_scan_result = detail::in_out_result<I, O>;
+
+    // The i-th output is init combined with the first i projected elements.
+    struct parallel_exclusive_scan_fn
+    {
+        template<typename I, typename S, typename O, typename T, typename BOp = plus,
+                 typename P = identity>
+        auto operator()(I first, S last, O result, T init, BOp bop = BOp{},
+                        P proj = P{}) const
+            -> CPP_ret(parallel_exclusive_scan_result<I, O>)( //
+                requires sized_sentinel_for<S, I> && random_access_iterator<I> &&
+                    random_access_iterator<O> &&
+                    parallel_exclusive_scan_constraints<I, O, T, BOp, P>)
+        {
+            auto const n = last - first;
+            detail::scan_<true>(first, n, result, &init, bop, proj);
+            return {first + n, result + n};
+        }
+
+        template<typename Rng, typename O, typename T, typename BOp = plus,
+                 typename P = identity, typename I = iterator_t<Rng>>
+        auto operator()(Rng && rng, O result, T init, BOp bop = BOp{},
+                        P proj = P{}) const
+            -> CPP_ret(parallel_exclusive_scan_result<safe_iterator_t<Rng>, O>)( //
+                requires sized_range<Rng> && random_access_range<Rng> &&
+                    random_access_iterator<O> &&
+                    parallel_exclusive_scan_constraints<I, O, T, BOp, P>)
+        {
+            return (*this)(begin(rng),
+                           end(rng),
+                           std::move(result),
+                           std::move(init),
+                           std::move(bop),
+                           std::move(proj));
+        }
+    };
+
+    RANGES_INLINE_VARIABLE(parallel_exclusive_scan_fn, parallel_exclusive_scan)
+    /// @}
+} // namespace ranges
+
+#endif
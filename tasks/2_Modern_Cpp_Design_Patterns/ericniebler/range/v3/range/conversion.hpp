@@ -14,11 +14,15 @@
 #ifndef RANGES_V3_RANGE_CONVERSION_HPP
 #define RANGES_V3_RANGE_CONVERSION_HPP
 
+#include <cstddef>
+#include <iterator>
+
 #include <meta/meta.hpp>
 
 #include <range/v3/range_fwd.hpp>
 
 #include <range/v3/action/concepts.hpp>
+#include <range/v3/detail/block_iteration.hpp>
 #include <range/v3/functional/pipeable.hpp>
 #include <range/v3/iterator/common_iterator.hpp>
 #include <range/v3/range/concepts.hpp>
@@ -244,10 +248,55 @@ namespace ranges
         );
         // clang-format on
 
+        template<typename C, typename Rng, typename = void>
+        struct to_container_block_insert : std::false_type
+        {};
+        template<typename C, typename Rng>
+        struct to_container_block_insert<
+            C, Rng,
+            meta::void_<decltype(std::declval<C &>().insert(
+                std::declval<C &>().end(),
+                std::make_move_iterator(std::declval<block_value_t<Rng> *>()),
+                std::make_move_iterator(std::declval<block_value_t<Rng> *>())))>>
+          : std::true_type
+        {};
+
+        template<typename C, typename Rng>
+        using to_container_use_blocks =
+            meta::and_<has_block_iteration<Rng>, to_container_block_insert<C, Rng>>;
+
         template<typename ToContainer>
         struct to_container::fn : pipeable_base
         {
         private:
+            template<typename Cont, typename Rng>
+            static void reserve_(Cont & c, Rng & rng, std::true_type)
+            {
+                c.reserve(static_cast<decltype(c.max_size())>(ranges::size(rng)));
+            }
+            template<typename Cont, typename Rng>
+            static void reserve_(Cont &, Rng &, std::false_type)
+            {}
+            // Appends the elements block by block, for ranges that support block
+            // iteration (see detail/block_iteration.hpp).
+            template<typename Cont, typename I, typename Rng, typename UseReserve>
+            static Cont impl(Rng && rng, UseReserve, std::true_type)
+            {
+                Cont c;
+                reserve_(c, rng, UseReserve{});
+                auto block = [&c](block_value_t<Rng> * first, std::size_t n) {
+                    c.insert(c.end(),
+                             std::make_move_iterator(first),
+                             std::make_move_iterator(first + n));
+                };
+                rng.for_each_block(block);
+                return c;
+            }
+            template<typename Cont, typename I, typename Rng, typename UseReserve>
+            static Cont impl(Rng && rng, UseReserve, std::false_type)
+            {
+                return impl<Cont, I>(static_cast<Rng &&>(rng), UseReserve{});
+            }
             template<typename Cont, typename I, typename Rng>
             static Cont impl(Rng && rng, std::false_type)
             {
@@ -282,7 +331,9 @@ namespace ranges
                 using iter_t = range_cpp17_iterator_t<Rng>;
                 using use_reserve_t =
                     meta::bool_<(bool)to_container_reserve<cont_t, iter_t, Rng>>;
-                return impl<cont_t, iter_t>(static_cast<Rng &&>(rng), use_reserve_t{});
+                return impl<cont_t, iter_t>(static_cast<Rng &&>(rng),
+                                            use_reserve_t{},
+                                            to_container_use_blocks<cont_t, Rng>{});
             }
             template<typename Rng>
             auto operator()(Rng && rng) const -> CPP_ret(container_t<Rng>)( //
@@ -23,12 +23,14 @@ RANGES_DISABLE_WARNINGS
 #include <range/v3/utility/common_type.hpp>
 #include <range/v3/utility/compressed_pair.hpp>
 #include <range/v3/utility/copy.hpp>
+#include <range/v3/utility/execution.hpp>
 #include <range/v3/utility/get.hpp>
 #include <range/v3/utility/in_place.hpp>
 #include <range/v3/utility/memory.hpp>
 #include <range/v3/utility/move.hpp>
 #include <range/v3/utility/optional.hpp>
 #include <range/v3/utility/polymorphic_cast.hpp>
+#include <range/v3/utility/priority_queue.hpp>
 #include <range/v3/utility/random.hpp>
 #include <range/v3/utility/scope_exit.hpp>
 #include <range/v3/utility/semiregular_box.hpp>
@@ -0,0 +1,639 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+
+#ifndef RANGES_V3_UTILITY_DFA_REGEX_HPP
+#define RANGES_V3_UTILITY_DFA_REGEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <range/v3/range_fwd.hpp>
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        using dfa_byte_set = std::bitset<256>;
+
+        constexpr std::size_t dfa_regex_max_states()
+        {
+            return 4096;
+        }
+        constexpr int dfa_regex_max_repeat()
+        {
+            return 1000;
+        }
+
+        [[noreturn]] inline void dfa_regex_error(std::regex_constants::error_type code)
+        {
+            throw std::regex_error(code);
+        }
+
+        // The transition table of a compiled dfa_regex. The bytes are mapped to classes
+        // of bytes that no part of the pattern distinguishes, and the states are stored
+        // premultiplied by the number of classes. State 0 is the dead state.
+        struct dfa_tables
+        {
+            std::array<std::uint8_t, 256> classes{};
+            std::size_t class_count = 1;
+            std::vector<std::uint32_t> next;
+            std::vector<char> accept; // indexed like next, by premultiplied state
+            std::array<bool, 256> starts{}; // bytes leaving the start state
+            std::uint32_t start = 0;
+        };
+
+        // Parses an ECMAScript pattern into a syntax tree; {n,m} is expanded in place.
+        struct dfa_parser
+        {
+            enum kind
+            {
+                set_node,
+                cat_node,
+                alt_node,
+                star_node,
+                plus_node,
+                opt_node,
+                empty_node
+            };
+            struct node
+            {
+                kind k;
+                dfa_byte_set set;
+                int lhs, rhs;
+            };
+
+            char const * pos_;
+            char const * end_;
+            bool icase_;
+            std::vector<node> nodes_;
+
+            int parse()
+            {
+                int const n = alt();
+                if(pos_ != end_)
+                    dfa_regex_error(std::regex_constants::error_paren);
+                return n;
+            }
+
+        private:
+            int make(kind k, int lhs = -1, int rhs = -1)
+            {
+                nodes_.push_back(node{k, dfa_byte_set{}, lhs, rhs});
+                return static_cast<int>(nodes_.size() - 1);
+            }
+            int make_set(dfa_byte_set set)
+            {
+                if(icase_)
+                {
+                    for(int c = 'a'; c <= 'z'; ++c)
+                    {
+                        if(set[static_cast<std::size_t>(c)] ||
+                           set[static_cast<std::size_t>(c - 'a' + 'A')])
+                        {
+                            set.set(static_cast<std::size_t>(c));
+                            set.set(static_cast<std::size_t>(c - 'a' + 'A'));
+                        }
+                    }
+                }
+                int const n = make(set_node);
+                nodes_[static_cast<std::size_t>(n)].set = set;
+                return n;
+            }
+            static dfa_byte_set byte(char c)
+            {
+                dfa_byte_set set;
+                set.set(static_cast<unsigned char>(c));
+                return set;
+            }
+            static dfa_byte_set byte_range(unsigned lo, unsigned hi)
+            {
+                dfa_byte_set set;
+                for(; lo <= hi; ++lo)
+                    set.set(lo);
+                return set;
+            }
+
+            int alt()
+            {
+                int n = cat();
+                while(pos_ != end_ && *pos_ == '|')
+                {
+                    ++pos_;
+                    n = make(alt_node, n, cat());
+                }
+                return n;
+            }
+            int cat()
+            {
+                int n = -1;
+                while(pos_ != end_ && *pos_ != '|' && *pos_ != ')')
+                {
+                    int const r = repeat();
+                    n = n < 0 ? r : make(cat_node, n, r);
+                }
+                return n < 0 ? make(empty_node) : n;
+            }
+            static bool quantifier(char c)
+            {
+                return c == '*' || c == '+' || c == '?' || c == '{';
+            }
+            int repeat()
+            {
+                int n = atom();
+                if(pos_ == end_ || !quantifier(*pos_))
+                    return n;
+                switch(*pos_++)
+                {
+                case '*': n = make(star_node, n); break;
+                case '+': n = make(plus_node, n); break;
+                case '?': n = make(opt_node, n); break;
+                default: n = counted(n); break;
+                }
+                // Lazy quantifiers cannot be told apart by a leftmost-longest matcher.
+                if(pos_ != end_ && quantifier(*pos_))
+                    dfa_regex_error(std::regex_constants::error_badrepeat);
+                return n;
+            }
+            int number()
+            {
+                if(pos_ == end_ || *pos_ < '0' || *pos_ > '9')
+                    dfa_regex_error(std::regex_constants::error_badbrace);
+                int n = 0;
+                for(; pos_ != end_ && *pos_ >= '0' && *pos_ <= '9'; ++pos_)
+                {
+                    n = n * 10 + (*pos_ - '0');
+                    if(n > dfa_regex_max_repeat())
+                        dfa_regex_error(std::regex_constants::error_badbrace);
+                }
+                return n;
+            }
+            int counted(int n) // after '{'
+            {
+                int const lo = number();
+                int hi = lo;
+                if(pos_ != end_ && *pos_ == ',')
+                {
+                    ++pos_;
+                    hi = pos_ != end_ && *pos_ == '}' ? -1 : number();
+                }
+                if(pos_ == end_ || *pos_ != '}')
+                    dfa_regex_error(std::regex_constants::error_brace);
+                ++pos_;
+                if(hi != -1 && hi < lo)
+                    dfa_regex_error(std::regex_constants::error_badbrace);
+                int r = -1;
+                for(int i = 0; i < lo; ++i)
+                    r = r < 0 ? n : make(cat_node, r, n);
+                if(hi == -1)
+                {
+                    int const s = make(star_node, n);
+                    return r < 0 ? s : make(cat_node, r, s);
+                }
+                for(int i = lo; i < hi; ++i)
+                {
+                    int const o = make(opt_node, n);
+                    r = r < 0 ? o : make(cat_node, r, o);
+                }
+                return r < 0 ? make(empty_node) : r;
+            }
+            int atom()
+            {
+                char const c = *pos_++;
+                switch(c)
+                {
+                case '(':
+                {
+                    if(pos_ != end_ && *pos_ == '?')
+                    {
+                        // Only non-capturing groups; no lookarounds.
+                        if(end_ - pos_ < 2 || pos_[1] != ':')
+                            dfa_regex_error(std::regex_constants::error_complexity);
+                        pos_ += 2;
+                    }
+                    int const n = alt();
+                    if(pos_ == end_ || *pos_ != ')')
+                        dfa_regex_error(std::regex_constants::error_paren);
+                    ++pos_;
+                    return n;
+                }
+                case '[': return make_set(bracket());
+                case '.': return make_set(~(byte('\n') | byte('\r')));
+                case '\\': return make_set(escape(false));
+                case '*':
+                case '+':
+                case '?':
+                case '{': dfa_regex_error(std::regex_constants::error_badrepeat);
+                case '^':
+                case '$': dfa_regex_error(std::regex_constants::error_complexity);
+                default: return make_set(byte(c));
+                }
+            }
+            dfa_byte_set escape(bool in_bracket) // after '\'
+            {
+                if(pos_ == end_)
+                    dfa_regex_error(std::regex_constants::error_escape);
+                char const c = *pos_++;
+                switch(c)
+                {
+                case 'd': return byte_range('0', '9');
+                case 'D': return ~byte_range('0', '9');
+                case 'w': return word();
+                case 'W': return ~word();
+                case 's': return space();
+                case 'S': return ~space();
+                case 't': return byte('\t');
+                case 'n': return byte('\n');
+                case 'r': return byte('\r');
+                case 'f': return byte('\f');
+                case 'v': return byte('\v');
+                case '0': return byte('\0');
+                case 'x':
+                {
+                    unsigned v = 0;
+                    for(int i = 0; i < 2; ++i, ++pos_)
+                    {
+                        char const h = pos_ != end_ ? *pos_ : 'g';
+                        if(h >= '0' && h <= '9')
+                            v = v * 16 + static_cast<unsigned>(h - '0');
+                        else if((h | 0x20) >= 'a' && (h | 0x20) <= 'f')
+                            v = v * 16 + static_cast<unsigned>((h | 0x20) - 'a' + 10);
+                        else
+                            dfa_regex_error(std::regex_constants::error_escape);
+                    }
+                    return byte_range(v, v);
+                }
+                case 'b':
+                    if(in_bracket)
+                        return byte('\b');
+                    // Word boundaries are not supported.
+                    dfa_regex_error(std::regex_constants::error_complexity);
+                case 'B': dfa_regex_error(std::regex_constants::error_complexity);
+                default:
+                    if(c >= '1' && c <= '9')
+                        dfa_regex_error(std::regex_constants::error_backref);
+                    if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+                        dfa_regex_error(std::regex_constants::error_escape);
+                    return byte(c);
+                }
+            }
+            static dfa_byte_set word()
+            {
+                return byte_range('a', 'z') | byte_range('A', 'Z') |
+                       byte_range('0', '9') | byte('_');
+            }
+            static dfa_byte_set space()
+            {
+                return byte_range('\t', '\r') | byte(' ');
+            }
+            // A single character of a bracket expression, or a class such as \d.
+            dfa_byte_set bracket_atom(bool & single, unsigned & c)
+            {
+                dfa_byte_set set;
+                if(*pos_ == '\\')
+                {
+                    ++pos_;
+                    set = escape(true);
+                }
+                else
+                    set = byte(*pos_++);
+                single = set.count() == 1;
+                if(single)
+                    for(c = 0; !set[c]; ++c)
+                        ;
+                return set;
+            }
+            dfa_byte_set bracket() // after '['
+            {
+                bool const negate = pos_ != end_ && *pos_ == '^';
+                if(negate)
+                    ++pos_;
+                dfa_byte_set set;
+                for(;;)
+                {
+                    if(pos_ == end_)
+                        dfa_regex_error(std::regex_constants::error_brack);
+                    if(*pos_ == ']')
+                    {
+                        ++pos_;
+                        break;
+                    }
+                    bool single;
+                    unsigned lo = 0;
+                    dfa_byte_set const s = bracket_atom(single, lo);
+                    if(single && end_ - pos_ >= 2 && *pos_ == '-' && pos_[1] != ']')
+                    {
+                        ++pos_;
+                        unsigned hi = 0;
+                        bracket_atom(single, hi);
+                        if(!single || hi < lo)
+                            dfa_regex_error(std::regex_constants::error_range);
+                        set |= byte_range(lo, hi);
+                    }
+                    else
+                        set |= s;
+                }
+                return negate ? ~set : set;
+            }
+        };
+
+        // Thompson construction from the syntax tree followed by the subset
+        // construction of the DFA.
+        struct dfa_builder
+        {
+            struct nfa_state
+            {
+                dfa_byte_set bytes;
+                int next = -1; // target of the byte transition, if any
+                int eps[2] = {-1, -1};
+            };
+
+            std::vector<dfa_parser::node> const & nodes_;
+            std::vector<nfa_state> nfa_;
+
+            std::pair<int, int> build(int id)
+            {
+                auto const & n = nodes_[static_cast<std::size_t>(id)];
+                switch(n.k)
+                {
+                case dfa_parser::set_node:
+                {
+                    int const s = state(), e = state();
+                    nfa_[static_cast<std::size_t>(s)].bytes = n.set;
+                    nfa_[static_cast<std::size_t>(s)].next = e;
+                    return {s, e};
+                }
+                case dfa_parser::cat_node:
+                {
+                    auto const a = build(n.lhs);
+                    auto const b = build(n.rhs);
+                    link(a.second, b.first);
+                    return {a.first, b.second};
+                }
+                case dfa_parser::alt_node:
+                {
+                    auto const a = build(n.lhs);
+                    auto const b = build(n.rhs);
+                    int const s = state(), e = state();
+                    link(s, a.first, b.first);
+                    link(a.second, e);
+                    link(b.second, e);
+                    return {s, e};
+                }
+                case dfa_parser::star_node:
+                case dfa_parser::opt_node:
+                {
+                    auto const a = build(n.lhs);
+                    int const s = state(), e = state();
+                    link(s, a.first, e);
+                    if(n.k == dfa_parser::star_node)
+                        link(a.second, a.first, e);
+                    else
+                        link(a.second, e);
+                    return {s, e};
+                }
+                case dfa_parser::plus_node:
+                {
+                    auto const a = build(n.lhs);
+                    int const e = state();
+                    link(a.second, a.first, e);
+                    return {a.first, e};
+                }
+                default:
+                {
+                    int const s = state(), e = state();
+                    link(s, e);
+                    return {s, e};
+                }
+                }
+            }
+
+            // The DFA state for the closure of seeds: the sorted NFA states with a byte
+            // transition, preceded by whether the final state is reachable.
+            std::vector<int> closure(std::vector<int> & seeds, int final,
+                                     std::vector<char> & seen) const
+            {
+                seen.assign(nfa_.size(), 0);
+                std::vector<int> key(1, 0);
+                while(!seeds.empty())
+                {
+                    int const s = seeds.back();
+                    seeds.pop_back();
+                    if(seen[static_cast<std::size_t>(s)])
+                        continue;
+                    seen[static_cast<std::size_t>(s)] = 1;
+                    auto const & st = nfa_[static_cast<std::size_t>(s)];
+                    if(s == final)
+                        key[0] = 1;
+                    if(st.next >= 0)
+                        key.push_back(s);
+                    for(int e : st.eps)
+                        if(e >= 0)
+                            seeds.push_back(e);
+                }
+                std::sort(key.begin() + 1, key.end());
+                return key;
+            }
+
+            void determinize(int start, int final, dfa_tables & t) const
+            {
+                // Refine the byte classes by every byte set of the NFA.
+                std::size_t count = 1;
+                for(auto const & st : nfa_)
+                {
+                    if(st.next < 0)
+                        continue;
+                    std::vector<int> remap(count * 2, -1);
+                    std::size_t n = 0;
+                    for(std::size_t b = 0; b != 256; ++b)
+                    {
+                        auto & r = remap[t.classes[b] * 2u + st.bytes[b]];
+                        if(r < 0)
+                            r = static_cast<int>(n++);
+                        t.classes[b] = static_cast<std::uint8_t>(r);
+                    }
+                    count = n;
+                }
+                t.class_count = count;
+                std::vector<unsigned> rep(count);
+                for(unsigned b = 256; b-- != 0;)
+                    rep[t.classes[b]] = b;
+
+                std::map<std::vector<int>, std::uint32_t> ids;
+                std::vector<std::vector<int>> states;
+                std::vector<char> seen;
+                auto id = [&](std::vector<int> key) {
+                    auto const it = ids.find(key);
+                    if(it != ids.end())
+                        return it->second;
+                    if(states.size() == dfa_regex_max_states())
+                        dfa_regex_error(std::regex_constants::error_complexity);
+                    auto const s = static_cast<std::uint32_t>(states.size() * count);
+                    ids.emplace(key, s);
+                    t.next.resize(t.next.size() + count, 0);
+                    t.accept.resize(t.accept.size() + count, 0);
+                    t.accept[s] = static_cast<char>(key[0]);
+                    states.push_back(std::move(key));
+                    return s;
+                };
+                std::vector<int> seeds;
+                id(std::vector<int>(1, 0)); // dead state
+                seeds.push_back(start);
+                t.start = id(closure(seeds, final, seen));
+                for(std::size_t i = 1; i < states.size(); ++i)
+                {
+                    for(std::size_t k = 0; k != count; ++k)
+                    {
+                        for(std::size_t j = 1; j < states[i].size(); ++j)
+                        {
+                            auto const & st =
+                                nfa_[static_cast<std::size_t>(states[i][j])];
+                            if(st.bytes[rep[k]])
+                                seeds.push_back(st.next);
+                        }
+                        auto const s = id(closure(seeds, final, seen));
+                        t.next[i * count + k] = s;
+                    }
+                }
+                for(std::size_t b = 0; b != 256; ++b)
+                    t.starts[b] = t.next[t.start + t.classes[b]] != 0;
+            }
+
+        private:
+            int state()
+            {
+                if(nfa_.size() == dfa_regex_max_states() * 16)
+                    dfa_regex_error(std::regex_constants::error_complexity);
+                nfa_.emplace_back();
+                return static_cast<int>(nfa_.size() - 1);
+            }
+            void link(int from, int to0, int to1 = -1)
+            {
+                nfa_[static_cast<std::size_t>(from)].eps[0] = to0;
+                nfa_[static_cast<std::size_t>(from)].eps[1] = to1;
+            }
+        };
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-utility
+    /// @{
+
+    /// A regular expression compiled into a deterministic finite automaton over
+    /// bytes. Matching never allocates and takes constant time per character and
+    /// attempted match start. It accepts the ECMAScript subset without captures:
+    /// literals, escapes such as \c \\d, \c \\w and \c \\x41, bracket expressions,
+    /// \c ., non-capturing groups, \c | and the greedy quantifiers \c *, \c +, \c ?
+    /// and \c {n,m}. Anchors, word boundaries, lookarounds and lazy quantifiers throw
+    /// \c std::regex_error with \c error_complexity or \c error_badrepeat, back
+    /// references with \c error_backref. Among the matches starting at the leftmost
+    /// position the longest one is chosen, as by POSIX regular expressions, which
+    /// can differ from ECMAScript for alternatives such as <tt>a|ab</tt>. Of the
+    /// syntax options only \c icase is honored.
+    struct dfa_regex
+    {
+        using value_type = char;
+        using flag_type = std::regex_constants::syntax_option_type;
+
+        /// Matches nothing.
+        dfa_regex() = default;
+        explicit dfa_regex(char const * pattern,
+                           flag_type flags = std::regex_constants::ECMAScript)
+          : dfa_regex(pattern, std::char_traits<char>::length(pattern), flags)
+        {}
+        explicit dfa_regex(std::string const & pattern,
+                           flag_type flags = std::regex_constants::ECMAScript)
+          : dfa_regex(pattern.data(), pattern.size(), flags)
+        {}
+        dfa_regex(char const * pattern, std::size_t size,
+                  flag_type flags = std::regex_constants::ECMAScript)
+        {
+            detail::dfa_parser parser{pattern,
+                                      pattern + size,
+                                      (flags & std::regex_constants::icase) != 0,
+                                      {}};
+            int const root = parser.parse();
+            detail::dfa_builder builder{parser.nodes_, {}};
+            auto const nfa = builder.build(root);
+            auto tables = std::make_shared<detail::dfa_tables>();
+            builder.determinize(nfa.first, nfa.second, *tables);
+            tables_ = std::move(tables);
+        }
+
+        /// The end of the longest match that starts at \p first, if any.
+        template<typename I, typename S>
+        bool match_prefix(I first, S last, I & match_last) const
+        {
+            if(!tables_)
+                return false;
+            auto const & t = *tables_;
+            auto const * const next = t.next.data();
+            auto s = t.start;
+            bool found = t.accept[s] != 0;
+            if(found)
+                match_last = first;
+            while(first != last)
+            {
+                s = next[s + t.classes[static_cast<unsigned char>(*first)]];
+                if(s == 0)
+                    break;
+                ++first;
+                if(t.accept[s])
+                {
+                    found = true;
+                    match_last = first;
+                }
+            }
+            return found;
+        }
+
+        /// The leftmost-longest match in [first, last), if any. Positions whose
+        /// character cannot start a match are skipped with a table lookup.
+        template<typename I, typename S>
+        bool search(I first, S last, I & match_first, I & match_last) const
+        {
+            if(!tables_)
+                return false;
+            auto const & t = *tables_;
+            bool const empty = t.accept[t.start] != 0;
+            for(;; ++first)
+            {
+                if(!empty)
+                    while(first != last && !t.starts[static_cast<unsigned char>(*first)])
+                        ++first;
+                if(match_prefix(first, last, match_last))
+                {
+                    match_first = first;
+                    return true;
+                }
+                if(first == last)
+                    return false;
+            }
+        }
+
+    private:
+        std::shared_ptr<detail::dfa_tables const> tables_;
+    };
+    /// @}
+} // namespace ranges
+
+#endif
@@ -0,0 +1,82 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+
+#ifndef RANGES_V3_UTILITY_EXECUTION_HPP
+#define RANGES_V3_UTILITY_EXECUTION_HPP
+
+#include <type_traits>
+
+#include <meta/meta.hpp>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/iterator/concepts.hpp>
+#include <range/v3/utility/static_const.hpp>
+
+namespace ranges
+{
+    /// \addtogroup group-utility
+    /// @{
+
+    /// Execution policies for the algorithms of range/v3/algorithm/parallel.hpp, which
+    /// accept one as their first argument, like
+    /// ranges::parallel::for_each(ranges::execution::par, rng, fun). With par and
+    /// par_unseq random-access ranges of known size are processed in chunks on a shared
+    /// pool of std::thread::hardware_concurrency() - 1 threads plus the calling thread;
+    /// other ranges, and all ranges with seq, are processed sequentially. The functions
+    /// passed to a parallel algorithm are invoked concurrently and must not throw;
+    /// otherwise std::terminate is called.
+    namespace execution
+    {
+        struct sequenced_policy
+        {};
+        struct parallel_policy
+        {};
+        struct parallel_unsequenced_policy
+        {};
+
+        RANGES_INLINE_VARIABLE(sequenced_policy, seq)
+        RANGES_INLINE_VARIABLE(parallel_policy, par)
+        RANGES_INLINE_VARIABLE(parallel_unsequenced_policy, par_unseq)
+    } // namespace execution
+
+    template<typename T>
+    struct is_execution_policy : std::false_type
+    {};
+    template<>
+    struct is_execution_policy<execution::sequenced_policy> : std::true_type
+    {};
+    template<>
+    struct is_execution_policy<execution::parallel_policy> : std::true_type
+    {};
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type
+    {};
+
+    /// \cond
+    namespace detail
+    {
+        // Whether an algorithm called with the policy EP on [I, S) runs on the thread
+        // pool: EP asks for parallel execution and the range has random access and a
+        // size.
+        template<typename EP, typename I, typename S>
+        using execute_in_parallel_ = meta::bool_<
+            (same_as<uncvref_t<EP>, execution::parallel_policy> ||
+             same_as<uncvref_t<EP>, execution::parallel_unsequenced_policy>) &&
+            random_access_iterator<I> && sized_sentinel_for<S, I>>;
+    } // namespace detail
+    /// \endcond
+    /// @}
+} // namespace ranges
+
+#endif
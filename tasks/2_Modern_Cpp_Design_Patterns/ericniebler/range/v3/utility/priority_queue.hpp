@@ -0,0 +1,157 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+
+#ifndef RANGES_V3_UTILITY_PRIORITY_QUEUE_HPP
+#define RANGES_V3_UTILITY_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/algorithm/heap_algorithm.hpp>
+#include <range/v3/functional/comparisons.hpp>
+#include <range/v3/functional/identity.hpp>
+
+namespace ranges
+{
+    /// \addtogroup group-utility
+    /// @{
+
+    /// \brief A priority queue on a d-ary heap in a random-access container
+    ///
+    /// Like std::priority_queue, the greatest element under C is on top. With Arity
+    /// 4 or 8 pushes and pops touch fewer cache lines than with a binary heap, which
+    /// pays off for heaps that do not fit into the cache; pops move the hole down to
+    /// a leaf first, see pop_dary_heap.
+    template<typename T, std::size_t Arity = 4, typename C = less,
+             typename Container = std::vector<T>>
+    struct priority_queue
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per element");
+
+        using container_type = Container;
+        using value_compare = C;
+        using value_type = typename Container::value_type;
+        using size_type = typename Container::size_type;
+        using reference = typename Container::reference;
+        using const_reference = typename Container::const_reference;
+
+    private:
+        Container c_;
+        RANGES_NO_UNIQUE_ADDRESS
+        C pred_;
+
+    public:
+        priority_queue() = default;
+        explicit priority_queue(C pred)
+          : c_()
+          , pred_(std::move(pred))
+        {}
+        priority_queue(C pred, Container c)
+          : c_(std::move(c))
+          , pred_(std::move(pred))
+        {
+            identity proj;
+            detail::dary_make_heap_n<Arity>(
+                c_.begin(), static_cast<std::ptrdiff_t>(c_.size()), pred_, proj);
+        }
+
+        bool empty() const
+        {
+            return c_.empty();
+        }
+        size_type size() const
+        {
+            return c_.size();
+        }
+        const_reference top() const
+        {
+            RANGES_EXPECT(!c_.empty());
+            return c_.front();
+        }
+        Container const & container() const noexcept
+        {
+            return c_;
+        }
+
+        void push(value_type const & value)
+        {
+            c_.push_back(value);
+            sift_up_();
+        }
+        void push(value_type && value)
+        {
+            c_.push_back(std::move(value));
+            sift_up_();
+        }
+        template<typename... Args>
+        void emplace(Args &&... args)
+        {
+            c_.emplace_back(static_cast<Args &&>(args)...);
+            sift_up_();
+        }
+        void pop()
+        {
+            RANGES_EXPECT(!c_.empty());
+            identity proj;
+            detail::dary_pop_heap_n<Arity>(
+                c_.begin(), static_cast<std::ptrdiff_t>(c_.size()), pred_, proj);
+            c_.pop_back();
+        }
+        /// Equivalent to pop() followed by push(value), with a single pass through
+        /// the heap.
+        void replace_top(value_type value)
+        {
+            RANGES_EXPECT(!c_.empty());
+            identity proj;
+            detail::dary_replace_top_n<Arity>(c_.begin(),
+                                              static_cast<std::ptrdiff_t>(c_.size()),
+                                              std::move(value),
+                                              pred_,
+                                              proj);
+        }
+
+        void reserve(size_type n)
+        {
+            c_.reserve(n);
+        }
+        void clear() noexcept
+        {
+            c_.clear();
+        }
+        void swap(priority_queue & that) noexcept(
+            is_nothrow_swappable<Container>::value && is_nothrow_swappable<C>::value)
+        {
+            ranges::swap(c_, that.c_);
+            ranges::swap(pred_, that.pred_);
+        }
+        friend void swap(priority_queue & x,
+                         priority_queue & y) noexcept(noexcept(x.swap(y)))
+        {
+            x.swap(y);
+        }
+
+    private:
+        void sift_up_()
+        {
+            identity proj;
+            detail::dary_sift_up_n<Arity>(
+                c_.begin(), static_cast<std::ptrdiff_t>(c_.size()), pred_, proj);
+        }
+    };
+    /// @}
+} // namespace ranges
+
+#endif
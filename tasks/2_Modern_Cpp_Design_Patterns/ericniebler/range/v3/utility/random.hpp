@@ -91,6 +91,279 @@ namespace ranges
     // clang-format on
     /// @}
 
+    /// \cond
+    namespace detail
+    {
+        // The low half of the 128-bit product of a and b; stores the high half in hi.
+        RANGES_INTENDED_MODULAR_ARITHMETIC
+        inline std::uint64_t mul_64x64_128(std::uint64_t a, std::uint64_t b,
+                                           std::uint64_t & hi) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 uint128;
+            uint128 const p = static_cast<uint128>(a) * b;
+            hi = static_cast<std::uint64_t>(p >> 64);
+            return static_cast<std::uint64_t>(p);
+#else
+            std::uint64_t const a_lo = a & 0xffffffffu, a_hi = a >> 32;
+            std::uint64_t const b_lo = b & 0xffffffffu, b_hi = b >> 32;
+            std::uint64_t const p0 = a_lo * b_lo, p1 = a_lo * b_hi;
+            std::uint64_t const p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+            std::uint64_t const mid =
+                (p0 >> 32) + (p1 & 0xffffffffu) + (p2 & 0xffffffffu);
+            hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+            return (mid << 32) | (p0 & 0xffffffffu);
+#endif
+        }
+
+        constexpr std::uint64_t rotl64(std::uint64_t x, unsigned r) noexcept
+        {
+            return (x << (r & 63u)) | (x >> ((64u - r) & 63u));
+        }
+
+        RANGES_INTENDED_MODULAR_ARITHMETIC
+        inline std::uint64_t splitmix64(std::uint64_t & x) noexcept
+        {
+            std::uint64_t z = (x += 0x9e3779b97f4a7c15u);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+            return z ^ (z >> 31);
+        }
+
+        template<typename SeedSeq>
+        using seed_seq_generate_t = decltype(std::declval<SeedSeq &>().generate(
+            std::declval<std::uint32_t *>(), std::declval<std::uint32_t *>()));
+
+        // Fills words with 64-bit values built from pairs of 32-bit outputs of seq.
+        template<typename SeedSeq, std::size_t N>
+        void seed_words(SeedSeq & seq, std::uint64_t (&words)[N])
+        {
+            std::uint32_t buf[2 * N];
+            seq.generate(buf + 0, buf + 2 * N);
+            for(std::size_t i = 0; i < N; ++i)
+                words[i] = (std::uint64_t{buf[2 * i + 1]} << 32) | buf[2 * i];
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-numerics
+    /// @{
+
+    /// \brief The xoshiro256++ generator of Blackman and Vigna.
+    ///
+    /// A 256-bit state advanced by shifts, rotations and xors. It passes the
+    /// statistical test batteries that the Mersenne Twister fails, is 32 bytes
+    /// instead of 2.5 KB, and produces a 64-bit value in a handful of cycles.
+    struct xoshiro256pp
+    {
+        using result_type = std::uint64_t;
+
+        static constexpr result_type min() noexcept
+        {
+            return 0;
+        }
+        static constexpr result_type max() noexcept
+        {
+            return ~result_type{0};
+        }
+
+        xoshiro256pp() noexcept
+          : xoshiro256pp(result_type{0})
+        {}
+        /// Expands \c seed into the full state with splitmix64.
+        explicit xoshiro256pp(result_type seed) noexcept
+        {
+            for(auto & word : s_)
+                word = detail::splitmix64(seed);
+        }
+        template<typename SeedSeq, typename = detail::seed_seq_generate_t<SeedSeq>>
+        explicit xoshiro256pp(SeedSeq & seq)
+        {
+            detail::seed_words(seq, s_);
+            if((s_[0] | s_[1] | s_[2] | s_[3]) == 0)
+                s_[0] = 1; // The all-zero state is a fixed point.
+        }
+
+        RANGES_INTENDED_MODULAR_ARITHMETIC
+        result_type operator()() noexcept
+        {
+            return step_(s_[0], s_[1], s_[2], s_[3]);
+        }
+
+        /// Writes the next \c n outputs to \c out; equivalent to \c n calls of
+        /// operator() but runs with the state in registers.
+        void generate(result_type * out, std::size_t n) noexcept
+        {
+            result_type s0 = s_[0], s1 = s_[1], s2 = s_[2], s3 = s_[3];
+            for(; n >= 4; n -= 4, out += 4)
+            {
+                out[0] = step_(s0, s1, s2, s3);
+                out[1] = step_(s0, s1, s2, s3);
+                out[2] = step_(s0, s1, s2, s3);
+                out[3] = step_(s0, s1, s2, s3);
+            }
+            for(; n != 0; --n, ++out)
+                *out = step_(s0, s1, s2, s3);
+            s_[0] = s0;
+            s_[1] = s1;
+            s_[2] = s2;
+            s_[3] = s3;
+        }
+
+        void discard(unsigned long long n) noexcept
+        {
+            for(; n != 0; --n)
+                (*this)();
+        }
+
+        /// Advances the state by 2^128 steps, which splits the period into
+        /// non-overlapping streams for parallel use.
+        void jump() noexcept
+        {
+            static constexpr result_type poly[] = {
+                0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+                0x39abdc4529b1661c};
+            result_type t[4] = {0, 0, 0, 0};
+            for(auto word : poly)
+                for(unsigned b = 0; b < 64; ++b)
+                {
+                    if(word & (result_type{1} << b))
+                        for(int i = 0; i < 4; ++i)
+                            t[i] ^= s_[i];
+                    (*this)();
+                }
+            for(int i = 0; i < 4; ++i)
+                s_[i] = t[i];
+        }
+
+        friend bool operator==(xoshiro256pp const & x, xoshiro256pp const & y) noexcept
+        {
+            return x.s_[0] == y.s_[0] && x.s_[1] == y.s_[1] && x.s_[2] == y.s_[2] &&
+                   x.s_[3] == y.s_[3];
+        }
+        friend bool operator!=(xoshiro256pp const & x, xoshiro256pp const & y) noexcept
+        {
+            return !(x == y);
+        }
+
+    private:
+        result_type s_[4];
+
+        RANGES_INTENDED_MODULAR_ARITHMETIC
+        static result_type step_(result_type & s0, result_type & s1, result_type & s2,
+                                 result_type & s3) noexcept
+        {
+            result_type const result = detail::rotl64(s0 + s3, 23) + s0;
+            result_type const t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = detail::rotl64(s3, 45);
+            return result;
+        }
+    };
+
+    /// \brief The PCG64 generator of O'Neill (XSL-RR 128/64).
+    ///
+    /// A 128-bit linear congruential generator whose output is the xor of the
+    /// state halves rotated by the top six state bits. Besides the seed it takes
+    /// a stream selector, so that generators with distinct streams never overlap.
+    struct pcg64
+    {
+        using result_type = std::uint64_t;
+
+        static constexpr result_type min() noexcept
+        {
+            return 0;
+        }
+        static constexpr result_type max() noexcept
+        {
+            return ~result_type{0};
+        }
+
+        pcg64() noexcept
+          : pcg64(0xcafef00dd15ea5e5u)
+        {}
+        explicit pcg64(result_type seed,
+                       result_type stream = 0xda3e39cb94b95bdbu) noexcept
+        {
+            seed_(0, seed, 0, stream);
+        }
+        template<typename SeedSeq, typename = detail::seed_seq_generate_t<SeedSeq>>
+        explicit pcg64(SeedSeq & seq)
+        {
+            std::uint64_t words[4];
+            detail::seed_words(seq, words);
+            seed_(words[0], words[1], words[2], words[3]);
+        }
+
+        result_type operator()() noexcept
+        {
+            step_();
+            return detail::rotl64(hi_ ^ lo_, static_cast<unsigned>(64 - (hi_ >> 58)));
+        }
+
+        /// Writes the next \c n outputs to \c out; equivalent to \c n calls of
+        /// operator().
+        void generate(result_type * out, std::size_t n) noexcept
+        {
+            for(std::size_t i = 0; i != n; ++i)
+                out[i] = (*this)();
+        }
+
+        void discard(unsigned long long n) noexcept
+        {
+            for(; n != 0; --n)
+                step_();
+        }
+
+        friend bool operator==(pcg64 const & x, pcg64 const & y) noexcept
+        {
+            return x.hi_ == y.hi_ && x.lo_ == y.lo_ && x.inc_hi_ == y.inc_hi_ &&
+                   x.inc_lo_ == y.inc_lo_;
+        }
+        friend bool operator!=(pcg64 const & x, pcg64 const & y) noexcept
+        {
+            return !(x == y);
+        }
+
+    private:
+        static constexpr result_type mult_hi_ = 0x2360ed051fc65da4u;
+        static constexpr result_type mult_lo_ = 0x4385df649fccf645u;
+
+        result_type hi_, lo_;         // state
+        result_type inc_hi_, inc_lo_; // odd increment, selects the stream
+
+        RANGES_INTENDED_MODULAR_ARITHMETIC
+        void step_() noexcept
+        {
+            // state = state * mult + inc (mod 2^128)
+            result_type p_hi;
+            result_type const p_lo = detail::mul_64x64_128(lo_, mult_lo_, p_hi);
+            p_hi += lo_ * mult_hi_ + hi_ * mult_lo_;
+            lo_ = p_lo + inc_lo_;
+            hi_ = p_hi + inc_hi_ + (lo_ < p_lo);
+        }
+
+        RANGES_INTENDED_MODULAR_ARITHMETIC
+        void seed_(result_type state_hi, result_type state_lo, result_type stream_hi,
+                   result_type stream_lo) noexcept
+        {
+            // The seeding procedure of the reference implementation.
+            inc_hi_ = (stream_hi << 1) | (stream_lo >> 63);
+            inc_lo_ = (stream_lo << 1) | 1u;
+            hi_ = lo_ = 0;
+            step_();
+            result_type const lo = lo_ + state_lo;
+            hi_ += state_hi + (lo < state_lo);
+            lo_ = lo;
+            step_();
+        }
+    };
+    /// @}
+
     /// \cond
     namespace detail
     {
@@ -421,8 +694,96 @@ namespace ranges
             using auto_seed_256 = auto_seeded<seed_seq_fe256>;
         } // namespace randutils
 
-        using default_URNG = meta::if_c<(sizeof(void *) >= sizeof(long long)),
-                                        std::mt19937_64, std::mt19937>;
+        using default_URNG = xoshiro256pp;
+
+        // Uniformly distributed integers in [0, n) by Lemire's multiply-shift
+        // method ("Fast Random Integer Generation in an Interval", 2019): the high
+        // half of gen() * n, rejecting the few low halves below 2^w mod n that
+        // would bias it. The division computing 2^w mod n only runs when the low
+        // half is below n, which is rare for n much smaller than 2^w. Generators
+        // that do not produce full 32- or 64-bit words go through
+        // std::uniform_int_distribution.
+        template<typename Gen>
+        using bounded_rand_bits_ = meta::size_t<
+            Gen::min() != 0
+                ? 0
+                : static_cast<std::uint64_t>(Gen::max()) == ~std::uint64_t{0}
+                      ? 64
+                      : static_cast<std::uint64_t>(Gen::max()) == 0xffffffffu ? 32 : 0>;
+
+        template<typename Gen>
+        std::uint64_t bounded_rand_(Gen & gen, std::uint64_t n, meta::size_t<0>)
+        {
+            std::uniform_int_distribution<std::uint64_t> dist{0, n - 1};
+            return dist(gen);
+        }
+        template<typename Gen>
+        RANGES_INTENDED_MODULAR_ARITHMETIC std::uint64_t bounded_rand_(
+            Gen & gen, std::uint64_t n, meta::size_t<64>)
+        {
+            std::uint64_t hi;
+            std::uint64_t lo =
+                detail::mul_64x64_128(static_cast<std::uint64_t>(gen()), n, hi);
+            if(lo < n)
+            {
+                std::uint64_t const threshold = (0 - n) % n;
+                while(lo < threshold)
+                    lo = detail::mul_64x64_128(static_cast<std::uint64_t>(gen()), n, hi);
+            }
+            return hi;
+        }
+        template<typename Gen>
+        RANGES_INTENDED_MODULAR_ARITHMETIC std::uint64_t bounded_rand_(
+            Gen & gen, std::uint64_t n, meta::size_t<32>)
+        {
+            if(n > 0xffffffffu)
+                return detail::bounded_rand_(gen, n, meta::size_t<0>{});
+            auto const n32 = static_cast<std::uint32_t>(n);
+            std::uint64_t m = static_cast<std::uint32_t>(gen()) * n;
+            if(static_cast<std::uint32_t>(m) < n32)
+            {
+                std::uint32_t const threshold = (0u - n32) % n32;
+                while(static_cast<std::uint32_t>(m) < threshold)
+                    m = static_cast<std::uint32_t>(gen()) * n;
+            }
+            return m >> 32;
+        }
+
+        template<typename Gen, typename D>
+        D bounded_rand(Gen & gen, D n)
+        {
+            RANGES_EXPECT(0 < n);
+            return static_cast<D>(detail::bounded_rand_(
+                gen, static_cast<std::uint64_t>(n), bounded_rand_bits_<Gen>{}));
+        }
+
+        // Two independent draws from [0, n1) and [0, n2) out of one 64-bit output
+        // of gen, for n1 * n2 < 2^64 (Brackett-Rozinsky and Lemire, "Batched Ranged
+        // Random Integer Generation", 2024): the high half of gen() * n1 is the first
+        // draw, the high half of the low half times n2 the second, and the final low
+        // half decides on rejection as with a single bound of n1 * n2.
+        template<typename Gen>
+        RANGES_INTENDED_MODULAR_ARITHMETIC void bounded_rand2(Gen & gen, std::uint64_t n1,
+                                                              std::uint64_t n2,
+                                                              std::uint64_t & r1,
+                                                              std::uint64_t & r2)
+        {
+            CPP_assert(bounded_rand_bits_<Gen>::value == 64);
+            std::uint64_t const n = n1 * n2;
+            std::uint64_t threshold = 0;
+            for(bool first = true;; first = false)
+            {
+                std::uint64_t const lo1 =
+                    detail::mul_64x64_128(static_cast<std::uint64_t>(gen()), n1, r1);
+                std::uint64_t const lo2 = detail::mul_64x64_128(lo1, n2, r2);
+                if(lo2 >= n)
+                    return;
+                if(first)
+                    threshold = (0 - n) % n;
+                if(lo2 >= threshold)
+                    return;
+            }
+        }
 
 #if !RANGES_CXX_THREAD_LOCAL
         template<typename URNG>
@@ -54,7 +54,9 @@ RANGES_DISABLE_WARNINGS
 #include <range/v3/view/join.hpp>
 #include <range/v3/view/linear_distribute.hpp>
 #include <range/v3/view/map.hpp>
+#include <range/v3/view/mapped_lines.hpp>
 #include <range/v3/view/move.hpp>
+#include <range/v3/view/numeric_istream.hpp>
 #include <range/v3/view/partial_sum.hpp>
 #include <range/v3/view/ref.hpp>
 #include <range/v3/view/remove_if.hpp>
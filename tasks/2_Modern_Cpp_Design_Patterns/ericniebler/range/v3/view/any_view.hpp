@@ -15,12 +15,16 @@
 #ifndef RANGES_V3_VIEW_ANY_VIEW_HPP
 #define RANGES_V3_VIEW_ANY_VIEW_HPP
 
+#include <cstddef>
+#include <functional>
+#include <new>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/block_iteration.hpp>
 #include <range/v3/iterator/default_sentinel.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/range/concepts.hpp>
@@ -30,6 +34,19 @@
 #include <range/v3/view/all.hpp>
 #include <range/v3/view/facade.hpp>
 
+/// \brief The size in bytes of the buffer in which the iterators of `any_view` store
+/// their type-erased cursors without allocating. Larger cursors, and the type-erased
+/// views, are allocated on the heap. Define as 0 to always allocate.
+#ifndef RANGES_ANY_VIEW_BUFFER_SIZE
+#define RANGES_ANY_VIEW_BUFFER_SIZE (4 * sizeof(void *))
+#endif
+
+/// \brief The maximum number of elements an input `any_view` hands out per virtual call
+/// when it is traversed by a block-iterating algorithm (`for_each`, `accumulate`, `to`).
+#ifndef RANGES_ANY_VIEW_BLOCK_SIZE
+#define RANGES_ANY_VIEW_BLOCK_SIZE 64
+#endif
+
 RANGES_DIAGNOSTIC_PUSH
 RANGES_DIAGNOSTIC_IGNORE_INCONSISTENT_OVERRIDE
 
@@ -148,7 +165,132 @@ namespace ranges
             cloneable() = default;
             cloneable(cloneable const &) = delete;
             cloneable & operator=(cloneable const &) = delete;
-            virtual std::unique_ptr<cloneable> clone() const = 0;
+            // Copies *this into the given small buffer if it fits, otherwise onto the heap.
+            virtual cloneable * clone_to(void * buffer) const = 0;
+            // Moves *this into the given small buffer. Only called for objects that were
+            // themselves created in a small buffer.
+            virtual cloneable * move_to(void * buffer) noexcept = 0;
+        };
+
+        struct fully_erased_view;
+
+        // The erased views always live on the heap: any_sentinel points to the view, as
+        // may the iterators of the view's own cursors, and a view in the small buffer
+        // would change its address when the any_view holding it is moved.
+        template<typename T>
+        using any_is_pinned = std::is_base_of<fully_erased_view, T>;
+
+        template<typename Impl, typename State>
+        using any_fits_small_buffer =
+            meta::bool_<!any_is_pinned<Impl>::value &&
+                        sizeof(Impl) <= RANGES_ANY_VIEW_BUFFER_SIZE &&
+                        alignof(Impl) <= alignof(std::max_align_t) &&
+                        std::is_nothrow_move_constructible<State>::value>;
+
+        template<typename Impl, typename... Args>
+        Impl * any_emplace(void * buffer, std::true_type, Args &&... args)
+        {
+            return ::new(buffer) Impl(static_cast<Args &&>(args)...);
+        }
+        template<typename Impl, typename... Args>
+        Impl * any_emplace(void *, std::false_type, Args &&... args)
+        {
+            return new Impl(static_cast<Args &&>(args)...);
+        }
+
+        // Owning pointer to a cloneable object, which stores objects of up to
+        // RANGES_ANY_VIEW_BUFFER_SIZE bytes in place and only allocates for larger ones,
+        // and for pinned ones, for which it has no buffer.
+        template<typename Interface>
+        struct small_buffer_ptr
+        {
+            small_buffer_ptr() = default;
+            template<typename Impl, typename State>
+            small_buffer_ptr(meta::id<Impl>, State && state)
+              : ptr_{detail::any_emplace<Impl>(
+                    &buffer_, any_fits_small_buffer<Impl, detail::decay_t<State>>{},
+                    static_cast<State &&>(state))}
+            {}
+            small_buffer_ptr(small_buffer_ptr && that) noexcept
+            {
+                steal(that);
+            }
+            small_buffer_ptr(small_buffer_ptr const & that)
+              : ptr_{that.ptr_ ? that.ptr_->clone_to(&buffer_) : nullptr}
+            {}
+            small_buffer_ptr & operator=(small_buffer_ptr && that) noexcept
+            {
+                if(this != &that)
+                {
+                    reset();
+                    steal(that);
+                }
+                return *this;
+            }
+            small_buffer_ptr & operator=(small_buffer_ptr const & that)
+            {
+                if(this != &that)
+                {
+                    reset();
+                    ptr_ = that.ptr_ ? that.ptr_->clone_to(&buffer_) : nullptr;
+                }
+                return *this;
+            }
+            ~small_buffer_ptr()
+            {
+                reset();
+            }
+            Interface * operator->() const noexcept
+            {
+                return ptr_;
+            }
+            Interface & operator*() const noexcept
+            {
+                return *ptr_;
+            }
+            explicit operator bool() const noexcept
+            {
+                return ptr_ != nullptr;
+            }
+            bool is_small() const noexcept
+            {
+                void const * const p = ptr_;
+                return ptr_ && !std::less<void const *>{}(p, &buffer_) &&
+                       std::less<void const *>{}(p, &buffer_ + 1);
+            }
+
+        private:
+            void steal(small_buffer_ptr & that) noexcept
+            {
+                if(that.is_small())
+                {
+                    ptr_ = that.ptr_->move_to(&buffer_);
+                    that.reset();
+                }
+                else
+                {
+                    ptr_ = that.ptr_;
+                    that.ptr_ = nullptr;
+                }
+            }
+            void reset() noexcept
+            {
+                if(is_small())
+                    ptr_->~Interface();
+                else
+                    delete ptr_;
+                ptr_ = nullptr;
+            }
+
+            Interface * ptr_ = nullptr;
+            meta::_t<std::aligned_storage<(RANGES_ANY_VIEW_BUFFER_SIZE > 0 &&
+                                                   !any_is_pinned<Interface>::value
+                                               ? RANGES_ANY_VIEW_BUFFER_SIZE
+                                               : 1),
+                                          any_is_pinned<Interface>::value
+                                              ? 1
+                                              : alignof(std::max_align_t)>>
+                buffer_;
         };
 
         // clang-format off
@@ -197,6 +339,31 @@ namespace ranges
             }
         };
 
+        // Elements can be buffered for block iteration if the reference type is a
+        // prvalue or a const lvalue reference, i.e., if users cannot tell a copy apart.
+        template<typename Ref>
+        using any_block_readable = meta::bool_<
+            (std::is_object<Ref>::value ||
+             (std::is_lvalue_reference<Ref>::value &&
+              std::is_const<meta::_t<std::remove_reference<Ref>>>::value)) &&
+            (bool)semiregular<uncvref_t<Ref>>>;
+
+        struct any_no_block_value
+        {};
+
+        template<typename Ref>
+        using any_block_value_t =
+            meta::if_<any_block_readable<Ref>, uncvref_t<Ref>, any_no_block_value>;
+
+        template<typename Ref, bool = any_block_readable<Ref>::value>
+        struct any_input_block_types
+        {};
+        template<typename Ref>
+        struct any_input_block_types<Ref, true>
+        {
+            using block_value_type = uncvref_t<Ref>;
+        };
+
         template<typename Ref, bool Sized = false>
         struct any_input_view_interface
         {
@@ -205,6 +372,9 @@ namespace ranges
             virtual bool done() = 0;
             virtual Ref read() const = 0;
             virtual void next() = 0;
+            // Copies up to n elements into buffer and advances past them. Returns less
+            // than n only at the end of the range.
+            virtual std::size_t fill(any_block_value_t<Ref> * buffer, std::size_t n) = 0;
         };
         template<typename Ref>
         struct any_input_view_interface<Ref, true> : any_input_view_interface<Ref, false>
@@ -276,6 +446,25 @@ namespace ranges
             {
                 ++current_;
             }
+            virtual std::size_t fill(any_block_value_t<Ref> * buffer,
+                                     std::size_t n) override
+            {
+                return fill_(buffer, n, any_block_readable<Ref>{});
+            }
+            std::size_t fill_(any_block_value_t<Ref> * buffer, std::size_t n,
+                              std::true_type)
+            {
+                auto const last = sentinel_box_t::get(rng_);
+                std::size_t i = 0;
+                for(; i != n && current_ != last; ++i, ++current_)
+                    buffer[i] = *current_;
+                return i;
+            }
+            std::size_t fill_(any_no_block_value *, std::size_t, std::false_type)
+            {
+                RANGES_EXPECT(false);
+                return 0;
+            }
             std::size_t size() const // override-ish
             {
                 return static_cast<std::size_t>(ranges::size(rng_));
@@ -354,10 +543,14 @@ namespace ranges
             {
                 ++it_;
             }
-            std::unique_ptr<any_cloneable_cursor_interface<Ref, Cat>> clone()
-                const override
+            any_cloneable_cursor_interface<Ref, Cat> * clone_to(void * buffer) const override
             {
-                return detail::make_unique<any_cursor_impl>(it_);
+                return detail::any_emplace<any_cursor_impl>(
+                    buffer, any_fits_small_buffer<any_cursor_impl, I>{}, it_);
+            }
+            any_cloneable_cursor_interface<Ref, Cat> * move_to(void * buffer) noexcept override
+            {
+                return ::new(buffer) any_cursor_impl(std::move(it_));
             }
             void prev() // override (sometimes; it's complicated)
             {
@@ -404,7 +597,7 @@ namespace ranges
         private:
             CPP_assert((Cat & category::forward) == category::forward);
 
-            std::unique_ptr<any_cloneable_cursor_interface<Ref, Cat>> ptr_;
+            small_buffer_ptr<any_cloneable_cursor_interface<Ref, Cat>> ptr_;
 
             template<typename Rng>
             using impl_t = any_cursor_impl<iterator_t<Rng>, Ref, Cat>;
@@ -416,18 +609,8 @@ namespace ranges
                 requires(!ranges::defer::same_as<detail::decay_t<Rng>, any_cursor>) &&
                 ranges::defer::forward_range<Rng> &&
                 defer::any_compatible_range<Rng, Ref>)
-              : ptr_{detail::make_unique<impl_t<Rng>>(begin(rng))}
-            {}
-            any_cursor(any_cursor &&) = default;
-            any_cursor(any_cursor const & that)
-              : ptr_{that.ptr_ ? that.ptr_->clone() : nullptr}
+              : ptr_{meta::id<impl_t<Rng>>{}, begin(rng)}
             {}
-            any_cursor & operator=(any_cursor &&) = default;
-            any_cursor & operator=(any_cursor const & that)
-            {
-                ptr_ = (that.ptr_ ? that.ptr_->clone() : nullptr);
-                return *this;
-            }
             Ref read() const
             {
                 RANGES_EXPECT(ptr_);
@@ -520,9 +703,15 @@ namespace ranges
                 auto & it = it_.get<iterator_t<Rng> const>();
                 return it == sentinel_box_t::get(range_box_t::get());
             }
-            std::unique_ptr<any_cloneable_view_interface<Ref, Cat>> clone() const override
+            any_cloneable_view_interface<Ref, Cat> * clone_to(void * buffer) const override
+            {
+                return detail::any_emplace<any_view_impl>(
+                    buffer, any_fits_small_buffer<any_view_impl, Rng>{}, range_box_t::get());
+            }
+            any_cloneable_view_interface<Ref, Cat> * move_to(void * buffer) noexcept override
             {
-                return detail::make_unique<any_view_impl>(range_box_t::get());
+                // NB: constructed from the range to recompute a cached sentinel
+                return ::new(buffer) any_view_impl(std::move(range_box_t::get()));
             }
             std::size_t size() const // override-ish
             {
@@ -550,16 +739,6 @@ namespace ranges
           : any_view(static_cast<Rng &&>(rng),
                      meta::bool_<(get_categories<Rng>() & Cat) == Cat>{})
         {}
-        any_view(any_view &&) = default;
-        any_view(any_view const & that)
-          : ptr_{that.ptr_ ? that.ptr_->clone() : nullptr}
-        {}
-        any_view & operator=(any_view &&) = default;
-        any_view & operator=(any_view const & that)
-        {
-            ptr_ = (that.ptr_ ? that.ptr_->clone() : nullptr);
-            return *this;
-        }
 
         CPP_member
         auto size() const -> CPP_ret(std::size_t)( //
@@ -573,7 +752,7 @@ namespace ranges
         using impl_t = detail::any_view_impl<views::all_t<Rng>, Ref, Cat>;
         template<typename Rng>
         any_view(Rng && rng, std::true_type)
-          : ptr_{detail::make_unique<impl_t<Rng>>(views::all(static_cast<Rng &&>(rng)))}
+          : ptr_{meta::id<impl_t<Rng>>{}, views::all(static_cast<Rng &&>(rng))}
         {}
         template<typename Rng>
         any_view(Rng &&, std::false_type)
@@ -592,14 +771,16 @@ namespace ranges
             return detail::any_sentinel{*ptr_};
         }
 
-        std::unique_ptr<detail::any_cloneable_view_interface<Ref, Cat>> ptr_;
+        detail::small_buffer_ptr<detail::any_cloneable_view_interface<Ref, Cat>> ptr_;
     };
 
     // input and not forward
     template<typename Ref, category Cat>
-    struct any_view<Ref, Cat, meta::if_c<(Cat & category::forward) == category::input>>
+    struct RANGES_EMPTY_BASES
+        any_view<Ref, Cat, meta::if_c<(Cat & category::forward) == category::input>>
       : view_facade<any_view<Ref, Cat, void>,
                     (Cat & category::sized) == category::sized ? finite : unknown>
+      , detail::any_input_block_types<Ref>
     {
         friend range_access;
 
@@ -618,6 +799,27 @@ namespace ranges
             return ptr_ ? ptr_->size() : 0;
         }
 
+        // Block iteration protocol, see detail/block_iteration.hpp: one virtual call
+        // per RANGES_ANY_VIEW_BLOCK_SIZE elements instead of three per element.
+        template<typename Fun>
+        auto for_each_block(Fun & fun)
+        {
+            using iterator = basic_iterator<detail::any_input_cursor<Ref>>;
+            if(!ptr_)
+                return iterator{};
+
+            ptr_->init();
+            detail::any_block_value_t<Ref> buffer[RANGES_ANY_VIEW_BLOCK_SIZE];
+            std::size_t n;
+            do
+            {
+                n = ptr_->fill(buffer, RANGES_ANY_VIEW_BLOCK_SIZE);
+                if(n != 0)
+                    fun(+buffer, n);
+            } while(n == RANGES_ANY_VIEW_BLOCK_SIZE);
+            return iterator{detail::any_input_cursor<Ref>{*ptr_}};
+        }
+
     private:
         template<typename Rng>
         using impl_t =
@@ -15,6 +15,7 @@
 #ifndef RANGES_V3_VIEW_CARTESIAN_PRODUCT_HPP
 #define RANGES_V3_VIEW_CARTESIAN_PRODUCT_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 #include <concepts/concepts.hpp>
@@ -230,6 +231,14 @@ namespace ranges
                 RANGES_EXPECT(n < INTMAX_MAX - idx);
                 n += idx;
 
+                // Most steps stay within the current range and need no carry.
+                if(0 <= n && n < my_size)
+                {
+                    using D = iter_difference_t<decltype(first)>;
+                    i = first + static_cast<D>(n);
+                    return;
+                }
+
                 auto n_div = n / my_size;
                 auto n_mod = n % my_size;
 
@@ -410,6 +419,230 @@ namespace ranges
     cartesian_product_view(Rng &&...)->cartesian_product_view<views::all_t<Rng>...>;
 #endif
 
+    /// A \c cartesian_product_view that visits the product in tiles instead of in
+    /// lexicographic order: the ranges are cut into chunks of \c tile elements, the
+    /// tiles (one chunk of each range) are visited in lexicographic order and so are
+    /// the tuples within each tile. Every tuple is visited exactly once. While a tile
+    /// is visited only \c tile elements of each range are touched, so a nested-loop
+    /// join over ranges that do not fit into the cache loads every element once per
+    /// tile instead of once per element of the outer range.
+    template<typename... Views>
+    struct tiled_cartesian_product_view
+      : view_facade<tiled_cartesian_product_view<Views...>,
+                    detail::cartesian_product_cardinality<Views...>::value>
+    {
+    private:
+        friend range_access;
+        CPP_assert(and_v<(forward_range<Views> && view_<Views>)...>);
+        CPP_assert(sizeof...(Views) != 0);
+
+        static constexpr auto my_cardinality =
+            detail::cartesian_product_cardinality<Views...>::value;
+
+        std::tuple<Views...> views_;
+        std::ptrdiff_t tile_ = 1;
+
+        template<bool IsConst_>
+        struct cursor
+        {
+        private:
+            friend cursor<true>;
+            template<typename T>
+            using constify_if = meta::const_if_c<IsConst_, T>;
+            using its_t = std::tuple<iterator_t<constify_if<Views>>...>;
+
+            constify_if<tiled_cartesian_product_view> * view_;
+            // The current tuple, and for each range the chunk [first, last) of the
+            // current tile.
+            its_t its_;
+            its_t firsts_;
+            its_t lasts_;
+
+            template<std::size_t N>
+            void chunk_(meta::size_t<N>)
+            {
+                auto & v = std::get<N - 1>(view_->views_);
+                std::get<N - 1>(its_) = std::get<N - 1>(firsts_);
+                std::get<N - 1>(lasts_) = ranges::next(
+                    std::get<N - 1>(firsts_),
+                    static_cast<range_difference_t<decltype(v)>>(view_->tile_),
+                    ranges::end(v));
+            }
+            bool next_in_tile_(meta::size_t<0>)
+            {
+                return false;
+            }
+            template<std::size_t N>
+            bool next_in_tile_(meta::size_t<N>)
+            {
+                auto & i = std::get<N - 1>(its_);
+                if(++i != std::get<N - 1>(lasts_))
+                    return true;
+                i = std::get<N - 1>(firsts_);
+                return next_in_tile_(meta::size_t<N - 1>{});
+            }
+            void next_tile_(meta::size_t<1>)
+            {
+                auto & last = std::get<0>(lasts_);
+                if(last == ranges::end(std::get<0>(view_->views_)))
+                {
+                    // Past the last tile: the end position
+                    std::get<0>(its_) = last;
+                    return;
+                }
+                std::get<0>(firsts_) = last;
+                chunk_(meta::size_t<1>{});
+            }
+            template<std::size_t N>
+            void next_tile_(meta::size_t<N>)
+            {
+                auto & v = std::get<N - 1>(view_->views_);
+                auto & last = std::get<N - 1>(lasts_);
+                if(last == ranges::end(v))
+                {
+                    std::get<N - 1>(firsts_) = ranges::begin(v);
+                    chunk_(meta::size_t<N>{});
+                    next_tile_(meta::size_t<N - 1>{});
+                    return;
+                }
+                std::get<N - 1>(firsts_) = last;
+                chunk_(meta::size_t<N>{});
+            }
+            void begin_(meta::size_t<0>)
+            {}
+            template<std::size_t N>
+            void begin_(meta::size_t<N>)
+            {
+                chunk_(meta::size_t<N>{});
+                begin_(meta::size_t<N - 1>{});
+            }
+            bool empty_(meta::size_t<0>) const
+            {
+                return false;
+            }
+            template<std::size_t N>
+            bool empty_(meta::size_t<N>) const
+            {
+                auto & v = std::get<N - 1>(view_->views_);
+                return std::get<N - 1>(its_) == ranges::end(v) ||
+                       empty_(meta::size_t<N - 1>{});
+            }
+
+        public:
+            using value_type = std::tuple<range_value_t<Views>...>;
+
+            cursor() = default;
+            explicit cursor(constify_if<tiled_cartesian_product_view> * view)
+              : view_(view)
+              , its_(tuple_transform(view->views_, ranges::begin))
+              , firsts_(its_)
+              , lasts_(its_)
+            {
+                begin_(meta::size_t<sizeof...(Views)>{});
+                // If any of the ranges is empty, so is the product.
+                if(empty_(meta::size_t<sizeof...(Views)>{}))
+                    ranges::advance(std::get<0>(its_),
+                                    ranges::end(std::get<0>(view_->views_)));
+            }
+            explicit cursor(end_tag, constify_if<tiled_cartesian_product_view> * view)
+              : view_(view)
+              , its_(tuple_transform(view->views_, ranges::begin))
+            {
+                // The position after the last tile; see next_tile_
+                std::get<0>(its_) = ranges::end(std::get<0>(view->views_));
+                firsts_ = lasts_ = its_;
+            }
+            CPP_template(bool Other)( //
+                requires IsConst_ && (!Other)) cursor(cursor<Other> that)
+              : view_(that.view_)
+              , its_(std::move(that.its_))
+              , firsts_(std::move(that.firsts_))
+              , lasts_(std::move(that.lasts_))
+            {}
+            common_tuple<range_reference_t<Views>...> read() const
+            {
+                return tuple_transform(its_, detail::dereference_fn{});
+            }
+            void next()
+            {
+                if(!next_in_tile_(meta::size_t<sizeof...(Views)>{}))
+                    next_tile_(meta::size_t<sizeof...(Views)>{});
+            }
+            bool equal(default_sentinel_t) const
+            {
+                return std::get<0>(its_) == ranges::end(std::get<0>(view_->views_));
+            }
+            bool equal(cursor const & that) const
+            {
+                return its_ == that.its_;
+            }
+        };
+        cursor<false> begin_cursor()
+        {
+            return cursor<false>{this};
+        }
+        CPP_member
+        auto begin_cursor() const -> CPP_ret(cursor<true>)( //
+            requires cartesian_produce_view_can_const<Views...>)
+        {
+            return cursor<true>{this};
+        }
+        CPP_member
+        auto end_cursor() -> CPP_ret(cursor<false>)( //
+            requires common_range<meta::at_c<meta::list<Views...>, 0>>)
+        {
+            return cursor<false>{end_tag{}, this};
+        }
+        CPP_member
+        auto end_cursor() -> CPP_ret(default_sentinel_t)( //
+            requires(!common_range<meta::at_c<meta::list<Views...>, 0>>))
+        {
+            return {};
+        }
+        CPP_member
+        auto end_cursor() const -> CPP_ret(cursor<true>)( //
+            requires cartesian_produce_view_can_const<Views...> &&
+                common_range<meta::at_c<meta::list<Views const...>, 0>>)
+        {
+            return cursor<true>{end_tag{}, this};
+        }
+        CPP_member
+        auto end_cursor() const -> CPP_ret(default_sentinel_t)( //
+            requires cartesian_produce_view_can_const<Views...> &&
+            (!common_range<meta::at_c<meta::list<Views const...>, 0>>))
+        {
+            return {};
+        }
+
+    public:
+        tiled_cartesian_product_view() = default;
+        constexpr tiled_cartesian_product_view(std::ptrdiff_t tile, Views... views)
+          : views_{detail::move(views)...}
+          , tile_(tile)
+        {
+            RANGES_EXPECT(0 < tile);
+        }
+        CPP_template(int = 42)(            //
+            requires(my_cardinality >= 0)) //
+            static constexpr std::size_t size() noexcept
+        {
+            return std::size_t{my_cardinality};
+        }
+        CPP_member
+        auto CPP_fun(size)()(const //
+                             requires(my_cardinality < 0) &&
+                             cartesian_produce_view_can_size<std::true_type, Views...>)
+        {
+            return tuple_foldl(views_, std::uintmax_t{1}, detail::cartesian_size_fn{});
+        }
+        CPP_member
+        auto CPP_fun(size)()(requires(my_cardinality < 0) &&
+                             cartesian_produce_view_can_size<std::false_type, Views...>)
+        {
+            return tuple_foldl(views_, std::uintmax_t{1}, detail::cartesian_size_fn{});
+        }
+    };
+
     namespace views
     {
         struct cartesian_product_fn
@@ -431,6 +664,22 @@ namespace ranges
         };
 
         RANGES_INLINE_VARIABLE(cartesian_product_fn, cartesian_product)
+
+        struct tiled_cartesian_product_fn
+        {
+            template<typename... Rngs>
+            constexpr auto operator()(std::ptrdiff_t tile, Rngs &&... rngs) const
+                -> CPP_ret(tiled_cartesian_product_view<all_t<Rngs>...>)( //
+                    requires(sizeof...(Rngs) != 0) &&
+                    concepts::and_v<(forward_range<Rngs> && viewable_range<Rngs>)...>)
+            {
+                return tiled_cartesian_product_view<all_t<Rngs>...>{
+                    tile, all(static_cast<Rngs &&>(rngs))...};
+            }
+        };
+
+        /// \relates tiled_cartesian_product_fn
+        RANGES_INLINE_VARIABLE(tiled_cartesian_product_fn, tiled_cartesian_product)
     } // namespace views
 } // namespace ranges
 
@@ -14,6 +14,7 @@
 #ifndef RANGES_V3_VIEW_CONCAT_HPP
 #define RANGES_V3_VIEW_CONCAT_HPP
 
+#include <initializer_list>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -263,6 +264,11 @@ namespace ranges
               : rng_(rng)
               , its_{emplaced_index<cranges - 1>, end(std::get<cranges - 1>(rng->rngs_))}
             {}
+            cursor(concat_view_t * rng, end_tag,
+                   iterator_t<constify_if<meta::back<meta::list<Rngs...>>>> last)
+              : rng_(rng)
+              , its_{emplaced_index<cranges - 1>, std::move(last)}
+            {}
             CPP_template(bool Other)(         //
                 requires IsConst && (!Other)) //
             cursor(cursor<Other> that)
@@ -325,6 +331,18 @@ namespace ranges
         {
             return {this, end_tag{}};
         }
+        // Segmented iteration: see detail/segmented_iteration.hpp
+        template<bool IsConst, typename Fun, std::size_t... Is>
+        static basic_iterator<cursor<IsConst>> for_each_segment_(
+            meta::const_if_c<IsConst, concat_view> & self, Fun & fun,
+            meta::index_sequence<Is...>)
+        {
+            (void)std::initializer_list<int>{
+                ((void)fun(std::get<Is>(self.rngs_)), 42)...};
+            return basic_iterator<cursor<IsConst>>{cursor<IsConst>{
+                &self, end_tag{}, fun(std::get<cranges - 1>(self.rngs_))}};
+        }
+
         CPP_member
         auto begin_cursor() const -> CPP_ret(cursor<true>)( //
             requires and_v<range<Rngs const>...>)
@@ -345,6 +363,22 @@ namespace ranges
         explicit concat_view(Rngs... rngs)
           : rngs_{std::move(rngs)...}
         {}
+        template<typename Fun>
+        basic_iterator<cursor<meta::and_c<simple_view<Rngs>()...>::value>>
+        for_each_segment(Fun & fun)
+        {
+            return concat_view::for_each_segment_<
+                meta::and_c<simple_view<Rngs>()...>::value>(
+                *this, fun, meta::make_index_sequence<cranges - 1>{});
+        }
+        template<typename Fun, bool Const = true>
+        auto for_each_segment(Fun & fun) const
+            -> CPP_ret(basic_iterator<cursor<Const>>)( //
+                requires Const && and_v<range<meta::const_if_c<Const, Rngs>>...>)
+        {
+            return concat_view::for_each_segment_<true>(
+                *this, fun, meta::make_index_sequence<cranges - 1>{});
+        }
         CPP_member
         constexpr auto size() const -> CPP_ret(std::size_t)( //
             requires(detail::concat_cardinality<Rngs...>::value >= 0))
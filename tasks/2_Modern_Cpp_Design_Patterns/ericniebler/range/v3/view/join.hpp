@@ -278,6 +278,18 @@ namespace ranges
         {
             return simple_view<Rng>() && std::is_reference<range_reference_t<Rng>>::value;
         }
+        // Segmented iteration: see detail/segmented_iteration.hpp
+        template<bool Const, typename Fun>
+        static basic_iterator<cursor<Const>> for_each_segment_(
+            meta::const_if_c<Const, join_view> & self, Fun & fun)
+        {
+            auto it = ranges::begin(self.outer_);
+            auto const last = ranges::end(self.outer_);
+            for(; it != last; ++it)
+                fun(self.update_inner_(*it));
+            return basic_iterator<cursor<Const>>{
+                cursor<Const>{&self, [&it](auto &&) { return std::move(it); }}};
+        }
         struct end_cursor_fn
         {
             constexpr auto operator()(join_view * this_, std::true_type) const
@@ -336,6 +348,21 @@ namespace ranges
                             common_range<CRng> && common_range<range_reference_t<CRng>>>;
             return cend_cursor_fn{}(this, cond{});
         }
+
+    public:
+        template<typename Fun>
+        basic_iterator<cursor<use_const_always()>> for_each_segment(Fun & fun)
+        {
+            return join_view::for_each_segment_<use_const_always()>(*this, fun);
+        }
+        template<typename Fun, bool Const = true>
+        auto for_each_segment(Fun & fun) const
+            -> CPP_ret(basic_iterator<cursor<Const>>)( //
+                requires Const && input_range<meta::const_if_c<Const, Rng>> &&
+                std::is_reference<range_reference_t<meta::const_if_c<Const, Rng>>>::value)
+        {
+            return join_view::for_each_segment_<true>(*this, fun);
+        }
     };
 
     // Join a range of ranges, inserting a range of values between them.
@@ -0,0 +1,132 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+
+#ifndef RANGES_V3_VIEW_MAPPED_LINES_HPP
+#define RANGES_V3_VIEW_MAPPED_LINES_HPP
+
+#include <cstring>
+#include <memory>
+#include <string>
+#ifdef __has_include
+#if __has_include(<string_view>)
+#include <string_view>
+#endif
+#endif
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/detail/mapped_file.hpp>
+#include <range/v3/iterator/default_sentinel.hpp>
+#include <range/v3/utility/static_const.hpp>
+#include <range/v3/view/facade.hpp>
+
+#if defined(__cpp_lib_string_view) && __cpp_lib_string_view > 0
+
+namespace ranges
+{
+    /// \addtogroup group-views
+    /// @{
+
+    /// The lines of a file as `std::string_view`s into the memory-mapped file, without
+    /// copying. Like \c getlines, the delimiters are not part of the lines and a final
+    /// delimiter does not start an empty line. The view is a forward range; copies
+    /// share the mapping, and the lines stay valid as long as any copy is alive.
+    struct mapped_lines_view : view_facade<mapped_lines_view, finite>
+    {
+    private:
+        friend range_access;
+        std::shared_ptr<detail::mapped_file const> file_;
+        char delim_ = '\n';
+
+        struct cursor
+        {
+        private:
+            char const * pos_ = nullptr;
+            char const * eol_ = nullptr;
+            char const * end_ = nullptr;
+            char delim_ = '\n';
+
+            void find_eol() noexcept
+            {
+                auto const p =
+                    std::memchr(pos_, delim_, static_cast<std::size_t>(end_ - pos_));
+                eol_ = p ? static_cast<char const *>(p) : end_;
+            }
+
+        public:
+            cursor() = default;
+            cursor(char const * begin, char const * end, char delim) noexcept
+              : pos_(begin)
+              , end_(end)
+              , delim_(delim)
+            {
+                if(pos_ != end_)
+                    find_eol();
+            }
+            std::string_view read() const noexcept
+            {
+                return {pos_, static_cast<std::size_t>(eol_ - pos_)};
+            }
+            void next() noexcept
+            {
+                pos_ = eol_ == end_ ? end_ : eol_ + 1;
+                if(pos_ != end_)
+                    find_eol();
+            }
+            bool equal(default_sentinel_t) const noexcept
+            {
+                return pos_ == end_;
+            }
+            bool equal(cursor const & that) const noexcept
+            {
+                return pos_ == that.pos_;
+            }
+        };
+        cursor begin_cursor() const noexcept
+        {
+            if(!file_)
+                return {};
+            return {file_->data(), file_->data() + file_->size(), delim_};
+        }
+
+    public:
+        mapped_lines_view() = default;
+        explicit mapped_lines_view(char const * path, char delim = '\n')
+          : file_(std::make_shared<detail::mapped_file>(path))
+          , delim_(delim)
+        {}
+        explicit mapped_lines_view(std::string const & path, char delim = '\n')
+          : mapped_lines_view(path.c_str(), delim)
+        {}
+    };
+
+    struct mapped_lines_fn
+    {
+        mapped_lines_view operator()(char const * path, char delim = '\n') const
+        {
+            return mapped_lines_view{path, delim};
+        }
+        mapped_lines_view operator()(std::string const & path, char delim = '\n') const
+        {
+            return mapped_lines_view{path, delim};
+        }
+    };
+
+    /// \relates mapped_lines_fn
+    RANGES_INLINE_VARIABLE(mapped_lines_fn, mapped_lines)
+    /// @}
+} // namespace ranges
+
+#endif // __cpp_lib_string_view
+
+#endif
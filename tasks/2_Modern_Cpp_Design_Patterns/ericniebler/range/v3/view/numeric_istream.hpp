@@ -0,0 +1,328 @@
+/// \file
+// Range v3 library
+//
+//  Copyright Eric Niebler 2013-present
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/ericniebler/range-v3
+//
+
+#ifndef RANGES_V3_VIEW_NUMERIC_ISTREAM_HPP
+#define RANGES_V3_VIEW_NUMERIC_ISTREAM_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#ifdef __has_include
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#include <range/v3/range_fwd.hpp>
+
+#include <range/v3/detail/mapped_file.hpp>
+#include <range/v3/iterator/default_sentinel.hpp>
+#include <range/v3/utility/static_const.hpp>
+#include <range/v3/view/facade.hpp>
+
+#if RANGES_CXX_VER >= RANGES_CXX_STD_17 && defined(__cpp_lib_to_chars)
+#define RANGES_FLOAT_FROM_CHARS 1
+#else
+#define RANGES_FLOAT_FROM_CHARS 0
+#endif
+
+#if RANGES_CXX_VER >= RANGES_CXX_STD_17 && defined(__has_include)
+#if __has_include(<charconv>)
+
+namespace ranges
+{
+    /// \cond
+    namespace detail
+    {
+        constexpr std::size_t numeric_istream_chunk_size()
+        {
+            return std::size_t(1) << 16;
+        }
+
+        constexpr bool numeric_space(char c) noexcept
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        // The characters of a numeric_istream_view: either the whole memory-mapped
+        // file or a window into a stream that is refilled in large chunks with a
+        // single unformatted read each.
+        struct numeric_source
+        {
+            explicit numeric_source(std::istream & sin)
+              : sin_(&sin)
+              , buffer_(new char[numeric_istream_chunk_size()])
+              , size_(numeric_istream_chunk_size())
+              , pos_(buffer_.get())
+              , end_(buffer_.get())
+            {}
+            explicit numeric_source(char const * path)
+              : file_(new mapped_file(path))
+              , pos_(file_->data())
+              , end_(file_->data() + file_->size())
+              , eof_(true)
+            {}
+
+            // Skips whitespace. Returns false at the end of the input.
+            bool skip_space()
+            {
+                for(;;)
+                {
+                    while(pos_ != end_ && numeric_space(*pos_))
+                        ++pos_;
+                    if(pos_ != end_)
+                        return true;
+                    if(eof_)
+                        return false;
+                    refill();
+                }
+            }
+            char const * begin() const noexcept
+            {
+                return pos_;
+            }
+            char const * end() const noexcept
+            {
+                return end_;
+            }
+            // Whether the token starting at begin(), which extends at least up to pos,
+            // lies within the window, i.e., whether a value parsed from the window
+            // would not be cut off. Usually pos is already the end of the token.
+            bool complete(char const * pos) const noexcept
+            {
+                while(pos != end_ && !numeric_space(*pos))
+                    ++pos;
+                return pos != end_ || eof_;
+            }
+            void consume(char const * pos) noexcept
+            {
+                pos_ = pos;
+            }
+            // Marks the stream as failed, as a failed operator>> would.
+            void fail()
+            {
+                if(sin_)
+                    sin_->setstate(std::ios_base::failbit);
+            }
+            // Moves the rest of the window to the front of the buffer and appends the
+            // next chunk of the stream. A token that fills the whole buffer doubles its
+            // size, so that every read asks for at least one character and only the end
+            // of the stream returns none.
+            void refill()
+            {
+                auto const rest = static_cast<std::size_t>(end_ - pos_);
+                if(rest == size_)
+                {
+                    std::unique_ptr<char[]> larger{new char[2 * size_]};
+                    std::memcpy(larger.get(), pos_, rest);
+                    buffer_ = std::move(larger);
+                    size_ *= 2;
+                }
+                else
+                    std::memmove(buffer_.get(), pos_, rest);
+                char * const buffer = buffer_.get();
+                auto const n = sin_->rdbuf()->sgetn(
+                    buffer + rest, static_cast<std::streamsize>(size_ - rest));
+                pos_ = buffer;
+                end_ = buffer + rest + (n > 0 ? static_cast<std::size_t>(n) : 0);
+                if(n <= 0)
+                {
+                    eof_ = true;
+                    sin_->setstate(std::ios_base::eofbit);
+                }
+            }
+
+        private:
+            std::istream * sin_ = nullptr;
+            std::unique_ptr<mapped_file const> file_;
+            std::unique_ptr<char[]> buffer_;
+            std::size_t size_ = 0;
+            char const * pos_ = nullptr;
+            char const * end_ = nullptr;
+            bool eof_ = false;
+        };
+
+        template<typename Val>
+        std::from_chars_result numeric_parse(char const * first, char const * last,
+                                             Val & val, std::true_type)
+        {
+            return std::from_chars(first, last, val);
+        }
+        template<typename Val>
+        std::from_chars_result numeric_parse(char const * first, char const * last,
+                                             Val & val, std::false_type)
+        {
+#if RANGES_FLOAT_FROM_CHARS
+            return std::from_chars(first, last, val);
+#else
+            // No floating-point from_chars: fall back to strtod on a terminated copy.
+            char buf[128];
+            auto const n = static_cast<std::size_t>(last - first) < sizeof(buf) - 1
+                               ? static_cast<std::size_t>(last - first)
+                               : sizeof(buf) - 1;
+            std::memcpy(buf, first, n);
+            buf[n] = '\0';
+            char * end = buf;
+            long double const v = std::strtold(buf, &end);
+            if(end == buf)
+                return {first, std::errc::invalid_argument};
+            val = static_cast<Val>(v);
+            return {first + (end - buf), std::errc{}};
+#endif
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// \addtogroup group-views
+    /// @{
+
+    /// A drop-in replacement of \c istream_view for arithmetic types. Instead of one
+    /// locale-aware <tt>operator>></tt> per value, the characters are read in large
+    /// chunks (or memory-mapped from a file) and parsed with \c std::from_chars. Values
+    /// are separated by whitespace and the view ends at the end of the input or at the
+    /// first character that does not start a number, in which case the failbit of the
+    /// stream is set. Since whole chunks are read ahead, the position of the stream
+    /// afterwards is unspecified. Copies share the underlying input.
+    template<typename Val>
+    struct numeric_istream_view : view_facade<numeric_istream_view<Val>, unknown>
+    {
+        static_assert(std::is_arithmetic<Val>::value && !std::is_same<Val, bool>::value,
+                      "numeric_istream_view requires an integer or floating-point type");
+
+    private:
+        friend range_access;
+        std::shared_ptr<detail::numeric_source> src_;
+        Val obj_{};
+        struct cursor
+        {
+        private:
+            friend range_access;
+            using single_pass = std::true_type;
+            numeric_istream_view * rng_ = nullptr;
+
+        public:
+            cursor() = default;
+            explicit cursor(numeric_istream_view * rng)
+              : rng_(rng)
+            {}
+            void next()
+            {
+                rng_->next();
+            }
+            Val & read() const noexcept
+            {
+                return rng_->cached();
+            }
+            bool equal(default_sentinel_t) const
+            {
+                return !rng_->src_;
+            }
+            bool equal(cursor that) const
+            {
+                return !rng_->src_ == !that.rng_->src_;
+            }
+        };
+        void next()
+        {
+            for(;;)
+            {
+                if(!src_->skip_space())
+                {
+                    src_.reset();
+                    return;
+                }
+                char const * first = src_->begin();
+                char const * const last = src_->end();
+                if(*first == '+' && last - first > 1 && first[1] != '-')
+                    ++first;
+                auto const res =
+                    detail::numeric_parse(first, last, obj_, std::is_integral<Val>{});
+                if(!src_->complete(res.ptr))
+                {
+                    src_->refill();
+                    continue;
+                }
+                if(res.ec != std::errc{})
+                {
+                    src_->fail();
+                    src_.reset();
+                    return;
+                }
+                src_->consume(res.ptr);
+                return;
+            }
+        }
+        cursor begin_cursor()
+        {
+            return cursor{this};
+        }
+
+    public:
+        numeric_istream_view() = default;
+        explicit numeric_istream_view(std::istream & sin)
+          : src_(std::make_shared<detail::numeric_source>(sin))
+        {
+            next(); // prime the pump
+        }
+        /// Reads the numbers from the file at \p path, which is memory-mapped if
+        /// possible. Throws \c std::system_error if the file cannot be opened.
+        explicit numeric_istream_view(char const * path)
+          : src_(std::make_shared<detail::numeric_source>(path))
+        {
+            next();
+        }
+        explicit numeric_istream_view(std::string const & path)
+          : numeric_istream_view(path.c_str())
+        {}
+        Val & cached() noexcept
+        {
+            return obj_;
+        }
+    };
+
+    /// \cond
+    namespace _numeric_istream_
+    {
+        /// \endcond
+        template<typename Val>
+        inline numeric_istream_view<Val> numeric_istream(std::istream & sin)
+        {
+            return numeric_istream_view<Val>{sin};
+        }
+        template<typename Val>
+        inline numeric_istream_view<Val> numeric_istream(char const * path)
+        {
+            return numeric_istream_view<Val>{path};
+        }
+        template<typename Val>
+        inline numeric_istream_view<Val> numeric_istream(std::string const & path)
+        {
+            return numeric_istream_view<Val>{path};
+        }
+        /// \cond
+    } // namespace _numeric_istream_
+    using namespace _numeric_istream_;
+    /// \endcond
+
+    /// @}
+} // namespace ranges
+
+#endif // __has_include(<charconv>)
+#endif // RANGES_CXX_STD_17
+
+#endif
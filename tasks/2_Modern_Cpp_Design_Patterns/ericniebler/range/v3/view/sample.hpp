@@ -23,6 +23,7 @@
 #include <range/v3/iterator/default_sentinel.hpp>
 #include <range/v3/iterator/operations.hpp>
 #include <range/v3/range/concepts.hpp>
+#include <range/v3/utility/random.hpp>
 #include <range/v3/utility/static_const.hpp>
 #include <range/v3/view/all.hpp>
 #include <range/v3/view/facade.hpp>
@@ -105,8 +106,6 @@ namespace ranges
             {
                 if(parent_->size_ > 0)
                 {
-                    using Dist = std::uniform_int_distribution<D>;
-                    Dist dist{};
                     URNG & engine = *parent_->engine_;
 
                     for(;; ++current_, size_.decrement())
@@ -114,8 +113,7 @@ namespace ranges
                         RANGES_ASSERT(current_ != ranges::end(parent_->rng_));
                         auto n = pop_size();
                         RANGES_EXPECT(n > 0);
-                        typename Dist::param_type const interval{0, n - 1};
-                        if(dist(engine, interval) < parent_->size_)
+                        if(detail::bounded_rand(engine, n) < parent_->size_)
                             break;
                     }
                 }
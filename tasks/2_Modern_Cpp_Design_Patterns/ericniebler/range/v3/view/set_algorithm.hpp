@@ -24,6 +24,7 @@
 
 #include <range/v3/range_fwd.hpp>
 
+#include <range/v3/detail/set_intersection.hpp>
 #include <range/v3/functional/comparisons.hpp>
 #include <range/v3/functional/identity.hpp>
 #include <range/v3/functional/invoke.hpp>
@@ -272,6 +273,11 @@ namespace ranges
             sentinel_t<R2> end2_;
 
             void satisfy()
+            {
+                satisfy_(set_intersection_sized_<iterator_t<R1>, sentinel_t<R1>,
+                                                 iterator_t<R2>, sentinel_t<R2>>{});
+            }
+            void satisfy_(std::false_type)
             {
                 while(it1_ != end1_ && it2_ != end2_)
                 {
@@ -285,6 +291,41 @@ namespace ranges
                     }
                 }
             }
+            // If one input is much longer than the other, look up the elements of the
+            // shorter one by galloping (see detail/set_intersection.hpp).
+            void satisfy_(std::true_type)
+            {
+                auto n1 = end1_ - it1_;
+                auto n2 = end2_ - it2_;
+                if(n1 / set_intersection_gallop_ratio() >= n2)
+                {
+                    for(; it2_ != end2_; ++it2_)
+                    {
+                        auto && val = invoke(proj2_, *it2_);
+                        auto const pos =
+                            detail::gallop_lower_bound_n(it1_, n1, val, pred_, proj1_);
+                        n1 -= pos - it1_;
+                        it1_ = pos;
+                        if(n1 == 0 || !invoke(pred_, val, invoke(proj1_, *it1_)))
+                            return;
+                    }
+                }
+                else if(n2 / set_intersection_gallop_ratio() >= n1)
+                {
+                    for(; it1_ != end1_; ++it1_)
+                    {
+                        auto && val = invoke(proj1_, *it1_);
+                        auto const pos =
+                            detail::gallop_lower_bound_n(it2_, n2, val, pred_, proj2_);
+                        n2 -= pos - it2_;
+                        it2_ = pos;
+                        if(n2 == 0 || !invoke(pred_, val, invoke(proj2_, *it2_)))
+                            return;
+                    }
+                }
+                else
+                    satisfy_(std::false_type{});
+            }
 
         public:
             using value_type = range_value_t<R1>;
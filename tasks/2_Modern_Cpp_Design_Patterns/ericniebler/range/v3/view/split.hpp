@@ -14,6 +14,8 @@
 #ifndef RANGES_V3_VIEW_SPLIT_HPP
 #define RANGES_V3_VIEW_SPLIT_HPP
 
+#include <cstddef>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
@@ -26,6 +28,7 @@
 #include <range/v3/iterator/default_sentinel.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/range/concepts.hpp>
+#include <range/v3/range/primitives.hpp>
 #include <range/v3/range/traits.hpp>
 #include <range/v3/utility/static_const.hpp>
 #include <range/v3/view/all.hpp>
@@ -106,6 +109,52 @@ namespace ranges
         template<typename It>
         using split_view_base = meta::invoke<here_or_there_<!forward_iterator<It>>, It>;
 
+        // Splitting a contiguous range of bytes at a contiguous pattern searches the
+        // next delimiter with memchr and memcmp, once per subrange.
+        template<typename Base, typename Pattern>
+        using split_memchr = meta::bool_<
+            (bool)contiguous_range<Base> && (bool)common_range<Base> &&
+            (bool)contiguous_range<Pattern> &&
+            (bool)same_as<range_value_t<Base>, range_value_t<Pattern>> &&
+            std::is_integral<range_value_t<Base>>::value &&
+            sizeof(range_value_t<Base>) == 1 &&
+            !std::is_same<range_value_t<Base>, bool>::value>;
+
+        // The first match of [pattern, pattern + m) in [first, last), or last. An empty
+        // pattern matches after every element, i.e., it splits into single elements.
+        template<typename T>
+        T const * split_find(T const * first, T const * last, T const * pattern,
+                             std::size_t m)
+        {
+            if(m == 0)
+                return first == last ? last : first + 1;
+            if(static_cast<std::size_t>(last - first) < m)
+                return last;
+            T const * const stop = last - (m - 1);
+            for(; first != stop; ++first)
+            {
+                auto const p = std::memchr(first,
+                                           static_cast<unsigned char>(*pattern),
+                                           static_cast<std::size_t>(stop - first));
+                if(!p)
+                    break;
+                first = static_cast<T const *>(p);
+                if(m == 1 || std::memcmp(first + 1, pattern + 1, m - 1) == 0)
+                    return first;
+            }
+            return last;
+        }
+
+        // The position of the delimiter that ends the current subrange, if cached.
+        template<typename It, bool>
+        struct split_delim
+        {
+            It delim_ = It();
+        };
+        template<typename It>
+        struct split_delim<It, false>
+        {};
+
         template<typename JoinView, bool Const>
         struct split_outer_iterator;
 
@@ -131,6 +180,14 @@ namespace ranges
                 return i_.current_();
             }
             constexpr bool done_() const
+            {
+                return done_(typename Outer::memchr_t{});
+            }
+            constexpr bool done_(std::true_type) const
+            {
+                return current_() == i_.delim_;
+            }
+            constexpr bool done_(std::false_type) const
             {
                 auto cur = current_();
                 auto last = ranges::end(i_.parent_->base_);
@@ -298,14 +355,18 @@ namespace ranges
         struct split_outer_iterator;
 
         template<typename V, typename Pattern, bool Const>
-        struct split_outer_iterator<split_view<V, Pattern>, Const>
+        struct RANGES_EMPTY_BASES split_outer_iterator<split_view<V, Pattern>, Const>
           : split_outer_iterator_base<iterator_t<meta::const_if_c<Const, V>>>
+          , split_delim<iterator_t<meta::const_if_c<Const, V>>,
+                        split_memchr<meta::const_if_c<Const, V>,
+                                     meta::const_if_c<Const, Pattern>>::value>
         {
         private:
             friend struct split_inner_iterator<split_view<V, Pattern>, Const>;
             using Parent = meta::const_if_c<Const, split_view<V, Pattern>>;
             using Base = meta::const_if_c<Const, V>;
             using Current = split_outer_iterator_base<iterator_t<Base>>;
+            using memchr_t = split_memchr<Base, meta::const_if_c<Const, Pattern>>;
 
             Parent * parent_ = nullptr;
             constexpr decltype(auto) current_() noexcept
@@ -320,6 +381,47 @@ namespace ranges
             {
                 return (parent_->base_);
             }
+            constexpr void find_delim_(std::false_type) noexcept
+            {}
+            constexpr void find_delim_(std::true_type)
+            {
+                auto const first = ranges::begin(base_());
+                auto const data = ranges::data(base_());
+                auto const pos = detail::split_find(
+                    data + (this->curr_ - first),
+                    data + (ranges::end(base_()) - first),
+                    ranges::data(parent_->pattern_),
+                    static_cast<std::size_t>(ranges::distance(parent_->pattern_)));
+                this->delim_ = first + (pos - data);
+            }
+            constexpr void next_(std::true_type)
+            {
+                auto const last = ranges::end(base_());
+                this->curr_ =
+                    this->delim_ == last
+                        ? last
+                        : this->delim_ + ranges::distance(parent_->pattern_);
+                find_delim_(std::true_type{});
+            }
+            constexpr void next_(std::false_type)
+            {
+                auto & current = current_();
+                const auto last = ranges::end(base_());
+                auto const pbegin = ranges::begin(parent_->pattern_);
+                auto const pend = ranges::end(parent_->pattern_);
+                if(pbegin == pend)
+                    ++current;
+                else
+                    do
+                    {
+                        const auto ret = ranges::mismatch(current, last, pbegin, pend);
+                        if(ret.in2 == pend)
+                        {
+                            current = ret.in1; // The pattern matched; skip it
+                            break;
+                        }
+                    } while(++current != last);
+            }
 #if RANGES_CXX_IF_CONSTEXPR < RANGES_CXX_IF_CONSTEXPR_17
             constexpr split_outer_iterator post_inc(std::true_type) // Forward
             {
@@ -376,7 +478,9 @@ namespace ranges
                 requires forward_range<Base>)
               : Current{std::move(current)}
               , parent_(&parent)
-            {}
+            {
+                find_delim_(memchr_t{});
+            }
 
             CPP_template(bool Other)( //
                 requires Const && (!Other) &&
@@ -385,7 +489,9 @@ namespace ranges
                     split_outer_iterator<split_view<V, Pattern>, Other> i)
               : Current{std::move(i.curr_)}
               , parent_(i.parent_)
-            {}
+            {
+                find_delim_(memchr_t{});
+            }
 
             constexpr value_type operator*() const
             {
@@ -394,24 +500,8 @@ namespace ranges
 
             constexpr split_outer_iterator & operator++()
             {
-                auto & current = current_();
-                const auto last = ranges::end(base_());
-                if(current == last)
-                    return *this;
-                auto const pbegin = ranges::begin(parent_->pattern_);
-                auto const pend = ranges::end(parent_->pattern_);
-                if(pbegin == pend)
-                    ++current;
-                else
-                    do
-                    {
-                        const auto ret = ranges::mismatch(current, last, pbegin, pend);
-                        if(ret.in2 == pend)
-                        {
-                            current = ret.in1; // The pattern matched; skip it
-                            break;
-                        }
-                    } while(++current != last);
+                if(current_() != ranges::end(base_()))
+                    next_(memchr_t{});
                 return *this;
             }
 
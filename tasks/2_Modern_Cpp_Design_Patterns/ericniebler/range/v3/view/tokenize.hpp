@@ -25,8 +25,10 @@
 #include <range/v3/functional/bind_back.hpp>
 #include <range/v3/range/access.hpp>
 #include <range/v3/range/concepts.hpp>
+#include <range/v3/utility/dfa_regex.hpp>
 #include <range/v3/utility/static_const.hpp>
 #include <range/v3/view/all.hpp>
+#include <range/v3/view/facade.hpp>
 #include <range/v3/view/interface.hpp>
 #include <range/v3/view/view.hpp>
 
@@ -88,6 +90,229 @@ namespace ranges
         }
     };
 
+    /// \cond
+    namespace detail
+    {
+        inline std::size_t tokenize_subs_size(int)
+        {
+            return 1;
+        }
+        inline int tokenize_sub(int sub, std::size_t)
+        {
+            return sub;
+        }
+        template<typename SubMatchRange>
+        std::size_t tokenize_subs_size(SubMatchRange const & subs)
+        {
+            return subs.size();
+        }
+        template<typename SubMatchRange>
+        int tokenize_sub(SubMatchRange const & subs, std::size_t n)
+        {
+            return subs.begin()[n];
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// The tokenize_view for a dfa_regex. It yields the same sub_matches as
+    /// std::regex_token_iterator, but finds the matches with the allocation-free DFA.
+    /// \pre Every sub-match index is 0 (the match) or -1 (the text between matches).
+    /// \pre The match flags are std::regex_constants::match_default; the DFA implements
+    /// none of the others.
+    template<typename Rng, typename SubMatchRange>
+    struct dfa_tokenize_view
+      : view_facade<dfa_tokenize_view<Rng, SubMatchRange>,
+                    is_finite<Rng>::value ? finite : range_cardinality<Rng>::value>
+    {
+    private:
+        friend range_access;
+        CPP_assert(forward_range<Rng> && view_<Rng> && common_range<Rng>);
+        CPP_assert(semiregular<SubMatchRange>);
+
+        Rng rng_;
+        dfa_regex rex_;
+        SubMatchRange subs_;
+
+        template<bool IsConst>
+        struct cursor
+        {
+        private:
+            friend struct cursor<!IsConst>;
+            using parent_t = meta::const_if_c<IsConst, dfa_tokenize_view>;
+            using iterator = iterator_t<meta::const_if_c<IsConst, Rng>>;
+
+            parent_t * rng_ = nullptr;
+            iterator prev_{}; // the end of the previous match
+            iterator first_{};
+            iterator last_{};
+            iterator end_{};
+            std::size_t n_ = 0;
+            bool suffix_ = false;
+            bool done_ = true;
+            std::sub_match<iterator> result_{};
+
+            int sub() const
+            {
+                return detail::tokenize_sub(rng_->subs_, n_);
+            }
+            bool wants_suffix() const
+            {
+                for(std::size_t n = 0; n != detail::tokenize_subs_size(rng_->subs_); ++n)
+                    if(detail::tokenize_sub(rng_->subs_, n) == -1)
+                        return true;
+                return false;
+            }
+            void set_result(iterator first, iterator last, bool matched)
+            {
+                result_.first = first;
+                result_.second = last;
+                result_.matched = matched;
+            }
+            void set_sub()
+            {
+                RANGES_EXPECT(sub() == 0 || sub() == -1);
+                if(sub() == -1)
+                    set_result(prev_, first_, prev_ != first_);
+                else
+                    set_result(first_, last_, true);
+            }
+
+        public:
+            cursor() = default;
+            cursor(parent_t * rng, bool done)
+              : rng_(rng)
+              , prev_(ranges::begin(rng->rng_))
+              , end_(ranges::end(rng->rng_))
+              , done_(done)
+            {
+                if(done_)
+                    return;
+                if(rng_->rex_.search(prev_, end_, first_, last_))
+                    set_sub();
+                else if(wants_suffix())
+                {
+                    suffix_ = true;
+                    set_result(prev_, end_, true);
+                }
+                else
+                    done_ = true;
+            }
+            CPP_template(bool Other)( //
+                requires IsConst && (!Other)) cursor(cursor<Other> that)
+              : rng_(that.rng_)
+              , prev_(std::move(that.prev_))
+              , first_(std::move(that.first_))
+              , last_(std::move(that.last_))
+              , end_(std::move(that.end_))
+              , n_(that.n_)
+              , suffix_(that.suffix_)
+              , done_(that.done_)
+              , result_()
+            {
+                set_result(that.result_.first, that.result_.second, that.result_.matched);
+            }
+            std::sub_match<iterator> const & read() const
+            {
+                return result_;
+            }
+            void next()
+            {
+                RANGES_EXPECT(!done_);
+                if(suffix_)
+                {
+                    done_ = true;
+                    return;
+                }
+                if(++n_ != detail::tokenize_subs_size(rng_->subs_))
+                {
+                    set_sub();
+                    return;
+                }
+                n_ = 0;
+                prev_ = last_;
+                // After an empty match the next one is looked for one character later.
+                bool found = false;
+                if(first_ != last_)
+                    found = rng_->rex_.search(last_, end_, first_, last_);
+                else if(last_ != end_)
+                    found = rng_->rex_.search(ranges::next(last_), end_, first_, last_);
+                if(found)
+                    set_sub();
+                else if(prev_ != end_ && wants_suffix())
+                {
+                    suffix_ = true;
+                    set_result(prev_, end_, true);
+                }
+                else
+                    done_ = true;
+            }
+            bool equal(cursor const & that) const
+            {
+                return done_ == that.done_ &&
+                       (done_ || (suffix_ == that.suffix_ && first_ == that.first_ &&
+                                  last_ == that.last_ && n_ == that.n_));
+            }
+        };
+
+        CPP_member
+        auto begin_cursor() -> CPP_ret(cursor<false>)( //
+            requires(!simple_view<Rng>() || !common_range<Rng const>))
+        {
+            return {this, false};
+        }
+        CPP_member
+        auto end_cursor() -> CPP_ret(cursor<false>)( //
+            requires(!simple_view<Rng>() || !common_range<Rng const>))
+        {
+            return {this, true};
+        }
+        CPP_member
+        auto begin_cursor() const -> CPP_ret(cursor<true>)( //
+            requires common_range<Rng const>)
+        {
+            return {this, false};
+        }
+        CPP_member
+        auto end_cursor() const -> CPP_ret(cursor<true>)( //
+            requires common_range<Rng const>)
+        {
+            return {this, true};
+        }
+
+    public:
+        dfa_tokenize_view() = default;
+        dfa_tokenize_view(Rng rng, dfa_regex rex, SubMatchRange subs,
+                          std::regex_constants::match_flag_type flags)
+          : rng_(std::move(rng))
+          , rex_(std::move(rex))
+          , subs_(std::move(subs))
+        {
+            RANGES_EXPECT(flags == std::regex_constants::match_default);
+        }
+        Rng base() const
+        {
+            return rng_;
+        }
+    };
+
+    /// \cond
+    namespace detail
+    {
+        // A dfa_tokenize_view keeps the sub-match indices in a vector rather than in
+        // an initializer_list, which would not outlive a pipeline.
+        template<typename SubMatchRange>
+        using dfa_tokenize_subs_t =
+            meta::if_<std::is_same<SubMatchRange, std::initializer_list<int>>,
+                      std::vector<int>, SubMatchRange>;
+
+        template<typename Rng, typename Regex, typename SubMatchRange>
+        using tokenize_view_t = meta::if_<
+            std::is_same<decay_t<Regex>, dfa_regex>,
+            dfa_tokenize_view<views::all_t<Rng>, dfa_tokenize_subs_t<SubMatchRange>>,
+            tokenize_view<views::all_t<Rng>, decay_t<Regex>, SubMatchRange>>;
+    } // namespace detail
+    /// \endcond
+
 #if RANGES_CXX_DEDUCTION_GUIDES >= RANGES_CXX_DEDUCTION_GUIDES_17
     CPP_template(typename Rng, typename Regex, typename SubMatchRange)(
         requires copy_constructible<Regex> && copy_constructible<SubMatchRange>)
@@ -100,7 +325,7 @@ namespace ranges
         struct tokenizer_impl_fn
         {
             template<typename Rng, typename Regex>
-            tokenize_view<all_t<Rng>, detail::decay_t<Regex>, int> operator()(
+            detail::tokenize_view_t<Rng, Regex, int> operator()(
                 Rng && rng, Regex && rex, int sub = 0,
                 std::regex_constants::match_flag_type flags =
                     std::regex_constants::match_default) const
@@ -118,7 +343,7 @@ namespace ranges
             }
 
             template<typename Rng, typename Regex>
-            tokenize_view<all_t<Rng>, detail::decay_t<Regex>, std::vector<int>>
+            detail::tokenize_view_t<Rng, Regex, std::vector<int>>
             operator()(Rng && rng, Regex && rex, std::vector<int> subs,
                        std::regex_constants::match_flag_type flags =
                            std::regex_constants::match_default) const
@@ -136,7 +361,7 @@ namespace ranges
             }
 
             template<typename Rng, typename Regex>
-            tokenize_view<all_t<Rng>, detail::decay_t<Regex>, std::initializer_list<int>>
+            detail::tokenize_view_t<Rng, Regex, std::initializer_list<int>>
             operator()(Rng && rng, Regex && rex, std::initializer_list<int> subs,
                        std::regex_constants::match_flag_type flags =
                            std::regex_constants::match_default) const